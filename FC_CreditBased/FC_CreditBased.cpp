@@ -43,15 +43,22 @@ void IFC_CreditBased::p_VALID() {
 }
 
 void IFC_CreditBased::p_ALERT_PACKET_RECEIVE() {
-    while(1) {
-        // Always that there is a VALID signal asserted, a packet is being received.
-        if( i_VALID.read() ) {
-            e_PACKET_RECEIVED.notify();
-        }
-        wait();
+    // Always that there is a VALID signal asserted, a flit is being received
+    // (the credits assure room in the FIFO).
+    if( i_VALID.read() ) {
+        e_PACKET_RECEIVED.notify();
     }
 }
 
+void IFC_CreditBased::enablePacketMonitoring() {
+    sc_spawn_options options;
+    options.spawn_method();
+    options.dont_initialize();
+    options.set_sensitivity(&i_CLK.pos());
+    sc_spawn(sc_bind(&IFC_CreditBased::p_ALERT_PACKET_RECEIVE,this),
+             sc_gen_unique_name("p_ALERT_PACKET_RECEIVE"),&options);
+}
+
 void IFC_CreditBased::p_DEBUG() {
 
     if( ROUTER_ID == 0 && PORT_ID == 2) {
@@ -105,6 +112,10 @@ void OFC_CreditBased::p_COUNTER() {
     if(i_RST.read() == 1) {
         r_COUNTER.write(numCredits);
     } else {
+        if( linkCounters != NULL ) { // A flit moves on each cycle with VALID asserted
+            bool sending = o_VALID.read();
+            linkCounters->count(sending,sending,i_READ_OK.read() && !sending);
+        }
         if( i_READ_OK.read() == 0 ) {
             if( (i_RETURN.read()) && (r_COUNTER.read() != (numCredits)) ) {
                 r_COUNTER.write( r_COUNTER.read() + 1 );
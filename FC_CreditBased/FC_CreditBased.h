@@ -40,6 +40,7 @@ public:
 
     // Packet monitoring - only to traffic meter use
     void p_ALERT_PACKET_RECEIVE();
+    void enablePacketMonitoring();
 
     unsigned short numberOfCyclesPerFlit() const { return 1; } // Credit-based forward a flit in a single cycle
 
@@ -12,7 +12,8 @@ IFC_Handshake::IFC_Handshake(sc_module_name mn,
                              unsigned short PORT_ID)
     : IInputFlowControl(mn,ROUTER_ID,PORT_ID),
       r_CUR_STATE("IFC_Handshake_rCUR_STATE"),
-      w_NEXT_STATE("IFC_Handshake_wNEXT_STATE")
+      w_NEXT_STATE("IFC_Handshake_wNEXT_STATE"),
+      r_ALERT_STATE(0)
 {
     SC_METHOD(p_CURRENT_STATE);
     sensitive << i_CLK.pos() << i_RST;
@@ -107,20 +108,35 @@ void IFC_Handshake::p_OUTPUTS() {
 }
 
 void IFC_Handshake::p_ALERT_PACKET_RECEIVE() {
-    while(1) {
-        while( i_VALID.read() == 0 ) wait();
-
-        while( i_READ.read() == 0) wait();
-
-        // When a VALID and RETURN (READ) are asserted, a packet is being received
-        e_PACKET_RECEIVED.notify();
-
-        while( i_VALID.read() == 1 ) wait();
-
-        while( i_READ.read() == 1 ) wait();
+    switch( r_ALERT_STATE ) {
+        case 0: // Waiting VALID and RETURN (READ)
+            if( i_VALID.read() && i_READ.read() ) {
+                // When a VALID and RETURN (READ) are asserted, a flit is being received
+                e_PACKET_RECEIVED.notify();
+                r_ALERT_STATE = 1;
+            }
+            break;
+        case 1: // Waiting VALID be released
+            if( !i_VALID.read() ) {
+                r_ALERT_STATE = i_READ.read() ? 2 : 0;
+            }
+            break;
+        default: // Waiting RETURN (READ) be released
+            if( !i_READ.read() ) {
+                r_ALERT_STATE = 0;
+            }
     }
 }
 
+void IFC_Handshake::enablePacketMonitoring() {
+    sc_spawn_options options;
+    options.spawn_method();
+    options.dont_initialize();
+    options.set_sensitivity(&i_CLK.pos());
+    sc_spawn(sc_bind(&IFC_Handshake::p_ALERT_PACKET_RECEIVE,this),
+             sc_gen_unique_name("p_ALERT_PACKET_RECEIVE"),&options);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -152,6 +168,11 @@ void OFC_Handshake::p_CURRENT_STATE() {
     if( i_RST.read() == 1 ) {
         r_CUR_STATE.write(s_S0);
     } else {
+        if( linkCounters != NULL ) { // A flit is delivered on S2 (read from the FIFO)
+            // Stall: a flit ready on S0 but the receiver has not finished the previous handshake
+            handshake_states state = r_CUR_STATE.read();
+            linkCounters->count(state == s_S2,state != s_S0,state == s_S0 && i_READ_OK.read() && i_RETURN.read());
+        }
         r_CUR_STATE.write(w_NEXT_STATE.read());
     }
 }
@@ -43,7 +43,9 @@ public:
     void p_OUTPUTS();
 
     // Packet monitoring - only to traffic meter use
+    unsigned short r_ALERT_STATE; // Handshake phase seen by the monitoring
     void p_ALERT_PACKET_RECEIVE();
+    void enablePacketMonitoring();
 
     unsigned short numberOfCyclesPerFlit() const { return 4; } // Handshake forward a flit in the link in 4 cycles
 
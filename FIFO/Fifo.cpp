@@ -117,10 +117,59 @@ void FIFO::p_CURRENT_STATE() {
     if( i_RST.read() == 1 ) {
         r_CUR_STATE.write(0);
     } else {
+        if( bufferCounters != NULL ) { // Level stored during the cycle that is ending
+            bufferCounters->sample( r_CUR_STATE.read() );
+        }
+        if( packetTracing ) {
+            this->tracePackets();
+        }
+        if( activityCounters != NULL ) {
+            if( i_WRITE.read() == 1 && r_CUR_STATE.read() != memSize ) {
+                activityCounters->bufferWrites++;
+            }
+            if( i_READ.read() == 1 && r_CUR_STATE.read() != 0 ) {
+                activityCounters->bufferReads++;
+            }
+        }
         r_CUR_STATE.write( w_NEXT_STATE.read() );
     }
 }
 
+/*!
+ * \brief FIFO::tracePackets It reports the header written (arrived at the
+ * router port) and the header and trailer read (granted and left) on this
+ * clock edge to the latency breakdown and, when they belong to a traced
+ * packet, to the packet tracer
+ */
+void FIFO::tracePackets() {
+    if( (i_WRITE.read() == 1) && (r_CUR_STATE.read() != memSize) ) {
+        const Flit& flit = i_DATA.read();
+        if( flit.packet_ptr != NULL && flit.data[FLIT_WIDTH-2] == 1 ) {
+            if( flit.packet_ptr->traced ) {
+                PACKET_TRACER->headerArrived(flit.packet_ptr->packetId,ROUTER_ID,PORT_ID);
+            }
+            LATENCY_BREAKDOWN->headerArrived(flit.packet_ptr->packetId,ROUTER_ID,PORT_ID);
+        }
+    }
+    if( (i_READ.read() == 1) && (r_CUR_STATE.read() != 0) ) {
+        const Flit& flit = o_DATA.read();
+        if( flit.packet_ptr != NULL ) {
+            if( flit.data[FLIT_WIDTH-2] == 1 ) {
+                if( flit.packet_ptr->traced ) {
+                    PACKET_TRACER->headerGranted(flit.packet_ptr->packetId,ROUTER_ID,PORT_ID);
+                }
+                LATENCY_BREAKDOWN->headerGranted(flit.packet_ptr->packetId,ROUTER_ID,PORT_ID);
+            }
+            if( flit.data[FLIT_WIDTH-1] == 1 ) {
+                if( flit.packet_ptr->traced ) {
+                    PACKET_TRACER->trailerLeft(flit.packet_ptr->packetId,ROUTER_ID,PORT_ID);
+                }
+                LATENCY_BREAKDOWN->trailerLeft(flit.packet_ptr->packetId,ROUTER_ID,PORT_ID);
+            }
+        }
+    }
+}
+
 /////////////////////////////// DATAPATH /////////////////////////////////////
 /*!
  * \brief FIFO::p_NEXT_WRITE_POINTER It determines the next write pointer,
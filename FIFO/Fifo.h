@@ -56,6 +56,9 @@ public:
     void p_WRITE_FIFO();
     void p_OUTPUTS();
 
+    // Packet tracing (clock edge)
+    void tracePackets();
+
     // No FIFO
     void p_NULL();
 
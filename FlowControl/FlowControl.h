@@ -14,6 +14,7 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 | Date       - Version - Author                      | Description
 --------------------------------------------------------------------------------
 | 24/08/2016 - 1.0     - Eduardo Alves da Silva      | Reuse from ParIS
+| 19/10/2026 - 1.1     - SoCIN Simulator team        | Testbench of a link without congestion
 --------------------------------------------------------------------------------
 */
 #ifndef __FLOWCONTROL_H__
@@ -21,6 +22,7 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 
 #include "../SoCINModule.h"
 #include "../SoCINDefines.h"
+#include "../Parameters/Instrumentation.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -81,13 +83,22 @@ public:
     // Module's process to traffic meter
     /*!
      * \brief p_ALERT_PACKET_RECEIVE It is only used to alert the
-     * traffic meter when a packet was received.
+     * traffic meter when a flit was accepted. It is a method process
+     * (it must not wait) registered only by enablePacketMonitoring().
      * The input i_VALID corresponds to i_VALID link signal - bind with the traffic meter.
      * The input i_READ corresponds  to i_RETURN link signal. This signal is an adaptation
      * only for traffic meter use.
      */
     virtual void p_ALERT_PACKET_RECEIVE() = 0;
 
+    /*!
+     * \brief enablePacketMonitoring It registers p_ALERT_PACKET_RECEIVE
+     * to notify e_PACKET_RECEIVED. Only the IFCs with a traffic meter
+     * attached call it (during the elaboration), so the router ports
+     * do not have a monitoring process evaluated every cycle.
+     */
+    virtual void enablePacketMonitoring() = 0;
+
     /*!
      * \brief numberOfCyclesPerFlit Return the number of link cycles to send a flit
      * \return Number of cycles to send a flit
@@ -108,11 +119,7 @@ public:
                 i_WRITE_OK("IFC_iWRITE_OK"),
                 i_READ("IFC_iREAD"),
                 i_READ_OK("IFC_iREAD_OK"),
-                i_DATA("IFC_iDATA") {
-        // Register the packet monitoring process to traffic meter
-        SC_CTHREAD(p_ALERT_PACKET_RECEIVE,i_CLK.pos());
-        sensitive << i_CLK;
-    }
+                i_DATA("IFC_iDATA") {}
 
     ~IInputFlowControl() = 0;
 };
@@ -141,6 +148,9 @@ public:
     sc_out<bool> o_READ;    // Command to read a data from the FIFO
     sc_in<bool>  i_READ_OK; // FIFO has a data to be read (not empty)
 
+    // Counters of the link updated on each clock edge (NULL: disabled) - set by the output module
+    LinkCounters* linkCounters;
+
     IOutputFlowControl(sc_module_name mn,
                        unsigned short ROUTER_ID,
                        unsigned short PORT_ID)
@@ -148,7 +158,8 @@ public:
                 o_VALID("OFC_oVALID"),
                 i_RETURN("OFC_iRETURN"),
                 o_READ("OFC_oREAD"),
-                i_READ_OK("OFC_iREAD_OK") {}
+                i_READ_OK("OFC_iREAD_OK"),
+                linkCounters(NULL) {}
 
     ~IOutputFlowControl() = 0;
 
@@ -212,14 +223,139 @@ typedef IOutputFlowControl* create_OutputFlowControl(sc_simcontext*,
 typedef void destroy_OutputFlowControl(IOutputFlowControl*);
 /////////////////////////////////////////////////////////////
 
-// TODO: To implement testbenchs for Input and Output Flow Controllers
-
 /////////////////////////////////////////////////////////////
-///  Testbench Input Flow Control
+///  Testbench
 /////////////////////////////////////////////////////////////
+/*!
+ * \brief The tst_FlowControl class is a self-contained testbench for a
+ * link (OFC -> IFC of the same plugin) without congestion: the sender
+ * always has a flit to send and the receiver buffer is drained on each
+ * write. The link counters of the OFC must report flits and no stall.
+ */
+class tst_FlowControl : public sc_module {
+private:
+    unsigned int nCycles;
+public:
+    // Interface
+    sc_in_clk                    i_CLK;
+    // Signals to stimulus
+    sc_signal<bool>              w_RST;
+    // Link
+    sc_signal<bool>              w_VALID;
+    sc_signal<bool>              w_RETURN;
+    // Sender FIFO
+    sc_signal<bool>              w_READ;
+    sc_signal<bool>              w_READ_OK;
+    // Receiver FIFO - a flit written is read on the same cycle
+    sc_signal<bool>              w_WRITE;
+    sc_signal<bool>              w_WRITE_OK;
+    sc_signal<Flit>              w_DATA;
+
+    // Design Under Test
+    IOutputFlowControl* ofc;
+    IInputFlowControl*  ifc;
+    LinkCounters        counters;
+    bool                passed;
+
+    // Trace file
+    sc_trace_file *tf;
+
+    void p_stimulus() {
+        // Initialize
+        w_RST.write(true);
+        w_READ_OK.write(false);
+        w_WRITE_OK.write(true);
+        wait();
+
+        w_RST.write(false);
+        w_READ_OK.write(true);  // Sender never empty
+        for( unsigned int i = 0; i < nCycles; i++ ) {
+            wait();
+        }
+
+        passed = counters.flits > 0 && counters.stallCycles == 0;
+        printf("\n[tst_FlowControl] Cycles: %u, Flits: %llu, Busy cycles: %llu, Stall cycles: %llu - %s",
+               nCycles,counters.flits,counters.busyCycles,counters.stallCycles,passed ? "PASSED" : "FAILED");
+
+        sc_stop();
+    }
+
+    // Functions to destroy DUT instances
+    destroy_OutputFlowControl* destroy_OFC;
+    destroy_InputFlowControl*  destroy_IFC;
+
+    SC_HAS_PROCESS(tst_FlowControl);
+    tst_FlowControl(sc_module_name nm,unsigned int numCycles,unsigned short bufferDepth,
+                    create_OutputFlowControl* new_ofc, destroy_OutputFlowControl* del_ofc,
+                    create_InputFlowControl* new_ifc, destroy_InputFlowControl* del_ifc)
+                : sc_module(nm),nCycles(numCycles), i_CLK("tst_FC_CLK"),
+                  w_RST("tst_FC_RESET"), w_VALID("tst_FC_VALID"), w_RETURN("tst_FC_RETURN"),
+                  w_READ("tst_FC_READ"), w_READ_OK("tst_FC_READ_OK"),
+                  w_WRITE("tst_FC_WRITE"), w_WRITE_OK("tst_FC_WRITE_OK"),
+                  w_DATA("tst_FC_DATA"), passed(false)
+    {
+        destroy_OFC = del_ofc;
+        destroy_IFC = del_ifc;
+
+        counters.routerId = 0;
+        counters.portId = 0;
+        counters.currentVc = 0;
+        counters.flits = 0;
+        counters.busyCycles = 0;
+        counters.stallCycles = 0;
+        counters.vcFlits.assign(1,0);
+        counters.vcStallCycles.assign(1,0);
+
+        // Instantiate DUT
+        ofc = new_ofc(sc_get_curr_simcontext(),"OFC_DUT",0,0,bufferDepth);
+        ifc = new_ifc(sc_get_curr_simcontext(),"IFC_DUT",0,0);
+        ofc->linkCounters = &counters;
+        // Binding DUT with testbench ports and signals
+        ofc->i_CLK(i_CLK);
+        ofc->i_RST(w_RST);
+        ofc->o_VALID(w_VALID);
+        ofc->i_RETURN(w_RETURN);
+        ofc->o_READ(w_READ);
+        ofc->i_READ_OK(w_READ_OK);
+
+        ifc->i_CLK(i_CLK);
+        ifc->i_RST(w_RST);
+        ifc->i_VALID(w_VALID);
+        ifc->o_RETURN(w_RETURN);
+        ifc->o_WRITE(w_WRITE);
+        ifc->i_WRITE_OK(w_WRITE_OK);
+        ifc->i_READ(w_WRITE);
+        ifc->i_READ_OK(w_WRITE);
+        ifc->i_DATA(w_DATA);
+
+        // Defining testbench stimulus process
+        SC_CTHREAD(p_stimulus,i_CLK.pos());
+        sensitive << i_CLK;
+
+        // Creating VCD trace file
+        tf = sc_create_vcd_trace_file(ofc->moduleName());
+        // Signals to trace
+        sc_trace(tf, i_CLK, "CLK");
+        sc_trace(tf, w_RST, "RST");
+        sc_trace(tf, w_VALID, "VALID");
+        sc_trace(tf, w_RETURN, "RETURN");
+        sc_trace(tf, w_READ, "READ");
+        sc_trace(tf, w_READ_OK, "READ_OK");
+        sc_trace(tf, w_WRITE, "WRITE");
+    }
+
+    ~tst_FlowControl() {
+        // Closing VCD trace file
+        sc_close_vcd_trace_file(tf);
+        // Deallocating DUT
+        destroy_OFC(ofc);
+        destroy_IFC(ifc);
+    }
+
+};
 
 /////////////////////////////////////////////////////////////
-///  Testbench Output Flow Control
+///  End testbench
 /////////////////////////////////////////////////////////////
 
 #endif // __FLOWCONTROL_H__
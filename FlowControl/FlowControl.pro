@@ -8,6 +8,9 @@ TEMPLATE = aux
 
 include(../common.pri)
 
+# The packet monitoring of the IFCs is spawned on demand (sc_spawn)
+DEFINES += SC_INCLUDE_DYNAMIC_PROCESSES
+
 HEADERS += \
     FlowControl.h
 
@@ -19,6 +19,9 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 
 #include "../SoCINModule.h"
 #include "../SoCINDefines.h"
+#include "../Parameters/Instrumentation.h"
+#include "../Parameters/PacketTracer.h"
+#include "../Parameters/LatencyBreakdown.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -48,6 +51,15 @@ public:
 
     unsigned short int ROUTER_ID, PORT_ID;
 
+    // Occupancy of the memory sampled on each clock edge (NULL: disabled) - set by the port module
+    BufferCounters* bufferCounters;
+
+    // Header and trailer of the packets reported to the packet tracer and latency breakdown - set by the input module
+    bool packetTracing;
+
+    // Writes and reads counted on each clock edge (NULL: disabled) - set by the port module
+    ActivityCounters* activityCounters;
+
     IMemory(sc_module_name mn,
             unsigned short int memSize,
             unsigned short int ROUTER_ID,
@@ -63,7 +75,10 @@ public:
           i_DATA("MEM_iDATA"),
           o_DATA("MEM_oDATA"),
           ROUTER_ID(ROUTER_ID),
-          PORT_ID(PORT_ID) {}
+          PORT_ID(PORT_ID),
+          bufferCounters(NULL),
+          packetTracing(false),
+          activityCounters(NULL) {}
     ~IMemory() = 0;
 };
 inline IMemory::~IMemory() {}
@@ -9,10 +9,8 @@ PG_Random::PG_Random(sc_module_name mn,
                      unsigned short int ROUTER_ID,
                      unsigned short int PORT_ID)
         : IPriorityGenerator(mn,numReqs_Grants,ROUTER_ID,PORT_ID),
-        randomGenerator(SEED)
+        randomGenerator(SEED,((unsigned int) ROUTER_ID << 16) | PORT_ID,RNG_STREAM_PRIORITY)
 {
-    uniformRandom = std::uniform_int_distribution<int>(0, numReqs_Grants-1);
-    srand(SEED);
 
     SC_METHOD(p_OUTPUTS);
     sensitive << i_CLK.pos() << i_RST;
@@ -26,7 +24,7 @@ void PG_Random::p_OUTPUTS()
 {
     UIntVar v_P_tmp(0,numPorts);
 //    v_P_tmp = pow(2, rand() % numPorts);
-    v_P_tmp = pow(2, uniformRandom(randomGenerator));
+    v_P_tmp = pow(2, randomGenerator.uniformInt(numPorts));
     for(unsigned short int i = 0; i < numPorts; i++) {
         o_PRIORITIES[i].write( v_P_tmp[i] );
     }
@@ -2,7 +2,7 @@
 #define __PG_RANDOM_H__
 
 #include "../PriorityGenerator/PriorityGenerator.h"
-#include <random>
+#include "../Parameters/RandomStream.h"
 /*!
  * \brief The PG_Random class implements a random
  * priority generator that randomizes the priorities in
@@ -11,8 +11,7 @@
 class PG_Random : public IPriorityGenerator {
 public:
 
-    std::default_random_engine randomGenerator;
-    std::uniform_int_distribution<int> uniformRandom;
+    RandomStream randomGenerator; // Stream of this router port
 
     // Module's processes
     void p_OUTPUTS();
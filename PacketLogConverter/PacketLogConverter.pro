@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Converter of the binary packet log (packetlog.bin)
+# to the text files of the traffic meters
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+CONFIG -= qt
+CONFIG -= app_bundle
+CONFIG += console
+CONFIG += c++11
+CONFIG += thread
+
+TARGET = snocs_packetlog
+
+# 64-bit file offsets (fseeko) on 32-bit hosts
+unix {
+    DEFINES += _FILE_OFFSET_BITS=64
+}
+
+SOURCES += \
+    main.cpp \
+    ../TrafficMeter/PacketLog.cpp \
+    ../TrafficMeter/LogWriter.cpp
+
+HEADERS += \
+    ../TrafficMeter/PacketLog.h \
+    ../TrafficMeter/LogWriter.h
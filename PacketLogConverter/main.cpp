@@ -0,0 +1,116 @@
+#include "../TrafficMeter/PacketLog.h"
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+#define LOG_BLOCK_RECORDS (1 << 16) // Records read at once
+
+// 64-bit offset - the logs of long runs are larger than 2 GB (long has 32 bits on win32)
+static int seekLog(FILE* file, unsigned long long offset) {
+#if defined(__WIN32__) || defined(_WIN32)
+    return _fseeki64(file,(__int64) offset,SEEK_SET);
+#else
+    return fseeko(file,(off_t) offset,SEEK_SET);
+#endif
+}
+
+/*!
+ * \brief main It writes the text log of each traffic meter (e.g. ext_0_out)
+ * recorded in a binary packet log, in the same format of the simulator.
+ * \param argv [1] Binary packet log; [2] Output folder (default: folder of the log);
+ * [3] Meter to be converted (default: all the meters)
+ */
+int main(int argc, char* argv[]) {
+
+    if( argc < 2 ) {
+        printf("Usage: %s packetlog.bin [output_dir] [meter (e.g. ext_0_out)]\n",argv[0]);
+        return -1;
+    }
+
+    const char* logFileName = argv[1];
+    std::string outputDir;
+    if( argc > 2 ) {
+        outputDir = argv[2];
+    } else {
+        outputDir = logFileName;
+        size_t slash = outputDir.find_last_of('/');
+        outputDir = slash == std::string::npos ? "." : outputDir.substr(0,slash);
+    }
+    const char* selectedMeter = argc > 3 ? argv[3] : NULL;
+
+    FILE* in;
+    if( (in = fopen(logFileName,"rb")) == NULL ) {
+        printf("[PacketLogConverter] ERROR: Impossible to open packet log \"%s\".\n",logFileName);
+        return -1;
+    }
+
+    PacketLog::LogHeader header;
+    if( fread(&header,sizeof(header),1,in) != 1 || strncmp(header.magic,"SNPL",4) != 0
+            || header.version != 1 || header.nameLength == 0 ) {
+        printf("[PacketLogConverter] ERROR: \"%s\" is not a valid packet log (version 1)"
+               " or the simulation did not finish.\n",logFileName);
+        fclose(in);
+        return -1;
+    }
+
+    // Meter table - after the records
+    std::vector<FILE*> outFiles(header.numberOfMeters,(FILE*) NULL);
+    std::vector<char> name(header.nameLength+1,'\0');
+    if( seekLog(in,sizeof(header) + header.numberOfRecords * sizeof(PacketLog::LogRecord)) != 0 ) {
+        printf("[PacketLogConverter] ERROR: Meter table of \"%s\" not found.\n",logFileName);
+        fclose(in);
+        return -1;
+    }
+    for( unsigned int i = 0; i < header.numberOfMeters; i++ ) {
+        if( fread(&name[0],header.nameLength,1,in) != 1 ) {
+            printf("[PacketLogConverter] ERROR: Meter table of \"%s\" truncated.\n",logFileName);
+            fclose(in);
+            return -1;
+        }
+        if( selectedMeter != NULL && strcmp(&name[0],selectedMeter) != 0 ) {
+            continue;
+        }
+        std::string outFileName = outputDir + "/" + &name[0];
+        if( (outFiles[i] = fopen(outFileName.c_str(),"wt")) == NULL ) {
+            printf("[PacketLogConverter] ERROR: It is not possible to open file \"%s\" to write log.\n",
+                   outFileName.c_str());
+            continue;
+        }
+        PacketLog::writeTextHeader(outFiles[i],outFileName.c_str());
+    }
+
+    // Records
+    std::vector<PacketLog::LogRecord> block(LOG_BLOCK_RECORDS);
+    seekLog(in,sizeof(header));
+    unsigned long long remaining = header.numberOfRecords;
+    while( remaining > 0 ) {
+        size_t count = remaining < LOG_BLOCK_RECORDS ? (size_t) remaining : LOG_BLOCK_RECORDS;
+        if( fread(&block[0],sizeof(PacketLog::LogRecord),count,in) != count ) {
+            printf("[PacketLogConverter] ERROR: Records of \"%s\" truncated.\n",logFileName);
+            break;
+        }
+        for( size_t r = 0; r < count; r++ ) {
+            const PacketLog::LogRecord& record = block[r];
+            if( record.meter < outFiles.size() && outFiles[record.meter] != NULL ) {
+                PacketLog::writeTextRecord(outFiles[record.meter],record);
+            }
+        }
+        remaining -= count;
+    }
+    fclose(in);
+
+    unsigned int converted = 0;
+    for( unsigned int i = 0; i < outFiles.size(); i++ ) {
+        if( outFiles[i] != NULL ) {
+            PacketLog::writeTextFooter(outFiles[i],header.endCycle);
+            fclose(outFiles[i]);
+            converted++;
+        }
+    }
+    printf("[PacketLogConverter] %llu packets, %u text logs written in \"%s\"\n",
+           (unsigned long long) header.numberOfRecords,converted,outputDir.c_str());
+
+    return 0;
+}
@@ -1,7 +1,6 @@
 #include "ParIS.h"
 #include "../PluginManager/PluginManager.h"
 
-//#define WAVEFORM_PARIS
 //#define DEBUG_PARIS
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -113,79 +112,48 @@ ParIS_N_VC::ParIS_N_VC(sc_module_name mn,
     SC_METHOD(p_DEBUG);
     sensitive << i_CLK.pos();
 #endif
-#ifdef WAVEFORM_PARIS
-    char waveName[20];
-    sprintf(waveName,"ParIS_%u_VC%u_Port-%u",ROUTER_ID,numVirtualChannels,nPorts);
-    tf = sc_create_vcd_trace_file(waveName);
+    // Internal signals in the waveform (module Router_<id>)
+    if( WAVEFORM->internalSignals() && WAVEFORM->routerSelected(ROUTER_ID) ) {
+        char scope[20];
+        sprintf(scope,"Router_%u",ROUTER_ID);
+        for( vc = 0; vc < nVirtualChannels; vc++) {
+            for( i = 0; i < nPorts; i++) {
+                char strIVc[20];
+                sprintf(strIVc,"Port(%u)Vc(%u)",i,vc);
+                for( o = 0; o < nPorts; o++ ) {
+                    char strIVcJ[30];
+                    sprintf(strIVcJ,"%s(%u)",strIVc,o);
+
+                    char strReq[36];
+                    sprintf(strReq,"wREQ%s",strIVcJ);
+                    WAVEFORM->trace(w_REQUEST[vc][i][o],scope,strReq);
+
+                    char strGrant[38];
+                    sprintf(strGrant,"wGRANT%s",strIVcJ);
+                    WAVEFORM->trace(w_GRANT[vc][i][o],scope,strGrant);
+                }
 
-    sc_trace(tf,i_CLK,"CLK");
-    sc_trace(tf,i_RST,"RST");
+                char strRok[30];
+                sprintf(strRok,"wROK%s",strIVc);
+                WAVEFORM->trace(w_READ_OK[vc][i],scope,strRok);
 
-    for( i = 0; i < nPorts; i++ ) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-        char strDataIn[15];
-        sprintf(strDataIn,"DATA_IN%s",strI);
-        sc_trace(tf, i_DATA_IN[i],strDataIn);
-        char strValidIn[15];
-        sprintf(strValidIn,"VALID_IN%s",strI);
-        sc_trace(tf, i_VALID_IN[i],strValidIn);
-        char strRetIn[15];
-        sprintf(strRetIn,"RET_IN%s",strI);
-        sc_trace(tf, o_RETURN_IN[i],strRetIn);
-
-        char strDataOut[15];
-        sprintf(strDataOut,"DATA_OUT%s",strI);
-        sc_trace(tf, o_DATA_OUT[i],strDataOut);
-        char strValidOut[15];
-        sprintf(strValidOut,"VALID_OUT%s",strI);
-        sc_trace(tf, o_VALID_OUT[i],strValidOut);
-        char strRetOut[15];
-        sprintf(strRetOut,"RET_OUT%s",strI);
-        sc_trace(tf, i_RETURN_OUT[i],strRetOut);
-    }
-    for( vc = 0; vc < nVirtualChannels; vc++) {
-        for( i = 0; i < nPorts; i++) {
-            char strIVc[20];
-            sprintf(strIVc,"Port(%u)Vc(%u)",i,vc);
-            for( o = 0; o < nPorts; o++ ) {
-                char strIVcJ[30];
-                sprintf(strIVcJ,"%s(%u)",strIVc,o);
+                char strRd[29];
+                sprintf(strRd,"wRD%s",strIVc);
+                WAVEFORM->trace(w_READ[vc][i],scope,strRd);
 
-                char strReq[36];
-                sprintf(strReq,"wREQ%s",strIVcJ);
-                sc_trace(tf,w_REQUEST[vc][i][o],strReq);
+                char strIdle[31];
+                sprintf(strIdle,"wIDLE%s",strIVc);
+                WAVEFORM->trace(w_IDLE[vc][i],scope,strIdle);
 
-                char strGrant[38];
-                sprintf(strGrant,"wGRANT%s",strIVcJ);
-                sc_trace(tf,w_GRANT[vc][i][o],strGrant);
+                char strData[31];
+                sprintf(strData,"wDATA%s",strIVc);
+                WAVEFORM->trace(w_DATA[vc][i],scope,strData);
             }
-
-            char strRok[30];
-            sprintf(strRok,"wROK%s",strIVc);
-            sc_trace(tf,w_READ_OK[vc][i],strRok);
-
-            char strRd[29];
-            sprintf(strRd,"wRD%s",strIVc);
-            sc_trace(tf,w_READ[vc][i],strRd);
-
-            char strIdle[31];
-            sprintf(strIdle,"wIDLE%s",strIVc);
-            sc_trace(tf,w_IDLE[vc][i],strIdle);
-
-            char strData[31];
-            sprintf(strData,"wDATA%s",strIVc);
-            sc_trace(tf,w_DATA[vc][i],strData);
         }
     }
-
-#endif
 }
 
 ParIS_N_VC::~ParIS_N_VC() {
-#ifdef WAVEFORM_PARIS
-    sc_close_vcd_trace_file(tf);
-#endif
     for(unsigned short i = 0; i < numPorts; i++) {
         XIN_N_VC* xin = u_XIN[i];
         if(xin) {
@@ -289,7 +257,10 @@ ParIS::ParIS(sc_module_name mn,
         IPriorityGenerator* u_PG = PLUGIN_MANAGER->priorityGeneratorInstance(strPG,ROUTER_ID,i,nPorts);
         char strArb[35];
         sprintf(strArb,"%s_DIST_ARBITER",strXOUT);
-        IArbiter* u_ARBITER = new DistributedArbiter(strArb,nPorts,u_PG,ROUTER_ID,i);
+        DistributedArbiter* u_ARBITER = new DistributedArbiter(strArb,nPorts,u_PG,ROUTER_ID,i);
+        if( ACTIVITY_COUNTERS ) {
+            u_ARBITER->u_PPE->activityCounters = INSTRUMENTATION->activityCounters(ROUTER_ID);
+        }
         char strOFC[20];
         sprintf(strOFC,"%s_OFC",strXOUT);
         // The last argument is used only in credit-based flow control
@@ -350,74 +321,46 @@ ParIS::ParIS(sc_module_name mn,
     SC_METHOD(p_DEBUG);
     sensitive << i_CLK.pos();
 #endif
-#ifdef WAVEFORM_PARIS
-    char waveName[20];
-    sprintf(waveName,"ParIS_%u_%u",ROUTER_ID,nPorts);
-    tf = sc_create_vcd_trace_file(waveName);
-
-    sc_trace(tf,i_CLK,"CLK");
-    sc_trace(tf,i_RST,"RST");
+    // Internal signals in the waveform (module Router_<id>)
+    if( WAVEFORM->internalSignals() && WAVEFORM->routerSelected(ROUTER_ID) ) {
+        char scope[20];
+        sprintf(scope,"Router_%u",ROUTER_ID);
+        for( i = 0; i < nPorts; i++ ) {
+            char strI[5];
+            sprintf(strI,"(%u)",i);
+            for( j = 0; j < nPorts; j++ ) {
+                char strIJ[10];
+                sprintf(strIJ,"%s(%u)",strI,j);
+
+                char strReq[16];
+                sprintf(strReq,"wREQ%s",strIJ);
+                WAVEFORM->trace(w_REQUEST[i][j],scope,strReq);
+
+                char strGrant[18];
+                sprintf(strGrant,"wGRANT%s",strIJ);
+                WAVEFORM->trace(w_GRANT[i][j],scope,strGrant);
+            }
 
-    for( i = 0; i < nPorts; i++ ) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-        char strDataIn[15];
-        sprintf(strDataIn,"DATA_IN%s",strI);
-        sc_trace(tf, i_DATA_IN[i],strDataIn);
-        char strValidIn[15];
-        sprintf(strValidIn,"VALID_IN%s",strI);
-        sc_trace(tf, i_VALID_IN[i],strValidIn);
-        char strRetIn[15];
-        sprintf(strRetIn,"RET_IN%s",strI);
-        sc_trace(tf, o_RETURN_IN[i],strRetIn);
-
-        char strDataOut[15];
-        sprintf(strDataOut,"DATA_OUT%s",strI);
-        sc_trace(tf, o_DATA_OUT[i],strDataOut);
-        char strValidOut[15];
-        sprintf(strValidOut,"VALID_OUT%s",strI);
-        sc_trace(tf, o_VALID_OUT[i],strValidOut);
-        char strRetOut[15];
-        sprintf(strRetOut,"RET_OUT%s",strI);
-        sc_trace(tf, i_RETURN_OUT[i],strRetOut);
+            char strRok[10];
+            sprintf(strRok,"wROK%s",strI);
+            WAVEFORM->trace(w_READ_OK[i],scope,strRok);
 
-        for( j = 0; j < nPorts; j++ ) {
-            char strIJ[10];
-            sprintf(strIJ,"%s(%u)",strI,j);
+            char strRd[9];
+            sprintf(strRd,"wRD%s",strI);
+            WAVEFORM->trace(w_READ[i],scope,strRd);
 
-            char strReq[16];
-            sprintf(strReq,"wREQ%s",strIJ);
-            sc_trace(tf,w_REQUEST[i][j],strReq);
+            char strIdle[11];
+            sprintf(strIdle,"wIDLE%s",strI);
+            WAVEFORM->trace(w_IDLE[i],scope,strIdle);
 
-            char strGrant[18];
-            sprintf(strGrant,"wGRANT%s",strIJ);
-            sc_trace(tf,w_GRANT[i][j],strGrant);
+            char strData[11];
+            sprintf(strData,"wDATA%s",strI);
+            WAVEFORM->trace(w_DATA[i],scope,strData);
         }
-
-        char strRok[10];
-        sprintf(strRok,"wROK%s",strI);
-        sc_trace(tf,w_READ_OK[i],strRok);
-
-        char strRd[9];
-        sprintf(strRd,"wRD%s",strI);
-        sc_trace(tf,w_READ[i],strRd);
-
-        char strIdle[11];
-        sprintf(strIdle,"wIDLE%s",strI);
-        sc_trace(tf,w_IDLE[i],strIdle);
-
-        char strData[11];
-        sprintf(strData,"wDATA%s",strI);
-        sc_trace(tf,w_DATA[i],strData);
     }
-
-#endif
 }
 
 ParIS::~ParIS() {
-#ifdef WAVEFORM_PARIS
-    sc_close_vcd_trace_file(tf);
-#endif
     for(unsigned short i = 0; i < numPorts; i++) {
         XIN_none_VC* xin = u_XIN[i];
         if(xin) {
@@ -53,8 +53,6 @@ public:
         w_GND.write(0);
     }
 
-    sc_trace_file* tf;
-
     void p_DEBUG();
 
     SC_HAS_PROCESS(ParIS_N_VC);
@@ -99,8 +97,6 @@ public:
         w_GND.write(0);
     }
 
-    sc_trace_file* tf;
-
     void p_DEBUG();
 
     SC_HAS_PROCESS(ParIS);
@@ -35,12 +35,16 @@ ParIS_none_VC_Bus::ParIS_none_VC_Bus(sc_module_name mn,unsigned short nPorts)
 
     // Instantiating internal modules
     IPriorityGenerator* pg = PLUGIN_MANAGER->priorityGeneratorInstance("PG_BUS",ROUTER_ID,0,nPorts);
-    u_ARBITER     = new DistributedArbiter("Arbiter_BUS",nPorts,pg,ROUTER_ID,0);
+    DistributedArbiter* arbiter = new DistributedArbiter("Arbiter_BUS",nPorts,pg,ROUTER_ID,0);
+    u_ARBITER     = arbiter;
     u_ODS_MUX     = new OneHotMux<Flit>("ODS_BUS",nPorts);
     u_OWS_MUX     = new OneHotMux<bool>("OWS_INPUT",nPorts);
     u_OWS_DEMUX   = new OneHotDemux<bool>("OWS_OUTPUT",nPorts);
     u_IRS_MUX     = new OneHotMux<bool>("IRS_INPUT",nPorts);
     u_IRS_DEMUX   = new OneHotDemux<bool>("IRS_OUTPUT",nPorts);
+    if( ACTIVITY_COUNTERS ) {
+        arbiter->u_PPE->activityCounters = INSTRUMENTATION->activityCounters(ROUTER_ID);
+    }
     for( i = 0; i < nPorts; i++) {
         char strIfc[15];
         sprintf(strIfc,"BUS_IFC(%u)",i);
@@ -48,12 +52,25 @@ ParIS_none_VC_Bus::ParIS_none_VC_Bus(sc_module_name mn,unsigned short nPorts)
         char strMemIn[16];
         sprintf(strMemIn,"BUS_MEM_IN(%u)",i);
         u_MEM_IN[i] = PLUGIN_MANAGER->memoryInstance(strMemIn,ROUTER_ID,i,FIFO_IN_DEPTH);
+        if( BUFFER_OCCUPANCY && FIFO_IN_DEPTH > 0 ) {
+            u_MEM_IN[i]->bufferCounters = INSTRUMENTATION->bufferCounters(ROUTER_ID,i,0,true,FIFO_IN_DEPTH);
+        }
+        u_MEM_IN[i]->packetTracing = PACKET_TRACER->isOpen() || LATENCY_BREAKDOWN->isEnabled();
+        if( ACTIVITY_COUNTERS ) {
+            u_MEM_IN[i]->activityCounters = INSTRUMENTATION->activityCounters(ROUTER_ID);
+        }
         char strIc[15];
         sprintf(strIc,"BUS_IC(%u)",i);
         u_IC[i] = new InputControllerBus(strIc,nPorts,ROUTER_ID,i);
         char strMemOut[17];
         sprintf(strMemOut,"BUS_MEM_OUT(%u)",i);
         u_MEM_OUT[i] = PLUGIN_MANAGER->memoryInstance(strMemOut,ROUTER_ID,i,FIFO_OUT_DEPTH);
+        if( BUFFER_OCCUPANCY && FIFO_OUT_DEPTH > 0 ) {
+            u_MEM_OUT[i]->bufferCounters = INSTRUMENTATION->bufferCounters(ROUTER_ID,i,0,false,FIFO_OUT_DEPTH);
+        }
+        if( ACTIVITY_COUNTERS ) {
+            u_MEM_OUT[i]->activityCounters = INSTRUMENTATION->activityCounters(ROUTER_ID);
+        }
         char strOfc[15];
         sprintf(strOfc,"BUS_OFC(%u)",i);
         u_OFC[i] = PLUGIN_MANAGER->outputFlowControlInstance(strOfc,ROUTER_ID,i,FIFO_IN_DEPTH);
@@ -0,0 +1,468 @@
+#include "Instrumentation.h"
+#include "Parameters.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+Instrumentation* Instrumentation::registry = 0; // Defining and initializing
+
+Instrumentation* Instrumentation::instance() {
+    if( !registry ) {
+        registry = new Instrumentation();
+    }
+    return registry;
+}
+
+Instrumentation::Instrumentation() {
+    energy.bufferWrite = energy.bufferRead = energy.crossbar = 0.0;
+    energy.arbitration = energy.routing = energy.link = energy.leakage = 0.0;
+}
+
+Instrumentation::~Instrumentation() {
+    for( unsigned int i = 0; i < links.size(); i++ ) {
+        delete links[i];
+    }
+    for( unsigned int i = 0; i < buffers.size(); i++ ) {
+        delete buffers[i];
+    }
+    for( unsigned int i = 0; i < stalls.size(); i++ ) {
+        delete stalls[i];
+    }
+    for( unsigned int i = 0; i < activity.size(); i++ ) {
+        delete activity[i];
+    }
+}
+
+LinkCounters* Instrumentation::linkCounters(unsigned short routerId,
+                                            unsigned short portId,
+                                            unsigned short numVirtualChannels) {
+    LinkCounters* counters = new LinkCounters();
+    counters->routerId = routerId;
+    counters->portId = portId;
+    counters->currentVc = 0;
+    counters->flits = counters->busyCycles = counters->stallCycles = 0;
+    counters->vcFlits.assign(numVirtualChannels > 1 ? numVirtualChannels : 1,0);
+    counters->vcStallCycles.assign(counters->vcFlits.size(),0);
+    links.push_back(counters);
+    return counters;
+}
+
+BufferCounters* Instrumentation::bufferCounters(unsigned short routerId,
+                                                unsigned short portId,
+                                                unsigned short vc,
+                                                bool input,
+                                                unsigned short depth) {
+    BufferCounters* counters = new BufferCounters();
+    counters->routerId = routerId;
+    counters->portId = portId;
+    counters->vc = vc;
+    counters->input = input;
+    counters->depth = depth;
+    counters->cycles = counters->flitCycles = 0;
+    counters->maxLevel = 0;
+    counters->levels.assign(depth+1,0);
+    buffers.push_back(counters);
+    return counters;
+}
+
+StallCounters* Instrumentation::stallCounters(unsigned short routerId,
+                                              unsigned short portId,
+                                              unsigned short vc,
+                                              bool virtualChannels,
+                                              unsigned int interval) {
+    StallCounters* counters = new StallCounters();
+    counters->routerId = routerId;
+    counters->portId = portId;
+    counters->vc = vc;
+    counters->virtualChannels = virtualChannels;
+    counters->cycles = counters->headCycles = 0;
+    counters->interval = interval;
+    for( unsigned short i = 0; i < NUM_STALL_CAUSES; i++ ) {
+        counters->causes[i] = counters->window[i] = 0;
+    }
+    stalls.push_back(counters);
+    return counters;
+}
+
+static void routerCoordinates(unsigned short routerId, unsigned short dimensions,
+                              unsigned short& x, unsigned short& y, unsigned short& z) {
+    x = routerId;
+    y = z = 0;
+    if( dimensions == 2 ) {
+        x = ID_TO_COORDINATE_2D_X(routerId);
+        y = ID_TO_COORDINATE_2D_Y(routerId);
+    } else if( dimensions == 3 ) {
+        x = ID_TO_COORDINATE_3D_X(routerId);
+        y = ID_TO_COORDINATE_3D_Y(routerId);
+        z = ID_TO_COORDINATE_3D_Z(routerId);
+    }
+}
+
+static bool linkOrder(const LinkCounters* a, const LinkCounters* b) {
+    return a->routerId < b->routerId || (a->routerId == b->routerId && a->portId < b->portId);
+}
+
+void Instrumentation::writeLinkReport(FILE *out, unsigned long long cycles, unsigned short dimensions) const {
+
+    std::vector<LinkCounters*> sorted(links);
+    std::sort(sorted.begin(),sorted.end(),linkOrder);
+    double totalCycles = cycles > 0 ? (double) cycles : 1.0;
+
+    fprintf(out,"# Link counters of the router output ports - %llu cycles\n",cycles);
+    fprintf(out,"# Router\t   X\t   Y\t   Z\tPort\t  VC\t       Flits\t        Busy\t       Stall\tFlits/cycle\n");
+    unsigned short maxPort = 0;
+    for( unsigned int i = 0; i < sorted.size(); i++ ) {
+        const LinkCounters& c = *sorted[i];
+        unsigned short x, y, z;
+        routerCoordinates(c.routerId,dimensions,x,y,z);
+        fprintf(out,"%8u\t%4u\t%4u\t%4u\t%4u\t%4s\t%12llu\t%12llu\t%12llu\t%11.6f\n",
+                c.routerId,x,y,z,c.portId,"-",c.flits,c.busyCycles,c.stallCycles,c.flits / totalCycles);
+        if( c.vcFlits.size() > 1 ) {
+            for( unsigned short vc = 0; vc < c.vcFlits.size(); vc++ ) {
+                fprintf(out,"%8u\t%4u\t%4u\t%4u\t%4u\t%4u\t%12llu\t%12s\t%12llu\t%11.6f\n",
+                        c.routerId,x,y,z,c.portId,vc,c.vcFlits[vc],"-",c.vcStallCycles[vc],c.vcFlits[vc] / totalCycles);
+            }
+        }
+        if( c.portId > maxPort ) {
+            maxPort = c.portId;
+        }
+    }
+
+    if( dimensions < 2 || sorted.empty() ) {
+        return;
+    }
+
+    // Heatmaps: a matrix of utilization (flits/cycle) by port and layer
+    unsigned short layers = dimensions == 3 ? Z_SIZE : 1;
+    unsigned int routersPerLayer = X_SIZE * Y_SIZE;
+    std::vector<double> matrix;
+    for( unsigned short port = 0; port <= maxPort; port++ ) {
+        for( unsigned short z = 0; z < layers; z++ ) {
+            matrix.assign(routersPerLayer,-1.0);
+            for( unsigned int i = 0; i < sorted.size(); i++ ) {
+                const LinkCounters& c = *sorted[i];
+                if( c.portId == port && c.routerId / routersPerLayer == z ) {
+                    matrix[c.routerId % routersPerLayer] = c.flits / totalCycles;
+                }
+            }
+            fprintf(out,"\n# Heatmap port %u layer %u (flits/cycle - rows: Y, columns: X, -: no port)\n",port,z);
+            for( unsigned short y = 0; y < Y_SIZE; y++ ) {
+                for( unsigned short x = 0; x < X_SIZE; x++ ) {
+                    double value = matrix[COORDINATE_2D_TO_ID(x,y)];
+                    if( value < 0 ) {
+                        fprintf(out,"%s%8s",x > 0 ? "\t" : "","-");
+                    } else {
+                        fprintf(out,"%s%8.6f",x > 0 ? "\t" : "",value);
+                    }
+                }
+                fprintf(out,"\n");
+            }
+        }
+    }
+}
+
+static bool bufferOrder(const BufferCounters* a, const BufferCounters* b) {
+    if( a->routerId != b->routerId ) {
+        return a->routerId < b->routerId;
+    }
+    if( a->portId != b->portId ) {
+        return a->portId < b->portId;
+    }
+    if( a->input != b->input ) {
+        return a->input;
+    }
+    return a->vc < b->vc;
+}
+
+void Instrumentation::writeBufferReport(FILE *out, unsigned short dimensions) const {
+
+    std::vector<BufferCounters*> sorted(buffers);
+    std::sort(sorted.begin(),sorted.end(),bufferOrder);
+
+    fprintf(out,"# Buffer occupancy (time-weighted, in flits) of the router FIFOs\n");
+    fprintf(out,"# Router\t   X\t   Y\t   Z\tPort\tDir\t  VC\tDepth\t    Mean\t Max\t p99\t  Full(%%)\n");
+    for( unsigned int i = 0; i < sorted.size(); i++ ) {
+        const BufferCounters& c = *sorted[i];
+        unsigned short x, y, z;
+        routerCoordinates(c.routerId,dimensions,x,y,z);
+        double cycles = c.cycles > 0 ? (double) c.cycles : 1.0;
+
+        // Smallest level not exceeded in 99% of the cycles
+        unsigned short p99 = 0;
+        unsigned long long accumulated = 0;
+        while( p99 < c.depth && (accumulated += c.levels[p99]) < 0.99 * c.cycles ) {
+            p99++;
+        }
+
+        fprintf(out,"%8u\t%4u\t%4u\t%4u\t%4u\t%3s\t%4u\t%5u\t%8.4f\t%4u\t%4u\t%9.4f\n",
+                c.routerId,x,y,z,c.portId,c.input ? "in" : "out",c.vc,c.depth,
+                c.flitCycles / cycles,c.maxLevel,p99,100.0 * c.levels[c.depth] / cycles);
+    }
+
+    fprintf(out,"\n# Histograms: cycles with 0, 1, ..., depth flits stored\n");
+    fprintf(out,"# Router\tPort\tDir\t  VC\tCycles by level\n");
+    for( unsigned int i = 0; i < sorted.size(); i++ ) {
+        const BufferCounters& c = *sorted[i];
+        fprintf(out,"%8u\t%4u\t%3s\t%4u\t",c.routerId,c.portId,c.input ? "in" : "out",c.vc);
+        for( unsigned short level = 0; level <= c.depth; level++ ) {
+            fprintf(out,"%s%llu",level > 0 ? " " : "",c.levels[level]);
+        }
+        fprintf(out,"\n");
+    }
+}
+
+static bool stallOrder(const StallCounters* a, const StallCounters* b) {
+    if( a->routerId != b->routerId ) {
+        return a->routerId < b->routerId;
+    }
+    if( a->portId != b->portId ) {
+        return a->portId < b->portId;
+    }
+    return a->vc < b->vc;
+}
+
+void Instrumentation::writeStallReport(FILE *out, unsigned short dimensions) const {
+
+    std::vector<StallCounters*> sorted(stalls);
+    std::sort(sorted.begin(),sorted.end(),stallOrder);
+
+    fprintf(out,"# Stall cycles of the router inputs: cycles with a flit at the head of the input buffer\n"
+                "# not read, by cause. Routing: header not routed yet; Arbitration: output idle, not granted\n"
+                "# (includes the arbitration cycle); Output busy / VC unavailable: output (VC) held by\n"
+                "# another packet; No credit: packet granted, downstream cannot receive\n");
+    fprintf(out,"# Router\t   X\t   Y\t   Z\tPort\t  VC\t        Head\t     Routing\t Arbitration\t Output busy\t  VC unavail\t   No credit\t Stalled(%%)\n");
+
+    std::vector<unsigned long long> routerHead;
+    std::vector<std::vector<unsigned long long> > routerCauses;
+    for( unsigned int i = 0; i < sorted.size(); i++ ) {
+        const StallCounters& c = *sorted[i];
+        unsigned short x, y, z;
+        routerCoordinates(c.routerId,dimensions,x,y,z);
+        unsigned long long stalled = 0;
+        for( unsigned short cause = 0; cause < NUM_STALL_CAUSES; cause++ ) {
+            stalled += c.causes[cause];
+        }
+        fprintf(out,"%8u\t%4u\t%4u\t%4u\t%4u\t%4u\t%12llu\t%12llu\t%12llu\t%12llu\t%12llu\t%12llu\t%11.4f\n",
+                c.routerId,x,y,z,c.portId,c.vc,c.headCycles,
+                c.causes[StallRouting],c.causes[StallArbitration],c.causes[StallOutputBusy],
+                c.causes[StallVcUnavailable],c.causes[StallNoCredit],
+                c.headCycles > 0 ? 100.0 * stalled / c.headCycles : 0.0);
+
+        if( c.routerId >= routerHead.size() ) {
+            routerHead.resize(c.routerId + 1,0);
+            routerCauses.resize(c.routerId + 1,std::vector<unsigned long long>(NUM_STALL_CAUSES,0));
+        }
+        routerHead[c.routerId] += c.headCycles;
+        for( unsigned short cause = 0; cause < NUM_STALL_CAUSES; cause++ ) {
+            routerCauses[c.routerId][cause] += c.causes[cause];
+        }
+    }
+
+    fprintf(out,"\n# Totals by router (all the inputs)\n");
+    fprintf(out,"# Router\t        Head\t     Routing\t Arbitration\t Output busy\t  VC unavail\t   No credit\n");
+    for( unsigned int r = 0; r < routerHead.size(); r++ ) {
+        if( routerHead[r] == 0 ) {
+            continue;
+        }
+        fprintf(out,"%8u\t%12llu\t%12llu\t%12llu\t%12llu\t%12llu\t%12llu\n",r,routerHead[r],
+                routerCauses[r][StallRouting],routerCauses[r][StallArbitration],routerCauses[r][StallOutputBusy],
+                routerCauses[r][StallVcUnavailable],routerCauses[r][StallNoCredit]);
+    }
+}
+
+void Instrumentation::writeStallSeries(FILE *out) const {
+
+    std::vector<StallCounters*> sorted(stalls);
+    std::sort(sorted.begin(),sorted.end(),stallOrder);
+
+    fprintf(out,"# Stall cycles by cause of the router inputs by window (Cycle: last cycle of the window)\n");
+    fprintf(out,"#        Cycle\tRouter\tPort\t  VC\t Routing\tArbitration\tOutput busy\t  VC unavail\tNo credit\n");
+    if( sorted.empty() || sorted[0]->interval == 0 ) {
+        return;
+    }
+
+    // All the inputs are sampled from the same clock edge: the same windows
+    unsigned int interval = sorted[0]->interval;
+    unsigned long long windows = (sorted[0]->cycles + interval - 1) / interval;
+    for( unsigned long long w = 0; w < windows; w++ ) {
+        unsigned long long lastCycle = std::min((w + 1) * interval,sorted[0]->cycles);
+        for( unsigned int i = 0; i < sorted.size(); i++ ) {
+            const StallCounters& c = *sorted[i];
+            const unsigned long long* values = (w + 1) * NUM_STALL_CAUSES <= c.series.size()
+                    ? &c.series[w * NUM_STALL_CAUSES] : c.window; // Last window (incomplete)
+            unsigned long long stalled = 0;
+            for( unsigned short cause = 0; cause < NUM_STALL_CAUSES; cause++ ) {
+                stalled += values[cause];
+            }
+            if( stalled == 0 ) {
+                continue;
+            }
+            fprintf(out,"%14llu\t%6u\t%4u\t%4u\t%8llu\t%11llu\t%11llu\t%12llu\t%9llu\n",
+                    lastCycle,c.routerId,c.portId,c.vc,
+                    values[StallRouting],values[StallArbitration],values[StallOutputBusy],
+                    values[StallVcUnavailable],values[StallNoCredit]);
+        }
+    }
+}
+
+ActivityCounters* Instrumentation::activityCounters(unsigned short routerId) {
+    if( routerId >= activity.size() ) {
+        activity.resize(routerId + 1,NULL);
+    }
+    if( activity[routerId] == NULL ) {
+        ActivityCounters* counters = new ActivityCounters();
+        counters->routerId = routerId;
+        counters->bufferWrites = counters->bufferReads = counters->crossbarTraversals = 0;
+        counters->arbitrations = counters->routeComputations = 0;
+        activity[routerId] = counters;
+    }
+    return activity[routerId];
+}
+
+bool Instrumentation::readEnergyTable(const char *fileName) {
+
+    FILE* file;
+    if( (file = fopen(fileName,"rt")) == NULL ) {
+        printf("\n[Instrumentation] ERROR: Impossible to open the energy table \"%s\".",fileName);
+        return false;
+    }
+
+    EnergyTable table;
+    table.fileName = fileName;
+    table.bufferWrite = table.bufferRead = table.crossbar = 0.0;
+    table.arbitration = table.routing = table.link = table.leakage = 0.0;
+    struct {
+        const char* name;
+        double* value;
+    } events[] = {
+        { "buffer_write", &table.bufferWrite },
+        { "buffer_read",  &table.bufferRead  },
+        { "crossbar",     &table.crossbar    },
+        { "arbitration",  &table.arbitration },
+        { "routing",      &table.routing     },
+        { "link",         &table.link        },
+        { "leakage",      &table.leakage     }
+    };
+    unsigned int numEvents = sizeof(events) / sizeof(events[0]);
+
+    char line[512];
+    unsigned int lineNumber = 0;
+    while( fgets(line,sizeof(line),file) != NULL ) {
+        lineNumber++;
+        char* comment = strchr(line,'#');
+        if( comment != NULL ) {
+            *comment = '\0';
+        }
+        char name[256];
+        char value[256];
+        int fields = sscanf(line,"%255s %255s",name,value);
+        if( fields <= 0 ) {
+            continue; // Blank line or comment
+        }
+        char* end = NULL;
+        double energyValue = fields == 2 ? strtod(value,&end) : -1.0;
+        unsigned int event = 0;
+        while( event < numEvents && strcmp(name,events[event].name) != 0 ) {
+            event++;
+        }
+        if( event == numEvents || fields != 2 || *end != '\0' || energyValue < 0.0 ) {
+            printf("\n[Instrumentation] ERROR: Line %u of \"%s\" must be \"<event> <value>\" "
+                   "(buffer_write, buffer_read, crossbar, arbitration, routing, link or leakage).",
+                   lineNumber,fileName);
+            fclose(file);
+            return false;
+        }
+        *events[event].value = energyValue;
+    }
+    fclose(file);
+
+    energy = table;
+    return true;
+}
+
+void Instrumentation::writeActivityReport(FILE *out,
+                                          unsigned long long cycles,
+                                          unsigned long long flitsDelivered,
+                                          unsigned short dimensions) const {
+
+    // Link traversals: the flits of the output ports of each router
+    std::vector<unsigned long long> linkFlits(activity.size(),0);
+    for( unsigned int i = 0; i < links.size(); i++ ) {
+        if( links[i]->routerId < linkFlits.size() ) {
+            linkFlits[links[i]->routerId] += links[i]->flits;
+        }
+    }
+
+    bool withEnergy = !energy.fileName.empty();
+    double time = cycles * CLK_PERIOD; // ns - pJ / ns = mW
+    if( time <= 0.0 ) {
+        time = 1.0;
+    }
+
+    fprintf(out,"# Activity of the routers - %llu cycles of %.3f ns\n",cycles,(double) CLK_PERIOD);
+    if( withEnergy ) {
+        fprintf(out,"# Energy table: %s (pJ by event: buffer write %g, buffer read %g, crossbar %g,\n"
+                    "# arbitration %g, routing %g, link %g - leakage %g mW by router)\n",
+                energy.fileName.c_str(),energy.bufferWrite,energy.bufferRead,energy.crossbar,
+                energy.arbitration,energy.routing,energy.link,energy.leakage);
+    } else {
+        fprintf(out,"# No energy table (-energy <file>): only the events are reported\n");
+    }
+    fprintf(out,"# Router\t   X\t   Y\t   Z\t Buf writes\t  Buf reads\t   Crossbar\tArbitration\t    Routing\t      Links");
+    if( withEnergy ) {
+        fprintf(out,"\t  Dynamic(pJ)\tDynamic(mW)\t  Total(mW)");
+    }
+    fprintf(out,"\n");
+
+    ActivityCounters total;
+    total.bufferWrites = total.bufferReads = total.crossbarTraversals = 0;
+    total.arbitrations = total.routeComputations = 0;
+    unsigned long long totalLinkFlits = 0;
+    unsigned int routers = 0;
+    double totalEnergy = 0.0;
+    for( unsigned int r = 0; r < activity.size(); r++ ) {
+        const ActivityCounters* c = activity[r];
+        if( c == NULL ) {
+            continue;
+        }
+        unsigned short x, y, z;
+        routerCoordinates(c->routerId,dimensions,x,y,z);
+        fprintf(out,"%8u\t%4u\t%4u\t%4u\t%11llu\t%11llu\t%11llu\t%11llu\t%11llu\t%11llu",
+                c->routerId,x,y,z,c->bufferWrites,c->bufferReads,c->crossbarTraversals,
+                c->arbitrations,c->routeComputations,linkFlits[r]);
+        if( withEnergy ) {
+            double dynamic = c->bufferWrites * energy.bufferWrite + c->bufferReads * energy.bufferRead
+                    + c->crossbarTraversals * energy.crossbar + c->arbitrations * energy.arbitration
+                    + c->routeComputations * energy.routing + linkFlits[r] * energy.link;
+            fprintf(out,"\t%13.1f\t%11.4f\t%11.4f",dynamic,dynamic / time,dynamic / time + energy.leakage);
+            totalEnergy += dynamic;
+        }
+        fprintf(out,"\n");
+
+        total.bufferWrites += c->bufferWrites;
+        total.bufferReads += c->bufferReads;
+        total.crossbarTraversals += c->crossbarTraversals;
+        total.arbitrations += c->arbitrations;
+        total.routeComputations += c->routeComputations;
+        totalLinkFlits += linkFlits[r];
+        routers++;
+    }
+
+    fprintf(out,"\n# Network (%u routers)\n",routers);
+    fprintf(out,"# Buffer writes: %llu - buffer reads: %llu - crossbar traversals: %llu - arbitrations: %llu"
+                " - route computations: %llu - link traversals: %llu - flits delivered: %llu\n",
+            total.bufferWrites,total.bufferReads,total.crossbarTraversals,total.arbitrations,
+            total.routeComputations,totalLinkFlits,flitsDelivered);
+    if( withEnergy ) {
+        double dynamicPower = totalEnergy / time;
+        double power = dynamicPower + routers * energy.leakage;
+        double throughput = flitsDelivered / (cycles > 0 ? (double) cycles : 1.0); // flits/cycle
+        fprintf(out,"# Dynamic energy: %.1f pJ - %.3f pJ by flit delivered\n",
+                totalEnergy,flitsDelivered > 0 ? totalEnergy / flitsDelivered : 0.0);
+        fprintf(out,"# Average power: %.4f mW (dynamic %.4f mW + leakage %.4f mW)\n",
+                power,dynamicPower,routers * energy.leakage);
+        fprintf(out,"# Accepted throughput by watt: %.4f flits/cycle/W\n",
+                power > 0.0 ? throughput / (power / 1000.0) : 0.0);
+    }
+}
@@ -0,0 +1,314 @@
+/*
+--------------------------------------------------------------------------------
+PROJECT: SoCIN_Simulator
+MODULE : No modules - global instrumentation
+FILE   : Instrumentation.h
+--------------------------------------------------------------------------------
+DESCRIPTION: Registry of the counters that the network components update
+during the simulation (shared by the simulator and the plugins)
+--------------------------------------------------------------------------------
+AUTHORS: Laboratory of Embedded and Distributed Systems (LEDS - UNIVALI)
+CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
+-------------------------------- Reviews ---------------------------------------
+| Date       - Version - Author                      | Description
+--------------------------------------------------------------------------------
+| 19/10/2026 - 1.0     - SoCIN Simulator team        | Link counters
+| 19/10/2026 - 1.1     - SoCIN Simulator team        | Buffer occupancy
+| 19/10/2026 - 1.2     - SoCIN Simulator team        | Stall counters
+| 19/10/2026 - 1.3     - SoCIN Simulator team        | Activity counters and energy
+--------------------------------------------------------------------------------
+*/
+
+#ifndef __INSTRUMENTATION_H__
+#define __INSTRUMENTATION_H__
+
+#include "../export.h"
+
+#include <vector>
+#include <string>
+#include <cstdio>
+
+// Singleton instance
+#define INSTRUMENTATION Instrumentation::instance() // Get the registry of counters
+
+/////////////////////////////////////////////////////////////////////////
+/// Counters of a router output port (the link driven by its OFC)
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The LinkCounters struct is updated by the output flow controller
+ * on each clock edge. The virtual channel of the flit in the link is set
+ * by the output module (XOUT) when it selects a channel.
+ */
+struct LinkCounters {
+    unsigned short routerId;
+    unsigned short portId;
+    unsigned short currentVc;           // Virtual channel in the link
+    unsigned long long flits;           // Flits transferred
+    unsigned long long busyCycles;      // Cycles with the link occupied (VALID asserted)
+    unsigned long long stallCycles;     // Cycles with a flit waiting and the link not started (no credit or receiver busy)
+    std::vector<unsigned long long> vcFlits;
+    std::vector<unsigned long long> vcStallCycles;
+
+    inline void count(bool transfer, bool busy, bool stall) {
+        if( transfer ) {
+            flits++;
+            vcFlits[currentVc]++;
+        }
+        if( busy ) {
+            busyCycles++;
+        }
+        if( stall ) {
+            stallCycles++;
+            vcStallCycles[currentVc]++;
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// Occupancy of a buffer (FIFO) of a router port
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The BufferCounters struct is updated by the FIFO on each clock
+ * edge with its fill level, so each cycle has the same weight and the
+ * histogram (cycles by number of flits stored) gives the time-weighted
+ * occupancy statistics.
+ */
+struct BufferCounters {
+    unsigned short routerId;
+    unsigned short portId;
+    unsigned short vc;                        // Virtual channel (0 w/o VCs)
+    bool input;                               // Input (XIN) or output (XOUT) buffer
+    unsigned short depth;                     // Capacity (flits)
+    unsigned long long cycles;                // Cycles sampled
+    unsigned long long flitCycles;            // Sum of the fill level over the cycles
+    unsigned short maxLevel;                  // Maximum fill level
+    std::vector<unsigned long long> levels;   // Cycles by fill level (0..depth)
+
+    inline void sample(unsigned short level) {
+        levels[level]++;
+        flitCycles += level;
+        cycles++;
+        if( level > maxLevel ) {
+            maxLevel = level;
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// Stalls of an input port (virtual channel) of a router
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The StallCause enum classifies a cycle with a flit at the head of
+ * an input buffer not read. The header waits for the routing (no request
+ * yet), for the arbitration (the output requested is idle but the grant
+ * went to another input or is being computed) or for an output held by
+ * the wormhole of another packet (output busy - w/o VCs, or the output VC
+ * allocated to another packet - VC unavailable). A flit of a packet already
+ * granted waits for the downstream: credit or ack, room in the output
+ * buffer or, with VCs, the link used by another VC.
+ */
+enum StallCause {
+    StallRouting = 0,
+    StallArbitration,
+    StallOutputBusy,
+    StallVcUnavailable,
+    StallNoCredit,
+    NUM_STALL_CAUSES
+};
+
+/*!
+ * \brief The StallCounters struct is updated by the input module (XIN)
+ * on each clock edge. If an interval is set, the cycles of each cause are
+ * also accumulated by window of interval cycles (time series).
+ */
+struct StallCounters {
+    unsigned short routerId;
+    unsigned short portId;
+    unsigned short vc;                        // Virtual channel (0 w/o VCs)
+    bool virtualChannels;                     // Output held: VC unavailable instead of output busy
+    unsigned long long cycles;                // Cycles sampled
+    unsigned long long headCycles;            // Cycles with a flit at the head of the buffer
+    unsigned long long causes[NUM_STALL_CAUSES];
+    unsigned int interval;                    // Cycles by window (0: no time series)
+    unsigned long long window[NUM_STALL_CAUSES];
+    std::vector<unsigned long long> series;   // NUM_STALL_CAUSES values by window
+
+    /*!
+     * \brief sample It classifies the cycle
+     * \param head A flit at the head of the buffer
+     * \param read The flit is read in the cycle
+     * \param requesting The input controller requests an output
+     * \param granted The output requested granted this input
+     * \param outputIdle The output requested is not held by another packet
+     */
+    inline void sample(bool head, bool read, bool requesting, bool granted, bool outputIdle) {
+        cycles++;
+        if( head ) {
+            headCycles++;
+            if( !read ) {
+                StallCause cause = StallNoCredit;
+                if( !requesting ) {
+                    cause = StallRouting;
+                } else if( !granted ) {
+                    cause = outputIdle ? StallArbitration : (virtualChannels ? StallVcUnavailable : StallOutputBusy);
+                }
+                causes[cause]++;
+                if( interval > 0 ) {
+                    window[cause]++;
+                }
+            }
+        }
+        if( interval > 0 && cycles % interval == 0 ) {
+            series.insert(series.end(),window,window + NUM_STALL_CAUSES);
+            for( unsigned short i = 0; i < NUM_STALL_CAUSES; i++ ) {
+                window[i] = 0;
+            }
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// Activity of a router (events that dissipate dynamic energy)
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The ActivityCounters struct is shared by the components of a
+ * router: the FIFOs count the writes and reads, the input modules (XIN)
+ * count the flits read (crossbar traversals) and the headers read (route
+ * computations) and the programmable priority encoders count the grants
+ * given (arbitrations). The link traversals are the flits of the link
+ * counters of the router output ports.
+ */
+struct ActivityCounters {
+    unsigned short routerId;
+    unsigned long long bufferWrites;
+    unsigned long long bufferReads;
+    unsigned long long crossbarTraversals;
+    unsigned long long arbitrations;
+    unsigned long long routeComputations;
+};
+
+/*!
+ * \brief The EnergyTable struct has the energy by event (pJ) and the
+ * leakage power (mW) of a router, as estimated by a power model (e.g. Orion
+ * or DSENT) for the technology, flit width and buffer depth simulated
+ */
+struct EnergyTable {
+    std::string fileName;   // Empty: no table read (energy not reported)
+    double bufferWrite;
+    double bufferRead;
+    double crossbar;
+    double arbitration;
+    double routing;
+    double link;
+    double leakage;         // mW by router
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// Registry of counters
+/////////////////////////////////////////////////////////////////////////
+// Singleton
+class EXP_DEFINES Instrumentation {
+public:
+    static Instrumentation* instance();
+
+    /*!
+     * \brief linkCounters It registers the counters of a router output port
+     * \return The counters to be updated by the output flow controller
+     */
+    LinkCounters* linkCounters(unsigned short routerId,
+                               unsigned short portId,
+                               unsigned short numVirtualChannels);
+
+    /*!
+     * \brief writeLinkReport It writes the counters of all the links and,
+     * for orthogonal topologies, one utilization matrix (Y rows by X
+     * columns, for each Z layer) by port to be rendered as a heatmap
+     * \param dimensions 1 (non-orthogonal topologies), 2 or 3
+     */
+    void writeLinkReport(FILE* out, unsigned long long cycles, unsigned short dimensions) const;
+
+    const std::vector<LinkCounters*>& linkList() const { return links; }
+
+    /*!
+     * \brief bufferCounters It registers the occupancy counters of a buffer
+     * \return The counters to be updated by the FIFO
+     */
+    BufferCounters* bufferCounters(unsigned short routerId,
+                                   unsigned short portId,
+                                   unsigned short vc,
+                                   bool input,
+                                   unsigned short depth);
+
+    /*!
+     * \brief writeBufferReport It writes the occupancy of all the buffers
+     * (mean, maximum, 99th percentile and fraction of cycles full) by router,
+     * port, direction and virtual channel, followed by their histograms
+     */
+    void writeBufferReport(FILE* out, unsigned short dimensions) const;
+
+    /*!
+     * \brief stallCounters It registers the stall counters of an input port
+     * (virtual channel)
+     * \param interval Cycles by window of the time series (0: no time series)
+     * \return The counters to be updated by the input module
+     */
+    StallCounters* stallCounters(unsigned short routerId,
+                                 unsigned short portId,
+                                 unsigned short vc,
+                                 bool virtualChannels,
+                                 unsigned int interval);
+
+    /*!
+     * \brief writeStallReport It writes the stall cycles by cause of each
+     * input port and virtual channel, followed by the totals by router
+     */
+    void writeStallReport(FILE* out, unsigned short dimensions) const;
+
+    /*!
+     * \brief writeStallSeries It writes the stall cycles by cause of each
+     * window of the time series (only the inputs stalled in the window)
+     */
+    void writeStallSeries(FILE* out) const;
+
+    /*!
+     * \brief activityCounters It gets the activity counters of a router
+     * (registered by the first component that asks for them)
+     * \return The counters to be updated by the components of the router
+     */
+    ActivityCounters* activityCounters(unsigned short routerId);
+
+    /*!
+     * \brief readEnergyTable It reads the energy by event of the file: one
+     * "<event> <value>" by line, events buffer_write, buffer_read, crossbar,
+     * arbitration, routing and link (pJ) and leakage (mW by router); the
+     * events missing are 0 and '#' starts a comment
+     */
+    bool readEnergyTable(const char* fileName);
+
+    /*!
+     * \brief writeActivityReport It writes the events of each router and,
+     * if an energy table was read, their dynamic energy and the average power
+     * \param flitsDelivered Flits received by the terminals (energy by flit)
+     */
+    void writeActivityReport(FILE* out,
+                             unsigned long long cycles,
+                             unsigned long long flitsDelivered,
+                             unsigned short dimensions) const;
+
+private:
+    // Singleton
+    static Instrumentation* registry;
+
+    std::vector<LinkCounters*> links;
+    std::vector<BufferCounters*> buffers;
+    std::vector<StallCounters*> stalls;
+    std::vector<ActivityCounters*> activity;    // By router (NULL: not registered)
+    EnergyTable energy;
+
+    Instrumentation();
+    Instrumentation(const Instrumentation&);
+    Instrumentation& operator= (const Instrumentation&);
+    ~Instrumentation();
+};
+
+#endif // __INSTRUMENTATION_H__
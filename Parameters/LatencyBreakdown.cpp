@@ -0,0 +1,228 @@
+#include "LatencyBreakdown.h"
+#include "Parameters.h"
+
+#include <systemc>
+
+LatencyBreakdown* LatencyBreakdown::breakdown = 0; // Defining and initializing
+
+LatencyBreakdown* LatencyBreakdown::instance() {
+    if( !breakdown ) {
+        breakdown = new LatencyBreakdown();
+    }
+    return breakdown;
+}
+
+LatencyBreakdown::LatencyBreakdown()
+    : enabled(false),
+      slotsBusy(0) {}
+
+/*!
+ * \brief currentCycle Cycle of the current simulation time - the same
+ * of the global clock read by the terminals on the clock edge
+ */
+static uint32_t currentCycle() {
+    return (uint32_t) (sc_core::sc_time_stamp() / sc_core::sc_time(CLK_PERIOD,sc_core::SC_NS) + 0.5);
+}
+
+void LatencyBreakdown::enable() {
+    PacketStamps empty;
+    empty.packetId = 0;
+    empty.busy = false;
+    empty.overflow = false;
+    empty.hopCount = 0;
+    empty.injected = 0;
+    slots.assign(BREAKDOWN_SLOTS,empty);
+    enabled = true;
+}
+
+/*!
+ * \brief LatencyBreakdown::record The record of a packet in the network
+ * (NULL if it is not recorded)
+ */
+LatencyBreakdown::PacketStamps* LatencyBreakdown::record(unsigned long packetId) {
+    PacketStamps& slot = slots[packetId % BREAKDOWN_SLOTS];
+    if( slot.busy && slot.packetId == packetId ) {
+        return &slot;
+    }
+    return NULL;
+}
+
+void LatencyBreakdown::injected(unsigned long packetId, unsigned long long cycle) {
+    if( !enabled ) {
+        return;
+    }
+    PacketStamps& slot = slots[packetId % BREAKDOWN_SLOTS];
+    if( slot.busy ) {
+        slotsBusy++;
+        return;
+    }
+    slot.packetId = packetId;
+    slot.busy = true;
+    slot.overflow = false;
+    slot.hopCount = 0;
+    slot.injected = (uint32_t) cycle;
+}
+
+void LatencyBreakdown::headerArrived(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    if( !enabled ) {
+        return;
+    }
+    PacketStamps* packet = this->record(packetId);
+    if( packet == NULL ) {
+        return;
+    }
+    if( packet->hopCount == BREAKDOWN_MAX_HOPS ) {
+        packet->overflow = true;
+        return;
+    }
+    HopStamps& hop = packet->hops[packet->hopCount++];
+    hop.routerId = routerId;
+    hop.portId = portId;
+    hop.arrived = currentCycle();
+    hop.granted = hop.left = 0;
+}
+
+/*!
+ * \brief LatencyBreakdown::openHop The last hop of the packet in the router
+ * port not left yet (NULL if the packet is not recorded)
+ */
+LatencyBreakdown::HopStamps* LatencyBreakdown::openHop(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    PacketStamps* packet = this->record(packetId);
+    if( packet == NULL ) {
+        return NULL;
+    }
+    for( unsigned int i = packet->hopCount; i > 0; i-- ) {
+        HopStamps& hop = packet->hops[i-1];
+        if( hop.routerId == routerId && hop.portId == portId && hop.left == 0 ) {
+            return &hop;
+        }
+    }
+    return NULL;
+}
+
+void LatencyBreakdown::headerGranted(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    if( !enabled ) {
+        return;
+    }
+    HopStamps* hop = this->openHop(packetId,routerId,portId);
+    if( hop != NULL ) {
+        hop->granted = currentCycle();
+    }
+}
+
+void LatencyBreakdown::trailerLeft(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    if( !enabled ) {
+        return;
+    }
+    HopStamps* hop = this->openHop(packetId,routerId,portId);
+    if( hop != NULL ) {
+        hop->left = currentCycle();
+    }
+}
+
+/*!
+ * \brief span Cycles from a timestamp to a later one (0 if out of order)
+ */
+static inline unsigned long long span(unsigned long long from, unsigned long long to) {
+    return to > from ? to - from : 0;
+}
+
+void LatencyBreakdown::delivered(unsigned long packetId,
+                                 unsigned short source,
+                                 unsigned short destination,
+                                 unsigned long long creationCycle,
+                                 unsigned long long injectionCycle,
+                                 unsigned long long deliveryCycle) {
+    if( !enabled ) {
+        return;
+    }
+
+    FlowBreakdown& flow = flows[std::make_pair(source,destination)]; // Zeroed when inserted
+    flow.packets++;
+    flow.queueCycles += span(creationCycle,injectionCycle);
+    flow.totalCycles += span(creationCycle,deliveryCycle);
+
+    PacketStamps* packet = this->record(packetId);
+    if( packet == NULL ) {
+        return;
+    }
+    packet->busy = false;
+
+    bool complete = !packet->overflow && packet->hopCount > 0;
+    for( unsigned int i = 0; i < packet->hopCount && complete; i++ ) {
+        complete = packet->hops[i].granted > 0;
+    }
+    if( !complete ) {
+        return;
+    }
+
+    const HopStamps& last = packet->hops[packet->hopCount-1];
+    flow.recorded++;
+    flow.hops += packet->hopCount;
+    flow.injectionCycles += span(packet->injected,packet->hops[0].arrived);
+    flow.ejectionCycles += span(last.granted,deliveryCycle);
+    for( unsigned int i = 0; i < packet->hopCount; i++ ) {
+        const HopStamps& hop = packet->hops[i];
+        if( hop.routerId >= routers.size() ) {
+            routers.resize(hop.routerId + 1,RouterBreakdown());
+        }
+        RouterBreakdown& router = routers[hop.routerId];
+        unsigned long long wait = span(hop.arrived,hop.granted);
+        router.headers++;
+        router.waitCycles += wait;
+        if( wait > router.maxWait ) {
+            router.maxWait = wait;
+        }
+        router.holdCycles += span(hop.granted,hop.left > 0 ? hop.left : deliveryCycle);
+        flow.waitCycles += wait;
+        if( i + 1 < packet->hopCount ) {
+            unsigned long long forward = span(hop.granted,packet->hops[i+1].arrived);
+            router.forwards++;
+            router.forwardCycles += forward;
+            flow.forwardCycles += forward;
+        }
+    }
+}
+
+void LatencyBreakdown::writeReport(FILE *out) const {
+
+    unsigned long long packets = 0, recorded = 0;
+    std::map<std::pair<unsigned short,unsigned short>,FlowBreakdown>::const_iterator it;
+    for( it = flows.begin(); it != flows.end(); it++ ) {
+        packets += it->second.packets;
+        recorded += it->second.recorded;
+    }
+
+    fprintf(out,"# Latency breakdown (mean cycles by stage) of the packets delivered\n");
+    fprintf(out,"# Packets: %llu - with all the hops recorded: %llu - injected without a free slot: %llu\n",
+            packets,recorded,slotsBusy);
+    fprintf(out,"# Queue: creation to injection; Inject: to the first router; Wait: header arrival to grant\n"
+                "# (routing and arbitration, all routers); Forward: grant to the arrival at the next router;\n"
+                "# Eject: grant in the last router to the trailer delivered. Queue and Total: mean of all the\n"
+                "# packets, other stages: mean of the packets recorded (for each recorded packet\n"
+                "# Queue + Inject + Wait + Forward + Eject = Total)\n");
+    fprintf(out,"#  Src\t Dst\t   Packets\t  Recorded\t   Hops\t   Queue\t  Inject\t    Wait\t Forward\t   Eject\t   Total\n");
+    for( it = flows.begin(); it != flows.end(); it++ ) {
+        const FlowBreakdown& f = it->second;
+        double n = f.packets > 0 ? (double) f.packets : 1.0;
+        double r = f.recorded > 0 ? (double) f.recorded : 1.0;
+        fprintf(out,"%6u\t%4u\t%10llu\t%10llu\t%7.2f\t%8.2f\t%8.2f\t%8.2f\t%8.2f\t%8.2f\t%8.2f\n",
+                it->first.first,it->first.second,f.packets,f.recorded,f.hops / r,
+                f.queueCycles / n,f.injectionCycles / r,f.waitCycles / r,f.forwardCycles / r,
+                f.ejectionCycles / r,f.totalCycles / n);
+    }
+
+    fprintf(out,"\n# By router - Wait: header arrival to grant; Forward: grant to the arrival at the next router;\n"
+                "# Hold: grant to the trailer departure (packet serialization and credit stalls)\n");
+    fprintf(out,"# Router\t   Headers\t    Wait\tMax wait\t Forward\t    Hold\n");
+    for( unsigned int i = 0; i < routers.size(); i++ ) {
+        const RouterBreakdown& r = routers[i];
+        if( r.headers == 0 ) {
+            continue;
+        }
+        fprintf(out,"%8u\t%10llu\t%8.2f\t%8llu\t%8.2f\t%8.2f\n",i,r.headers,
+                r.waitCycles / (double) r.headers,r.maxWait,
+                r.forwards > 0 ? r.forwardCycles / (double) r.forwards : 0.0,
+                r.holdCycles / (double) r.headers);
+    }
+}
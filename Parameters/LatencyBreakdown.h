@@ -0,0 +1,162 @@
+/*
+--------------------------------------------------------------------------------
+PROJECT: SoCIN_Simulator
+MODULE : No modules - global latency breakdown
+FILE   : LatencyBreakdown.h
+--------------------------------------------------------------------------------
+DESCRIPTION: Timestamps of each packet in the network (injection, header
+arrival and grant and trailer departure in each router) kept in a fixed-size
+side array and aggregated, on delivery, into the latency by stage of each
+flow and of each router
+--------------------------------------------------------------------------------
+AUTHORS: Laboratory of Embedded and Distributed Systems (LEDS - UNIVALI)
+CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
+-------------------------------- Reviews ---------------------------------------
+| Date       - Version - Author                      | Description
+--------------------------------------------------------------------------------
+| 19/10/2026 - 1.0     - SoCIN Simulator team        | Initial implementation
+--------------------------------------------------------------------------------
+*/
+
+#ifndef __LATENCYBREAKDOWN_H__
+#define __LATENCYBREAKDOWN_H__
+
+#include "../export.h"
+
+#include <map>
+#include <vector>
+#include <cstdio>
+#include <stdint.h>
+
+// Singleton instance
+#define LATENCY_BREAKDOWN LatencyBreakdown::instance() // Get the latency breakdown
+
+#define LATENCY_BREAKDOWN_FILENAME "breakdown.out"
+
+#define BREAKDOWN_SLOTS    8192 // Packets in the network recorded at the same time
+#define BREAKDOWN_MAX_HOPS 32   // Routers recorded by packet
+
+/////////////////////////////////////////////////////////////////////////
+/// Latency by stage
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The FlowBreakdown struct accumulates the stages of the packets of
+ * a flow (source-destination pair). For the packets with all the hops
+ * recorded the stages add up to the total latency:
+ * queue (creation to injection) + injection (to the first router) +
+ * wait (header arrival to grant, all routers) + forward (grant to the
+ * arrival at the next router) + ejection (grant in the last router to the
+ * trailer delivered).
+ */
+struct FlowBreakdown {
+    unsigned long long packets;         // Packets delivered
+    unsigned long long recorded;        // Packets with all the hops recorded
+    unsigned long long hops;            // Routers crossed (recorded packets)
+    unsigned long long queueCycles;     // All the packets
+    unsigned long long totalCycles;     // All the packets
+    unsigned long long injectionCycles; // Recorded packets from here
+    unsigned long long waitCycles;
+    unsigned long long forwardCycles;
+    unsigned long long ejectionCycles;
+};
+
+/*!
+ * \brief The RouterBreakdown struct accumulates the headers that crossed
+ * a router: wait (arrival to grant - routing and arbitration), forward
+ * (grant to the arrival at the next router - switch traversal, output
+ * buffer and link) and hold (grant to the trailer departure - serialization
+ * of the packet and credit stalls).
+ */
+struct RouterBreakdown {
+    unsigned long long headers;
+    unsigned long long waitCycles;
+    unsigned long long maxWait;
+    unsigned long long forwards;        // Headers forwarded to another router
+    unsigned long long forwardCycles;
+    unsigned long long holdCycles;
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// Latency breakdown
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The LatencyBreakdown class records the timestamps of the packets
+ * from the injection (source queue) until the delivery (traffic meter).
+ * The record of a packet is the slot (packetId % BREAKDOWN_SLOTS) of a
+ * fixed-size array, claimed on the injection and released on the delivery;
+ * if the slot is taken by another packet still in the network, or the
+ * packet crosses more than BREAKDOWN_MAX_HOPS routers, only its queue and
+ * total latency are accounted.
+ *
+ * The routers report the events from the input buffers (FIFO), so ports
+ * without input buffer are not recorded.
+ */
+// Singleton
+class EXP_DEFINES LatencyBreakdown {
+public:
+    static LatencyBreakdown* instance();
+
+    /*!
+     * \brief enable It allocates the records (before the network is built)
+     */
+    void enable();
+    bool isEnabled() const { return enabled; }
+
+    void injected(unsigned long packetId, unsigned long long cycle);
+    void headerArrived(unsigned long packetId, unsigned short routerId, unsigned short portId);
+    void headerGranted(unsigned long packetId, unsigned short routerId, unsigned short portId);
+    void trailerLeft(unsigned long packetId, unsigned short routerId, unsigned short portId);
+
+    /*!
+     * \brief delivered It accumulates the stages of the packet and releases its record
+     */
+    void delivered(unsigned long packetId,
+                   unsigned short source,
+                   unsigned short destination,
+                   unsigned long long creationCycle,
+                   unsigned long long injectionCycle,
+                   unsigned long long deliveryCycle);
+
+    /*!
+     * \brief writeReport It writes the mean latency by stage of each flow
+     * and of each router
+     */
+    void writeReport(FILE* out) const;
+
+private:
+    struct HopStamps {
+        uint16_t routerId;
+        uint16_t portId;
+        uint32_t arrived;
+        uint32_t granted;               // 0: not granted yet
+        uint32_t left;                  // 0: trailer not left yet
+    };
+
+    struct PacketStamps {
+        unsigned long packetId;
+        bool busy;                      // Packet in the network
+        bool overflow;                  // More hops than recorded
+        uint8_t hopCount;
+        uint32_t injected;
+        HopStamps hops[BREAKDOWN_MAX_HOPS];
+    };
+
+    // Singleton
+    static LatencyBreakdown* breakdown;
+
+    bool enabled;
+    std::vector<PacketStamps> slots;
+    std::map<std::pair<unsigned short,unsigned short>,FlowBreakdown> flows;
+    std::vector<RouterBreakdown> routers;
+    unsigned long long slotsBusy;       // Packets not recorded (slot taken)
+
+    LatencyBreakdown();
+    LatencyBreakdown(const LatencyBreakdown&);
+    LatencyBreakdown& operator= (const LatencyBreakdown&);
+    ~LatencyBreakdown() {}
+
+    PacketStamps* record(unsigned long packetId);
+    HopStamps* openHop(unsigned long packetId, unsigned short routerId, unsigned short portId);
+};
+
+#endif // __LATENCYBREAKDOWN_H__
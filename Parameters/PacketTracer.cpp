@@ -0,0 +1,240 @@
+#include "PacketTracer.h"
+#include "Parameters.h"
+
+#include <systemc>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define TRACE_BUFFER_SIZE (1 << 20) // Bytes buffered before writing in the file
+
+PacketTracer* PacketTracer::tracer = 0; // Defining and initializing
+
+PacketTracer* PacketTracer::instance() {
+    if( !tracer ) {
+        tracer = new PacketTracer();
+    }
+    return tracer;
+}
+
+PacketTracer::PacketTracer()
+    : out(NULL),
+      sampling(0),
+      traced(0),
+      firstEvent(true) {}
+
+PacketTracer::~PacketTracer() {
+    this->close();
+}
+
+/*!
+ * \brief currentCycle Cycle of the current simulation time - the same
+ * of the global clock read by the terminals on the clock edge
+ */
+static unsigned long long currentCycle() {
+    return (unsigned long long) (sc_core::sc_time_stamp() / sc_core::sc_time(CLK_PERIOD,sc_core::SC_NS) + 0.5);
+}
+
+bool PacketTracer::open(const char *fileName, unsigned int sampling, const char *flows) {
+
+    if( (out = fopen(fileName,"wt")) == NULL ) {
+        printf("\n[PacketTracer] ERROR: It is not possible to open the file \"%s\" to write the trace.",fileName);
+        return false;
+    }
+    setvbuf(out,NULL,_IOFBF,TRACE_BUFFER_SIZE);
+
+    this->sampling = sampling;
+    this->flows.clear();
+    if( flows != NULL ) { // "source:destination" separated by comma
+        std::string list(flows);
+        size_t begin = 0;
+        while( begin < list.size() ) {
+            size_t end = list.find(',',begin);
+            if( end == std::string::npos ) {
+                end = list.size();
+            }
+            std::string flow = list.substr(begin,end-begin);
+            size_t colon = flow.find(':');
+            if( colon == std::string::npos ) {
+                printf("\n[PacketTracer] WARNING: Flow \"%s\" ignored - expected source:destination",flow.c_str());
+            } else {
+                std::string source = flow.substr(0,colon);
+                std::string destination = flow.substr(colon+1);
+                FlowFilter filter;
+                filter.source = source == "*" ? -1 : atoi(source.c_str());
+                filter.destination = destination == "*" ? -1 : atoi(destination.c_str());
+                this->flows.push_back(filter);
+            }
+            begin = end + 1;
+        }
+    }
+
+    firstEvent = true;
+    fprintf(out,"{\"displayTimeUnit\":\"ns\",\"otherData\":{\"simulator\":\"SNoCS\",\"time_unit\":\"clock cycle\"},\n"
+                "\"traceEvents\":[\n");
+    return true;
+}
+
+void PacketTracer::close() {
+    if( out == NULL ) {
+        return;
+    }
+    std::map<unsigned long,TracedPacket>::const_iterator it;
+    for( it = packets.begin(); it != packets.end(); it++ ) {
+        this->writePacket(it->first,it->second,0);
+    }
+    packets.clear();
+    fprintf(out,"\n]}\n");
+    fclose(out);
+    out = NULL;
+}
+
+bool PacketTracer::sample(unsigned long packetId,
+                          unsigned short source,
+                          unsigned short destination,
+                          unsigned long long creationCycle) {
+
+    bool selected = sampling > 0 && packetId % sampling == 0;
+    for( unsigned int i = 0; i < flows.size() && !selected; i++ ) {
+        selected = (flows[i].source < 0 || flows[i].source == source)
+                && (flows[i].destination < 0 || flows[i].destination == destination);
+    }
+    if( !selected ) {
+        return false;
+    }
+
+    TracedPacket& packet = packets[packetId];
+    packet.source = source;
+    packet.destination = destination;
+    packet.created = creationCycle;
+    packet.injected = 0;
+    traced++;
+    return true;
+}
+
+void PacketTracer::injected(unsigned long packetId, unsigned long long cycle) {
+    std::map<unsigned long,TracedPacket>::iterator it = packets.find(packetId);
+    if( it != packets.end() ) {
+        it->second.injected = cycle;
+    }
+}
+
+void PacketTracer::headerArrived(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    std::map<unsigned long,TracedPacket>::iterator it = packets.find(packetId);
+    if( it != packets.end() ) {
+        Hop hop;
+        hop.routerId = routerId;
+        hop.portId = portId;
+        hop.arrived = currentCycle();
+        hop.granted = hop.left = 0;
+        it->second.hops.push_back(hop);
+    }
+}
+
+/*!
+ * \brief PacketTracer::openHop The last hop of the packet in the router port
+ * not left yet (NULL if the packet is not traced)
+ */
+PacketTracer::Hop* PacketTracer::openHop(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    std::map<unsigned long,TracedPacket>::iterator it = packets.find(packetId);
+    if( it == packets.end() ) {
+        return NULL;
+    }
+    std::vector<Hop>& hops = it->second.hops;
+    for( size_t i = hops.size(); i > 0; i-- ) {
+        if( hops[i-1].routerId == routerId && hops[i-1].portId == portId && hops[i-1].left == 0 ) {
+            return &hops[i-1];
+        }
+    }
+    return NULL;
+}
+
+void PacketTracer::headerGranted(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    Hop* hop = this->openHop(packetId,routerId,portId);
+    if( hop != NULL ) {
+        hop->granted = currentCycle();
+    }
+}
+
+void PacketTracer::trailerLeft(unsigned long packetId, unsigned short routerId, unsigned short portId) {
+    Hop* hop = this->openHop(packetId,routerId,portId);
+    if( hop != NULL ) {
+        hop->left = currentCycle();
+    }
+}
+
+void PacketTracer::delivered(unsigned long packetId, unsigned long long cycle) {
+    std::map<unsigned long,TracedPacket>::iterator it = packets.find(packetId);
+    if( it != packets.end() ) {
+        this->writePacket(it->first,it->second,cycle);
+        packets.erase(it);
+    }
+}
+
+void PacketTracer::writeEvent(const char *format, ...) {
+    if( !firstEvent ) {
+        fputs(",\n",out);
+    }
+    firstEvent = false;
+    va_list args;
+    va_start(args,format);
+    vfprintf(out,format,args);
+    va_end(args);
+}
+
+/*!
+ * \brief PacketTracer::writePacket It writes the events of a packet
+ * \param delivered Cycle of delivery (0: not delivered until the end of simulation)
+ */
+void PacketTracer::writePacket(unsigned long packetId, const TracedPacket& packet, unsigned long long delivered) {
+
+    writeEvent("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%lu,\"args\":{\"name\":\"Packet %lu (%u -> %u)\"}}",
+               packetId,packetId,packet.source,packet.destination);
+    writeEvent("{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%lu,\"args\":{\"sort_index\":%lu}}",
+               packetId,packetId);
+    writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%lu,\"tid\":0,\"args\":{\"name\":\"Terminal %u\"}}",
+               packetId,packet.source);
+
+    // Terminal track: source queue and network
+    unsigned long long last = packet.created;
+    if( packet.injected > 0 ) {
+        writeEvent("{\"name\":\"Source queue\",\"ph\":\"X\",\"pid\":%lu,\"tid\":0,\"ts\":%llu,\"dur\":%llu}",
+                   packetId,packet.created,packet.injected > packet.created ? packet.injected - packet.created : 0);
+        last = packet.injected;
+        if( delivered > 0 ) {
+            writeEvent("{\"name\":\"Network\",\"ph\":\"X\",\"pid\":%lu,\"tid\":0,\"ts\":%llu,\"dur\":%llu,"
+                       "\"args\":{\"hops\":%u}}",
+                       packetId,packet.injected,delivered > packet.injected ? delivered - packet.injected : 0,
+                       (unsigned int) packet.hops.size());
+        }
+    }
+
+    // One track by router crossed
+    for( unsigned int i = 0; i < packet.hops.size(); i++ ) {
+        const Hop& hop = packet.hops[i];
+        unsigned long long granted = hop.granted > 0 ? hop.granted : hop.arrived;
+        unsigned long long left = hop.left > 0 ? hop.left : (delivered > 0 ? delivered : granted);
+        writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%lu,\"tid\":%u,\"args\":{\"name\":\"Hop %u\"}}",
+                   packetId,i+1,i+1);
+        writeEvent("{\"name\":\"Router %u\",\"ph\":\"X\",\"pid\":%lu,\"tid\":%u,\"ts\":%llu,\"dur\":%llu,"
+                   "\"args\":{\"router\":%u,\"input_port\":%u,\"granted\":%s}}",
+                   hop.routerId,packetId,i+1,hop.arrived,left > hop.arrived ? left - hop.arrived : 0,
+                   hop.routerId,hop.portId,hop.granted > 0 ? "true" : "false");
+        if( granted > hop.arrived ) {
+            writeEvent("{\"name\":\"Waiting grant\",\"ph\":\"X\",\"pid\":%lu,\"tid\":%u,\"ts\":%llu,\"dur\":%llu}",
+                       packetId,i+1,hop.arrived,granted - hop.arrived);
+        }
+        if( left > last ) {
+            last = left;
+        }
+    }
+
+    if( delivered > 0 ) {
+        writeEvent("{\"name\":\"Delivered\",\"ph\":\"i\",\"s\":\"p\",\"pid\":%lu,\"tid\":0,\"ts\":%llu}",
+                   packetId,delivered);
+    } else {
+        writeEvent("{\"name\":\"Not delivered\",\"ph\":\"i\",\"s\":\"p\",\"pid\":%lu,\"tid\":0,\"ts\":%llu}",
+                   packetId,last);
+    }
+}
@@ -0,0 +1,126 @@
+/*
+--------------------------------------------------------------------------------
+PROJECT: SoCIN_Simulator
+MODULE : No modules - global packet tracer
+FILE   : PacketTracer.h
+--------------------------------------------------------------------------------
+DESCRIPTION: Lifecycle of a sample of the packets (creation, injection, each
+router crossed and delivery) written as Chrome trace events (JSON), to be
+opened in chrome://tracing or ui.perfetto.dev
+--------------------------------------------------------------------------------
+AUTHORS: Laboratory of Embedded and Distributed Systems (LEDS - UNIVALI)
+CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
+-------------------------------- Reviews ---------------------------------------
+| Date       - Version - Author                      | Description
+--------------------------------------------------------------------------------
+| 19/10/2026 - 1.0     - SoCIN Simulator team        | Initial implementation
+--------------------------------------------------------------------------------
+*/
+
+#ifndef __PACKETTRACER_H__
+#define __PACKETTRACER_H__
+
+#include "../export.h"
+
+#include <map>
+#include <vector>
+#include <cstdio>
+
+// Singleton instance
+#define PACKET_TRACER PacketTracer::instance() // Get the packet tracer
+
+#define PACKET_TRACER_FILENAME "packettrace.json"
+
+/////////////////////////////////////////////////////////////////////////
+/// Packet tracer
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The PacketTracer class records the events of the sampled packets
+ * (Packet::traced): created, injected, header arrived at a router input
+ * port, header granted (read from the input buffer to the output port),
+ * trailer left the router and delivered. The events of a packet are kept
+ * until its delivery and then written in the trace: one process by packet,
+ * with a track for the terminal (source queue and network) and one by
+ * router crossed. The time unit of the trace is the clock cycle.
+ *
+ * The routers report the events from the input buffers (FIFO), so ports
+ * without input buffer are not traced.
+ */
+// Singleton
+class EXP_DEFINES PacketTracer {
+public:
+    static PacketTracer* instance();
+
+    /*!
+     * \brief open It creates the trace file
+     * \param sampling One of each sampling packets is traced (0: none)
+     * \param flows Flows traced "source:destination,..." - '*' matches any terminal (NULL: none)
+     */
+    bool open(const char* fileName, unsigned int sampling, const char* flows);
+
+    /*!
+     * \brief close It writes the packets not delivered and closes the trace
+     */
+    void close();
+
+    bool isOpen() const { return out != NULL; }
+    unsigned long long tracedPackets() const { return traced; }
+
+    /*!
+     * \brief sample It decides if a new packet is traced and records its creation
+     * \return true if the packet is traced
+     */
+    bool sample(unsigned long packetId,
+                unsigned short source,
+                unsigned short destination,
+                unsigned long long creationCycle);
+
+    void injected(unsigned long packetId, unsigned long long cycle);
+    void headerArrived(unsigned long packetId, unsigned short routerId, unsigned short portId);
+    void headerGranted(unsigned long packetId, unsigned short routerId, unsigned short portId);
+    void trailerLeft(unsigned long packetId, unsigned short routerId, unsigned short portId);
+    void delivered(unsigned long packetId, unsigned long long cycle);
+
+private:
+    struct Hop {
+        unsigned short routerId;
+        unsigned short portId;
+        unsigned long long arrived;
+        unsigned long long granted;
+        unsigned long long left;
+    };
+
+    struct TracedPacket {
+        unsigned short source;
+        unsigned short destination;
+        unsigned long long created;
+        unsigned long long injected;    // 0: still in the source queue
+        std::vector<Hop> hops;
+    };
+
+    struct FlowFilter {
+        int source;                     // -1: any
+        int destination;                // -1: any
+    };
+
+    // Singleton
+    static PacketTracer* tracer;
+
+    FILE* out;
+    unsigned int sampling;
+    std::vector<FlowFilter> flows;
+    std::map<unsigned long,TracedPacket> packets;  // Packets in flight
+    unsigned long long traced;
+    bool firstEvent;
+
+    PacketTracer();
+    PacketTracer(const PacketTracer&);
+    PacketTracer& operator= (const PacketTracer&);
+    ~PacketTracer();
+
+    Hop* openHop(unsigned long packetId, unsigned short routerId, unsigned short portId);
+    void writePacket(unsigned long packetId, const TracedPacket& packet, unsigned long long delivered);
+    void writeEvent(const char* format, ...);
+};
+
+#endif // __PACKETTRACER_H__
@@ -15,6 +15,35 @@ Parameters::Parameters() {
     pluginsDir = const_cast<char*>("./plugins");
     confFile = const_cast<char*>("simconf.conf");
     seed = 0;
+    replayFile = 0;
+    replayTimeScale = 1;
+    flowWeighting = 0;
+    closedLoop = false;
+    replyLength = 4;
+    serviceDelay = 0;
+    maxOutstanding = 4;
+    taskGraphFile = 0;
+    phaseFile = 0;
+    calendarInjection = false;
+    binaryPacketLog = false;
+    packetLogging = true;
+    latencyStatistics = false;
+    linkCounters = false;
+    bufferOccupancy = false;
+    asyncLog = true;
+    telemetryInterval = 0;
+    tracerSampling = 0;
+    tracerFlows = 0;
+    traceStart = 0;
+    traceStop = 0;
+    traceRouters = 0;
+    traceInternal = false;
+    latencyStages = false;
+    stallCounters = false;
+    stallInterval = 0;
+    activityCounters = false;
+    energyFile = 0;
+    timeSeriesInterval = 0;
 
     // Network info
     numElements = 16;
@@ -45,6 +74,35 @@ Parameters::Parameters(const Parameters &c) {
     this->pluginsDir = c.pluginsDir;
     this->confFile = c.confFile;
     this->seed = c.seed;
+    this->replayFile = c.replayFile;
+    this->replayTimeScale = c.replayTimeScale;
+    this->flowWeighting = c.flowWeighting;
+    this->closedLoop = c.closedLoop;
+    this->replyLength = c.replyLength;
+    this->serviceDelay = c.serviceDelay;
+    this->maxOutstanding = c.maxOutstanding;
+    this->taskGraphFile = c.taskGraphFile;
+    this->phaseFile = c.phaseFile;
+    this->calendarInjection = c.calendarInjection;
+    this->binaryPacketLog = c.binaryPacketLog;
+    this->packetLogging = c.packetLogging;
+    this->latencyStatistics = c.latencyStatistics;
+    this->linkCounters = c.linkCounters;
+    this->bufferOccupancy = c.bufferOccupancy;
+    this->asyncLog = c.asyncLog;
+    this->telemetryInterval = c.telemetryInterval;
+    this->tracerSampling = c.tracerSampling;
+    this->tracerFlows = c.tracerFlows;
+    this->traceStart = c.traceStart;
+    this->traceStop = c.traceStop;
+    this->traceRouters = c.traceRouters;
+    this->traceInternal = c.traceInternal;
+    this->latencyStages = c.latencyStages;
+    this->stallCounters = c.stallCounters;
+    this->stallInterval = c.stallInterval;
+    this->activityCounters = c.activityCounters;
+    this->energyFile = c.energyFile;
+    this->timeSeriesInterval = c.timeSeriesInterval;
 
     this->numElements = c.numElements;
     this->xSize = c.xSize;
@@ -73,6 +131,35 @@ Parameters& Parameters::operator = (const Parameters& c) {
     this->pluginsDir = c.pluginsDir;
     this->confFile = c.confFile;
     this->seed = c.seed;
+    this->replayFile = c.replayFile;
+    this->replayTimeScale = c.replayTimeScale;
+    this->flowWeighting = c.flowWeighting;
+    this->closedLoop = c.closedLoop;
+    this->replyLength = c.replyLength;
+    this->serviceDelay = c.serviceDelay;
+    this->maxOutstanding = c.maxOutstanding;
+    this->taskGraphFile = c.taskGraphFile;
+    this->phaseFile = c.phaseFile;
+    this->calendarInjection = c.calendarInjection;
+    this->binaryPacketLog = c.binaryPacketLog;
+    this->packetLogging = c.packetLogging;
+    this->latencyStatistics = c.latencyStatistics;
+    this->linkCounters = c.linkCounters;
+    this->bufferOccupancy = c.bufferOccupancy;
+    this->asyncLog = c.asyncLog;
+    this->telemetryInterval = c.telemetryInterval;
+    this->tracerSampling = c.tracerSampling;
+    this->tracerFlows = c.tracerFlows;
+    this->traceStart = c.traceStart;
+    this->traceStop = c.traceStop;
+    this->traceRouters = c.traceRouters;
+    this->traceInternal = c.traceInternal;
+    this->latencyStages = c.latencyStages;
+    this->stallCounters = c.stallCounters;
+    this->stallInterval = c.stallInterval;
+    this->activityCounters = c.activityCounters;
+    this->energyFile = c.energyFile;
+    this->timeSeriesInterval = c.timeSeriesInterval;
 
     this->numElements = c.numElements;
     this->xSize = c.xSize;
@@ -35,6 +35,35 @@ class PluginManager;
 #define PLUGINS_DIR PARAMS->pluginsDir      // Plugins folder
 #define CONF_FILE PARAMS->confFile          // File with simulator definitions
 #define SEED PARAMS->seed                   // Seed for the pseudo-random number generator on the Flow Generator
+#define REPLAY_FILE PARAMS->replayFile      // Binary packet trace to be replayed by the Flow Generators (NULL: traffic.tcf flows)
+#define REPLAY_TIME_SCALE PARAMS->replayTimeScale // Factor applied to the injection cycles of the replayed trace
+#define FLOW_WEIGHTING PARAMS->flowWeighting // Flow selection on the Flow Generator (0: uniform, 1: weighted by the required bandwidth)
+#define CLOSED_LOOP PARAMS->closedLoop       // Request/reply traffic - the Flow Generators reply the requests received
+#define REPLY_LENGTH PARAMS->replyLength     // Payload length (flits including the trailer) of the replies
+#define SERVICE_DELAY PARAMS->serviceDelay   // Cycles from the request arrival until the reply injection
+#define MAX_OUTSTANDING PARAMS->maxOutstanding // Maximum number of requests of a flow waiting for the reply
+#define TASK_GRAPH_FILE PARAMS->taskGraphFile  // Application task graph that drives the Flow Generators (NULL: traffic.tcf flows)
+#define PHASE_FILE PARAMS->phaseFile           // Schedule of traffic phases, each one with its traffic file (NULL: traffic.tcf flows)
+#define CALENDAR_INJECTION PARAMS->calendarInjection // Open-loop injection of all the terminals driven by a single scheduler (calendar queue)
+#define BINARY_PACKET_LOG PARAMS->binaryPacketLog // Traffic meters log the packets in a single binary file instead of one text file each
+#define PACKET_LOGGING PARAMS->packetLogging   // Traffic meters log each packet delivered (text or binary)
+#define LATENCY_STATISTICS PARAMS->latencyStatistics // Streaming latency histograms of the packets delivered (latency.out)
+#define LINK_COUNTERS PARAMS->linkCounters     // Flits, busy and stall cycles of each router output port (links.out)
+#define BUFFER_OCCUPANCY PARAMS->bufferOccupancy // Time-weighted occupancy of each router FIFO (buffers.out)
+#define ASYNC_LOG PARAMS->asyncLog             // Logs written during the simulation by a writer thread (LogWriter)
+#define TELEMETRY_INTERVAL PARAMS->telemetryInterval // Cycles between the updates of the live telemetry file (0: no telemetry)
+#define TRACER_SAMPLING PARAMS->tracerSampling // One of each N packets traced by the packet tracer (0: no sampling)
+#define TRACER_FLOWS PARAMS->tracerFlows       // Flows traced by the packet tracer "source:destination,..." (NULL: none)
+#define TRACE_START PARAMS->traceStart         // First cycle written in the waveform
+#define TRACE_STOP PARAMS->traceStop           // Last cycle written in the waveform (0: until the end of simulation)
+#define TRACE_ROUTERS PARAMS->traceRouters     // Routers traced in the waveform "0-3,7" (NULL: all)
+#define TRACE_INTERNAL PARAMS->traceInternal   // Internal signals of the routers traced in the waveform
+#define LATENCY_STAGES PARAMS->latencyStages   // Latency breakdown by stage of each flow and router (breakdown.out)
+#define STALL_COUNTERS PARAMS->stallCounters   // Stall cycles by cause of each router input (stalls.out)
+#define STALL_INTERVAL PARAMS->stallInterval   // Cycles by window of the stall time series (0: no time series)
+#define ACTIVITY_COUNTERS PARAMS->activityCounters // Events of each router (buffer, crossbar, arbitration, routing, link) and energy (energy.out)
+#define ENERGY_FILE PARAMS->energyFile         // Energy by event of the routers (NULL: only the events reported)
+#define TIME_SERIES_INTERVAL PARAMS->timeSeriesInterval // Cycles by window of the traffic time series (0: no time series)
 // Network info
 #define NUM_ELEMENTS PARAMS->numElements    // Number of elements in the network
 #define X_SIZE PARAMS->xSize                // Network X dimension
@@ -132,6 +161,35 @@ public:
     char* pluginsDir;
     char* confFile;
     unsigned int seed; // For the PRNG on Flow Generator
+    char* replayFile;       // Packet trace to replay instead of the traffic file flows
+    float replayTimeScale;  // Time scaling of the trace injection cycles
+    unsigned short flowWeighting; // Weight of the flows when the Flow Generator chooses the next packet
+    bool closedLoop;             // Request/reply traffic
+    unsigned int replyLength;    // Number of flits in the reply payload
+    unsigned int serviceDelay;   // Cycles to serve a request
+    unsigned int maxOutstanding; // Outstanding requests per flow
+    char* taskGraphFile;         // Application task graph instead of the traffic file flows
+    char* phaseFile;             // Phase schedule instead of a single traffic file
+    bool calendarInjection;      // Centralized injection scheduler instead of one thread per Flow Generator
+    bool binaryPacketLog;        // Binary packet log (packetlog.bin) instead of the text files ext_*_out
+    bool packetLogging;          // Log of each packet delivered
+    bool latencyStatistics;      // Latency histograms by class, flow and source-destination pair
+    bool linkCounters;           // Counters of the router output ports (links)
+    bool bufferOccupancy;        // Occupancy histograms of the router buffers
+    bool asyncLog;               // Log writes in a background thread
+    unsigned int telemetryInterval; // Live telemetry update interval (cycles)
+    unsigned int tracerSampling; // Packet lifecycle tracing of one of each N packets
+    char* tracerFlows;           // Packet lifecycle tracing of the packets of some flows
+    unsigned long long traceStart; // Window of cycles of the waveform
+    unsigned long long traceStop;
+    char* traceRouters;          // Routers traced in the waveform
+    bool traceInternal;          // Internal signals of the routers in the waveform
+    bool latencyStages;          // Timestamps of the packets in each router aggregated by stage
+    bool stallCounters;          // Stall cycles by cause of the router inputs
+    unsigned int stallInterval;  // Stall time series window (cycles)
+    bool activityCounters;       // Activity counters of the routers for energy estimation
+    char* energyFile;            // Energy table (energy by event) of the routers
+    unsigned int timeSeriesInterval; // Traffic time series window (cycles)
     // Network info
     unsigned short numElements;
     unsigned short xSize;
@@ -182,8 +240,6 @@ public:
 //#define DEBUG_IFC
 //#define DEBUG_OFC
 //#define DEBUG_PARIS
-//#define WAVEFORM_PARIS
 //#define DEBUG_SOCIN
-//#define WAVEFORM_SOCIN
 
 #endif // PARAMETERS_H
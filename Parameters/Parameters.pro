@@ -9,10 +9,25 @@ include(../plugin.pri)
 
 DEFINES += GLOBAL_DEF
 
+# Waveform compressed with zlib (switch in common.pri)
+waveform_zlib {
+    DEFINES += WAVEFORM_ZLIB
+    LIBS += -lz
+}
+
 TARGET = parameters
 
 HEADERS += Parameters.h \
+    RandomStream.h \
+    Instrumentation.h \
+    PacketTracer.h \
+    Waveform.h \
+    LatencyBreakdown.h \
     ../PluginManager/PluginManager.h
 
 SOURCES += Parameters.cpp \
+    Instrumentation.cpp \
+    PacketTracer.cpp \
+    Waveform.cpp \
+    LatencyBreakdown.cpp \
     ../PluginManager/PluginManager.cpp
@@ -0,0 +1,173 @@
+/*
+--------------------------------------------------------------------------------
+PROJECT: SoCIN_Simulator
+MODULE : No modules - random number generation
+FILE   : RandomStream.h
+--------------------------------------------------------------------------------
+DESCRIPTION: Counter-based pseudo-random number streams (Philox4x32-10) used
+by all the stochastic components of the simulator
+--------------------------------------------------------------------------------
+AUTHORS: Laboratory of Embedded and Distributed Systems (LEDS - UNIVALI)
+CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
+-------------------------------- Reviews ---------------------------------------
+| Date       - Version - Author                      | Description
+--------------------------------------------------------------------------------
+| 19/10/2026 - 1.0     - LEDS                        | Initial implementation
+--------------------------------------------------------------------------------
+*/
+
+#ifndef __RANDOMSTREAM_H__
+#define __RANDOMSTREAM_H__
+
+#include <stdint.h>
+#include <cstddef>
+
+/////////////////////////////////////////////////////////////////////////
+/// Streams - each use of random numbers in a component has its own stream
+/////////////////////////////////////////////////////////////////////////
+#define RNG_STREAM_FLOW_SELECTION 0 // Flow Generator: choice of the flow of the next packet
+#define RNG_STREAM_INJECTION      1 // Flow Generator: injection process of a flow (substream: flow index)
+#define RNG_STREAM_DESTINATION    2 // Destination Generator: destination of the packets
+#define RNG_STREAM_PRIORITY       3 // Priority Generator: random priorities (component: router and port)
+#define RNG_STREAM_PACKET_SIZE    4 // Flow Generator: payload length of a flow (substream: flow index)
+
+#define RNG_BUFFER_SIZE 16          // Numbers generated at once (4 Philox blocks)
+
+/*!
+ * \brief The RandomStream class is a counter-based pseudo-random number
+ * generator (Philox4x32-10, Salmon et al., SC'11).
+ *
+ * A stream is fully determined by the simulation seed, the component
+ * identifier, the stream and the substream. Thus, the numbers drawn by a
+ * component do not depend on the elaboration order nor on how many numbers
+ * other components draw, and no state is shared between components.
+ *
+ * The generator satisfies the UniformRandomBitGenerator requirements, but
+ * the helpers uniform() and uniformInt() should be preferred to the
+ * std:: distributions, whose algorithms are implementation-defined.
+ */
+class RandomStream {
+public:
+    typedef uint32_t result_type;
+
+    RandomStream() { this->setStream(0,0,0,0); }
+
+    RandomStream(unsigned int seed, unsigned int component,
+                 unsigned int stream, unsigned int substream = 0)
+    { this->setStream(seed,component,stream,substream); }
+
+    /*!
+     * \brief setStream It restarts the generator on the first number of a stream
+     */
+    void setStream(unsigned int seed, unsigned int component,
+                   unsigned int stream, unsigned int substream = 0) {
+        key[0] = seed;
+        key[1] = component;
+        counter[0] = 0;
+        counter[1] = 0;
+        counter[2] = stream;
+        counter[3] = substream;
+        position = RNG_BUFFER_SIZE;
+    }
+
+    static result_type min() { return 0; }
+    static result_type max() { return 0xFFFFFFFFu; }
+
+    inline result_type operator()() {
+        if( position == RNG_BUFFER_SIZE ) {
+            this->refill();
+        }
+        return buffer[position++];
+    }
+
+    /*!
+     * \brief fill Bulk generation of numbers
+     */
+    void fill(result_type* out, size_t n) {
+        for( size_t i = 0; i < n; i++ ) {
+            out[i] = (*this)();
+        }
+    }
+
+    /*!
+     * \brief uniform Real number uniformly distributed in [0,1) - 53-bit resolution
+     */
+    inline double uniform() {
+        uint64_t hi = (*this)() >> 5;
+        uint64_t lo = (*this)() >> 6;
+        return (double) ((hi << 26) | lo) * (1.0 / 9007199254740992.0);
+    }
+
+    /*!
+     * \brief uniformInt Integer uniformly distributed in [0,n) - unbiased
+     * multiply-shift with rejection (Lemire, 2019)
+     */
+    inline unsigned int uniformInt(unsigned int n) {
+        uint64_t m = (uint64_t) (*this)() * n;
+        uint32_t low = (uint32_t) m;
+        if( low < n ) {
+            uint32_t threshold = (uint32_t) (-n) % n;
+            while( low < threshold ) {
+                m = (uint64_t) (*this)() * n;
+                low = (uint32_t) m;
+            }
+        }
+        return (unsigned int) (m >> 32);
+    }
+
+    /*!
+     * \brief uniformInt64 Integer uniformly distributed in [0,n) for large ranges
+     */
+    inline unsigned long long uniformInt64(unsigned long long n) {
+        if( n <= 0xFFFFFFFFull ) {
+            return this->uniformInt((unsigned int) n);
+        }
+        unsigned long long limit = ~0ull - (~0ull % n); // Reject the incomplete last interval
+        unsigned long long value;
+        do {
+            value = ((unsigned long long) (*this)() << 32) | (*this)();
+        } while( value >= limit );
+        return value % n;
+    }
+
+private:
+    uint32_t key[2];        // Seed and component
+    uint32_t counter[4];    // Block index (64 bits), stream and substream
+    result_type buffer[RNG_BUFFER_SIZE];
+    unsigned int position;  // Next number in the buffer
+
+    static inline uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t& hi) {
+        uint64_t product = (uint64_t) a * b;
+        hi = (uint32_t) (product >> 32);
+        return (uint32_t) product;
+    }
+
+    void refill() {
+        for( unsigned int block = 0; block < RNG_BUFFER_SIZE; block += 4 ) {
+            uint32_t x[4] = {counter[0], counter[1], counter[2], counter[3]};
+            uint32_t k[2] = {key[0], key[1]};
+            for( unsigned int round = 0; round < 10; round++ ) {
+                uint32_t hi0, hi1;
+                uint32_t lo0 = mulhilo(0xD2511F53u, x[0], hi0);
+                uint32_t lo1 = mulhilo(0xCD9E8D57u, x[2], hi1);
+                x[0] = hi1 ^ x[1] ^ k[0];
+                x[1] = lo1;
+                x[2] = hi0 ^ x[3] ^ k[1];
+                x[3] = lo0;
+                k[0] += 0x9E3779B9u;
+                k[1] += 0xBB67AE85u;
+            }
+            buffer[block]   = x[0];
+            buffer[block+1] = x[1];
+            buffer[block+2] = x[2];
+            buffer[block+3] = x[3];
+            // Next block of the stream
+            if( ++counter[0] == 0 ) {
+                ++counter[1];
+            }
+        }
+        position = 0;
+    }
+};
+
+#endif // __RANDOMSTREAM_H__
@@ -0,0 +1,222 @@
+#include "Waveform.h"
+#include "Parameters.h"
+
+#include <map>
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <cstdarg>
+#include <cstdlib>
+
+#ifdef WAVEFORM_ZLIB
+#include <zlib.h>
+#endif
+
+#define WAVEFORM_LINE_LENGTH 1024 // Longest line formatted (declaration or value)
+#define WAVEFORM_CLOCK_CODE  "!"  // Identifier of the clock (first identifier)
+
+Waveform* Waveform::waveform = 0; // Defining and initializing
+
+Waveform* Waveform::instance() {
+    if( !waveform ) {
+        waveform = new Waveform();
+    }
+    return waveform;
+}
+
+Waveform::Waveform()
+    : out(NULL),
+      start(0),
+      stop(0),
+      internal(false),
+      headerWritten(false) {}
+
+Waveform::~Waveform() {
+    this->close();
+    for( unsigned int i = 0; i < probes.size(); i++ ) {
+        delete probes[i];
+    }
+}
+
+bool Waveform::open(const char *fileName,
+                    unsigned long long startCycle,
+                    unsigned long long stopCycle,
+                    const char *routers,
+                    bool internal) {
+#ifdef WAVEFORM_ZLIB
+    gzFile file = gzopen(fileName,"wb6");
+    if( file != NULL ) {
+        gzbuffer(file,1 << 20);
+    }
+#else
+    FILE* file = fopen(fileName,"wt");
+#endif
+    if( file == NULL ) {
+        printf("\n[Waveform] ERROR: It is not possible to open the file \"%s\" to write the waveform.",fileName);
+        return false;
+    }
+    out = (void*) file;
+    start = startCycle;
+    stop = stopCycle;
+    this->internal = internal;
+    headerWritten = false;
+
+    // Ranges of routers "first-last" or "id" separated by comma
+    this->routers.clear();
+    if( routers != NULL ) {
+        std::string list(routers);
+        size_t begin = 0;
+        while( begin < list.size() ) {
+            size_t end = list.find(',',begin);
+            if( end == std::string::npos ) {
+                end = list.size();
+            }
+            std::string range = list.substr(begin,end-begin);
+            size_t dash = range.find('-');
+            unsigned int first = (unsigned int) atoi(range.c_str());
+            unsigned int last = dash == std::string::npos ? first : (unsigned int) atoi(range.c_str()+dash+1);
+            this->routers.push_back(std::make_pair(first,last));
+            begin = end + 1;
+        }
+    }
+    return true;
+}
+
+void Waveform::close() {
+    if( out == NULL ) {
+        return;
+    }
+    if( !headerWritten ) { // Window after the end of simulation - only the declarations
+        this->writeHeader();
+    }
+#ifdef WAVEFORM_ZLIB
+    gzclose((gzFile) out);
+#else
+    fclose((FILE*) out);
+#endif
+    out = NULL;
+}
+
+bool Waveform::routerSelected(unsigned short routerId) const {
+    if( !isOpen() ) {
+        return false;
+    }
+    if( routers.empty() ) {
+        return true;
+    }
+    for( unsigned int i = 0; i < routers.size(); i++ ) {
+        if( routerId >= routers[i].first && routerId <= routers[i].second ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Waveform::write(const char *format, ...) {
+    char line[WAVEFORM_LINE_LENGTH];
+    va_list args;
+    va_start(args,format);
+    int length = vsnprintf(line,sizeof(line),format,args);
+    va_end(args);
+    if( length <= 0 ) {
+        return;
+    }
+    if( length >= (int) sizeof(line) ) {
+        length = sizeof(line) - 1;
+    }
+#ifdef WAVEFORM_ZLIB
+    gzwrite((gzFile) out,line,(unsigned int) length);
+#else
+    fwrite(line,1,length,(FILE*) out);
+#endif
+}
+
+/*!
+ * \brief identifierCode VCD identifier of a signal: printable characters
+ * in base 94 (the first one is the clock)
+ */
+static std::string identifierCode(unsigned int index) {
+    std::string code;
+    do {
+        code += (char) ('!' + index % 94);
+        index /= 94;
+    } while( index > 0 );
+    return code;
+}
+
+void Waveform::writeHeader() {
+
+    time_t now = time(NULL);
+    char date[64];
+    strftime(date,sizeof(date),"%Y-%m-%d %H:%M:%S",localtime(&now));
+    write("$date\n    %s\n$end\n",date);
+    write("$version\n    SNoCS waveform - cycles %llu to %llu\n$end\n",start,stop);
+    write("$timescale\n    1 ps\n$end\n");
+
+    // Declarations grouped by module
+    std::map<std::string,std::vector<WaveformProbe*> > scopes;
+    for( unsigned int i = 0; i < probes.size(); i++ ) {
+        probes[i]->code = identifierCode(i+1);
+        scopes[probes[i]->scope].push_back(probes[i]);
+    }
+    write("$scope module SystemC $end\n");
+    write("$var wire 1 %s CLK $end\n",WAVEFORM_CLOCK_CODE);
+    std::map<std::string,std::vector<WaveformProbe*> >::const_iterator it;
+    for( it = scopes.begin(); it != scopes.end(); it++ ) {
+        if( !it->first.empty() ) {
+            write("$scope module %s $end\n",it->first.c_str());
+        }
+        for( unsigned int i = 0; i < it->second.size(); i++ ) {
+            const WaveformProbe* probe = it->second[i];
+            write("$var wire %u %s %s $end\n",probe->width,probe->code.c_str(),probe->name.c_str());
+        }
+        if( !it->first.empty() ) {
+            write("$upscope $end\n");
+        }
+    }
+    write("$upscope $end\n$enddefinitions $end\n");
+    headerWritten = true;
+}
+
+void Waveform::writeValue(const WaveformProbe *probe, const std::string &value) {
+    if( probe->width == 1 ) {
+        write("%c%s\n",value[0],probe->code.c_str());
+    } else {
+        write("b%s %s\n",value.c_str(),probe->code.c_str());
+    }
+}
+
+void Waveform::sample(unsigned long long cycle) {
+
+    if( out == NULL || cycle < start || (stop > 0 && cycle > stop) ) {
+        return;
+    }
+
+    bool first = !headerWritten;
+    if( first ) {
+        this->writeHeader();
+    }
+
+    // The values changed on the rising edge that begins the cycle
+    double period = CLK_PERIOD * 1000.0; // ps
+    unsigned long long rising = (unsigned long long) llround((cycle > 0 ? cycle - 1 : 0) * period);
+    unsigned long long falling = rising + (unsigned long long) llround(period / 2.0);
+
+    write("#%llu\n",rising);
+    if( first ) {
+        write("$dumpvars\n");
+    }
+    write("1%s\n",WAVEFORM_CLOCK_CODE);
+    for( unsigned int i = 0; i < probes.size(); i++ ) {
+        WaveformProbe* probe = probes[i];
+        probe->sample(bits);
+        if( first || bits != probe->last ) {
+            writeValue(probe,bits);
+            probe->last = bits;
+        }
+    }
+    if( first ) {
+        write("$end\n");
+    }
+    write("#%llu\n0%s\n",falling,WAVEFORM_CLOCK_CODE);
+}
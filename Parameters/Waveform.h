@@ -0,0 +1,194 @@
+/*
+--------------------------------------------------------------------------------
+PROJECT: SoCIN_Simulator
+MODULE : No modules - global waveform
+FILE   : Waveform.h
+--------------------------------------------------------------------------------
+DESCRIPTION: Waveform (VCD, compressed with gzip if built with zlib) of the signals registered by
+the simulator and the routers, sampled once per cycle inside a window of
+cycles and restricted to a subset of routers
+--------------------------------------------------------------------------------
+AUTHORS: Laboratory of Embedded and Distributed Systems (LEDS - UNIVALI)
+CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
+-------------------------------- Reviews ---------------------------------------
+| Date       - Version - Author                      | Description
+--------------------------------------------------------------------------------
+| 19/10/2026 - 1.0     - SoCIN Simulator team        | Initial implementation
+--------------------------------------------------------------------------------
+*/
+
+#ifndef __WAVEFORM_H__
+#define __WAVEFORM_H__
+
+#include "../export.h"
+#include "../SoCINDefines.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+// Singleton instance
+#define WAVEFORM Waveform::instance() // Get the waveform
+
+#ifdef WAVEFORM_ZLIB
+#define WAVEFORM_FILENAME "snocs_wave.vcd.gz"
+#define WAVEFORM_FORMAT "VCD compressed with gzip"
+#else
+#define WAVEFORM_FILENAME "snocs_wave.vcd"
+#define WAVEFORM_FORMAT "VCD - built without zlib"
+#endif
+
+/////////////////////////////////////////////////////////////////////////
+/// Value of a signal in the waveform
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The WaveformValue struct converts the value of a signal to
+ * the bits written in the waveform (MSB first)
+ */
+template<class T>
+struct WaveformValue { // Integer types
+    static unsigned short width() { return 8 * sizeof(T); }
+    static void bits(const T& value, unsigned short width, std::string& out) {
+        out.resize(width);
+        for( unsigned short i = 0; i < width; i++ ) {
+            out[width-1-i] = ((unsigned long long) value >> i) & 1 ? '1' : '0';
+        }
+    }
+};
+
+template<>
+struct WaveformValue<bool> {
+    static unsigned short width() { return 1; }
+    static void bits(const bool& value, unsigned short, std::string& out) {
+        out.assign(1,value ? '1' : '0');
+    }
+};
+
+template<>
+struct WaveformValue<Flit> {
+    static unsigned short width() { return FLIT_WIDTH; }
+    static void bits(const Flit& value, unsigned short width, std::string& out) {
+        out.resize(width);
+        for( unsigned short i = 0; i < width; i++ ) {
+            out[width-1-i] = value.data[i] ? '1' : '0';
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// Signal sampled in the waveform
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The WaveformProbe class reads a signal (or port) to be written
+ * in the waveform
+ */
+class WaveformProbe {
+public:
+    std::string scope;      // Module in the waveform (empty: top)
+    std::string name;
+    unsigned short width;
+    std::string code;       // Identifier in the VCD
+    std::string last;       // Last value written
+
+    WaveformProbe(const std::string& scope, const std::string& name, unsigned short width)
+        : scope(scope), name(name), width(width) {}
+    virtual void sample(std::string& bits) const = 0;
+    virtual ~WaveformProbe() {}
+};
+
+/*!
+ * \brief The SignalProbe class reads any object with a read() method
+ * (sc_signal, sc_in, sc_out)
+ */
+template<class C>
+class SignalProbe : public WaveformProbe {
+public:
+    typedef typename std::decay<decltype(std::declval<const C&>().read())>::type ValueType;
+
+    SignalProbe(const C& object, const std::string& scope, const std::string& name, unsigned short width)
+        : WaveformProbe(scope,name,width > 0 ? width : WaveformValue<ValueType>::width()),
+          object(object) {}
+    void sample(std::string& bits) const { WaveformValue<ValueType>::bits(object.read(),width,bits); }
+
+private:
+    const C& object;
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// Waveform
+/////////////////////////////////////////////////////////////////////////
+/*!
+ * \brief The Waveform class replaces the SystemC VCD trace: the signals
+ * registered (during the elaboration) are sampled once per cycle, after
+ * the clock edge, only inside the window [startCycle,stopCycle] and only
+ * the changes are written. The routers register their ports and, on
+ * demand, their internal signals, if they are in the subset traced.
+ */
+// Singleton
+class EXP_DEFINES Waveform {
+public:
+    static Waveform* instance();
+
+    /*!
+     * \brief open It creates the waveform file
+     * \param stopCycle Last cycle traced (0: until the end of simulation)
+     * \param routers Routers traced "0-3,7" (NULL: all)
+     * \param internal Internal signals of the routers traced
+     */
+    bool open(const char* fileName,
+              unsigned long long startCycle,
+              unsigned long long stopCycle,
+              const char* routers,
+              bool internal);
+
+    void close();
+
+    bool isOpen() const { return out != NULL; }
+    bool routerSelected(unsigned short routerId) const;
+    bool internalSignals() const { return isOpen() && internal; }
+    unsigned long long startCycle() const { return start; }
+    unsigned long long stopCycle() const { return stop; }
+
+    /*!
+     * \brief trace It registers a signal (or port) to be sampled
+     * \param scope Module in the waveform (empty: top)
+     * \param width Bits written (0: width of the type)
+     */
+    template<class C>
+    void trace(const C& object, const std::string& scope, const std::string& name, unsigned short width = 0) {
+        if( isOpen() ) {
+            probes.push_back(new SignalProbe<C>(object,scope,name,width));
+        }
+    }
+
+    /*!
+     * \brief sample It writes the changes of the signals in the cycle,
+     * after the clock edge (called once per cycle inside the window)
+     */
+    void sample(unsigned long long cycle);
+
+private:
+    // Singleton
+    static Waveform* waveform;
+
+    void* out;                          // FILE or gzFile
+    unsigned long long start;
+    unsigned long long stop;
+    std::vector<std::pair<unsigned int,unsigned int> > routers; // Ranges of routers traced (empty: all)
+    bool internal;
+    std::vector<WaveformProbe*> probes;
+    bool headerWritten;
+    std::string bits;                   // Value sampled
+
+    Waveform();
+    Waveform(const Waveform&);
+    Waveform& operator= (const Waveform&);
+    ~Waveform();
+
+    void writeHeader();
+    void write(const char* format, ...);
+    void writeValue(const WaveformProbe* probe, const std::string& value);
+};
+
+#endif // __WAVEFORM_H__
@@ -112,6 +112,12 @@ public:
 
     void output_properties();
 
+    /*!
+     * \brief pluginProperties Plugin file selected for each kind of
+     * component (noc, router, routing, ...) in the configuration file
+     */
+    const std::map<std::string, std::string>& pluginProperties() const { return properties; }
+
 };
 
 
@@ -20,6 +20,8 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 --------------------------------------------------------------------------------
 | 10/08/2016 - 1.0     - Eduardo Alves da Silva      | Reuse from ParIS
 --------------------------------------------------------------------------------
+| 19/10/2026 - 1.1     - SoCIN Simulator team        | Arbitrations counted
+--------------------------------------------------------------------------------
 */
 
 #ifndef __PROGRAMMABLEPRIORITYENCODER_H__
@@ -28,6 +30,7 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 #include <ctime>
 
 #include "../SoCINModule.h"
+#include "../Parameters/Instrumentation.h"
 /*!
  * \brief The ProgrammablePriorityEncoder class implements a programmable
  * priority encoder of SoCIN.
@@ -66,6 +69,9 @@ public:
     // Internal data structures
     unsigned short int ROUTER_ID, PORT_ID;
 
+    // Grants given counted on each clock edge (NULL: disabled) - set by the port module
+    ActivityCounters* activityCounters;
+
     // Module's processes
     void p_IMED_IN();
     void p_IMED_OUT();
@@ -145,7 +151,8 @@ inline ProgrammablePriorityEncoder::ProgrammablePriorityEncoder(sc_module_name m
       r_GRANT("PPE_rGRANT",nPorts),
       w_IDLE("PPE_wIDLE"),
       ROUTER_ID(ROUTER_ID),
-      PORT_ID(PORT_ID)
+      PORT_ID(PORT_ID),
+      activityCounters(NULL)
 {
 
     unsigned short i; // Loop iterator
@@ -298,6 +305,16 @@ inline void ProgrammablePriorityEncoder::p_GRANT_REG()
     for( i = 0; i < nPorts; i++ ) {
         r_GRANT[i].write( v_GRANT_REG[i] );
     }
+
+    // A grant given by the arbiter idle is an arbitration
+    if( activityCounters != NULL && !i_RST.read() && w_IDLE.read() ) {
+        for( i = 0; i < nPorts; i++ ) {
+            if( v_GRANT_REG[i] ) {
+                activityCounters->arbitrations++;
+                break;
+            }
+        }
+    }
 }
 
 
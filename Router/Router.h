@@ -20,6 +20,7 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 
 #include "../XIN/XIN.h"
 #include "../XOUT/XOUT.h"
+#include "../Parameters/Waveform.h"
 
 /////////////////////////////////////////////////////////////////////////////////
 /// Simple Router interface
@@ -72,7 +73,29 @@ inline IRouter::IRouter(sc_module_name mn,
       o_DATA_OUT("IRouter_oDATA_OUT",nPorts),
       o_VALID_OUT("IRouter_oVALID_OUT",nPorts),
       i_RETURN_OUT("IRouter_iRETURN_OUT",nPorts),
-      ROUTER_ID(ROUTER_ID) {}
+      ROUTER_ID(ROUTER_ID)
+{
+    // Ports in the waveform (module Router_<id>)
+    if( WAVEFORM->routerSelected(ROUTER_ID) ) {
+        char scope[20];
+        sprintf(scope,"Router_%u",ROUTER_ID);
+        char name[30];
+        for(unsigned short i = 0; i < nPorts; i++) {
+            sprintf(name,"DATA_IN(%u)",i);
+            WAVEFORM->trace(i_DATA_IN[i],scope,name);
+            sprintf(name,"VALID_IN(%u)",i);
+            WAVEFORM->trace(i_VALID_IN[i],scope,name);
+            sprintf(name,"RET_IN(%u)",i);
+            WAVEFORM->trace(o_RETURN_IN[i],scope,name);
+            sprintf(name,"DATA_OUT(%u)",i);
+            WAVEFORM->trace(o_DATA_OUT[i],scope,name);
+            sprintf(name,"VALID_OUT(%u)",i);
+            WAVEFORM->trace(o_VALID_OUT[i],scope,name);
+            sprintf(name,"RET_OUT(%u)",i);
+            WAVEFORM->trace(i_RETURN_OUT[i],scope,name);
+        }
+    }
+}
 
 
 
@@ -117,6 +140,21 @@ inline IRouter_VC::IRouter_VC(sc_module_name mn,
             o_VC_OUT[i].init(widthVcSelector);
             i_VC_IN[i].init(widthVcSelector);
         }
+
+        // Virtual channel selectors in the waveform
+        if( WAVEFORM->routerSelected(ROUTER_ID) ) {
+            char scope[20];
+            sprintf(scope,"Router_%u",ROUTER_ID);
+            char name[30];
+            for(unsigned short i = 0; i < nPorts; i++) {
+                for(unsigned short b = 0; b < widthVcSelector; b++) {
+                    sprintf(name,"VC_IN(%u)(%u)",i,b);
+                    WAVEFORM->trace(i_VC_IN[i][b],scope,name);
+                    sprintf(name,"VC_OUT(%u)(%u)",i,b);
+                    WAVEFORM->trace(o_VC_OUT[i][b],scope,name);
+                }
+            }
+        }
     }
 }
 
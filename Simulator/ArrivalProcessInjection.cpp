@@ -0,0 +1,25 @@
+#include "ArrivalProcessInjection.h"
+
+ArrivalProcessInjection::ArrivalProcessInjection(unsigned short numCyclesPerFlit)
+    : TypeInjection(numCyclesPerFlit),
+      nextGap(ARRIVAL_BATCH),
+      arrivalTime(0),
+      injectionTime(0)
+{}
+
+void ArrivalProcessInjection::prepareNextPacket(FlowGenerator::FlowParameters &flow) {
+
+    if( nextGap == ARRIVAL_BATCH ) {
+        this->sampleArrivals(flow,gaps,ARRIVAL_BATCH);
+        nextGap = 0;
+    }
+    arrivalTime += gaps[nextGap++];
+
+    // Packets that arrive while the previous one is transmitted are sent back-to-back
+    if( arrivalTime > injectionTime ) {
+        flow.idle = (unsigned int) (arrivalTime - injectionTime);
+    } else {
+        flow.idle = 0;
+    }
+    injectionTime += flow.idle + this->packetCycles(flow);
+}
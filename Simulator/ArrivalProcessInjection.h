@@ -0,0 +1,44 @@
+#ifndef __ARRIVALPROCESSINJECTION_H__
+#define __ARRIVALPROCESSINJECTION_H__
+
+#include "TypeInjection.h"
+
+#include <cmath>
+
+#define ARRIVAL_BATCH 64 // Inter-arrival times sampled at once
+
+/*!
+ * \brief The ArrivalProcessInjection class is the base of the injection
+ * processes described by a stochastic arrival process. The inter-arrival
+ * times are sampled in batches and converted to the idle time before each
+ * packet. When an inter-arrival time is shorter than the packet
+ * transmission, the difference is carried to the next packets, so the
+ * long-term rate of the process is kept.
+ */
+class ArrivalProcessInjection : public TypeInjection {
+public:
+    ArrivalProcessInjection(unsigned short numCyclesPerFlit);
+
+    void prepareNextPacket(FlowGenerator::FlowParameters& flow);
+    void adjustFlow(FlowGenerator::FlowParameters&) {} // The idle time is determined by the arrivals
+
+protected:
+    /*!
+     * \brief sampleArrivals It samples the next inter-arrival times (in cycles)
+     */
+    virtual void sampleArrivals(FlowGenerator::FlowParameters& flow, double* gaps, unsigned int n) = 0;
+
+    inline double packetCycles(const FlowGenerator::FlowParameters& flow) const
+    { return (double) (flow.payload_length + HEADER_LENGTH) * numCyclesPerFlit; }
+
+    // Exponential distribution - mean 1/rate
+    inline double exponential(double rate) { return -log(1.0 - random.uniform()) / rate; }
+
+private:
+    double gaps[ARRIVAL_BATCH];
+    unsigned int nextGap;
+    double arrivalTime;     // Arrival of the last packet
+    double injectionTime;   // Earliest injection of the next packet, according the idle times given
+};
+
+#endif // __ARRIVALPROCESSINJECTION_H__
@@ -1,7 +1,26 @@
 #include "ConstantInjection.h"
 
+REGISTER_TYPE_INJECTION(0,ConstantInjection)
+
 ConstantInjection::ConstantInjection(unsigned short numCyclesPerFlit)
-    : TypeInjection(numCyclesPerFlit)
+    : TypeInjection(numCyclesPerFlit),
+      variableLength(false), idleRatio(0), idleRemainder(0)
 {}
 
+void ConstantInjection::prepareNextPacket(FlowGenerator::FlowParameters &flow) {
+    // The flow parameters are kept for all the packets, only the idle time
+    // follows a sampled payload length in order to keep the configured load
+    if( variableLength ) {
+        double idle = idleRatio * (flow.payload_length + HEADER_LENGTH) + idleRemainder;
+        flow.idle = (unsigned int) idle;
+        idleRemainder = idle - flow.idle;
+    }
+}
+
+bool ConstantInjection::acceptSizeDistribution(const FlowGenerator::FlowParameters &flow) {
+    variableLength = true;
+    idleRatio = (double) flow.idle / (flow.payload_length + HEADER_LENGTH);
+    return true;
+}
+
 void ConstantInjection::adjustFlow(FlowGenerator::FlowParameters &){} // Nothing to do, the front-end calculates the idle time
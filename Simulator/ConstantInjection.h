@@ -4,9 +4,15 @@
 #include "TypeInjection.h"
 
 class ConstantInjection : public TypeInjection {
+private:
+    bool   variableLength;  // The payload length is sampled from a distribution
+    double idleRatio;       // Idle cycles per flit of the configured packet
+    double idleRemainder;   // Fraction of idle cycle not yet spent (keeps the mean load)
 public:
     ConstantInjection(unsigned short numCyclesPerFlit);
+    void prepareNextPacket(FlowGenerator::FlowParameters& flow);
     void adjustFlow(FlowGenerator::FlowParameters& flow);
+    bool acceptSizeDistribution(const FlowGenerator::FlowParameters& flow);
 };
 
 #endif // CONSTANTINJECTION_H
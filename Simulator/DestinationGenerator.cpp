@@ -1,8 +1,7 @@
 #include "DestinationGenerator.h"
 
 #include "../Parameters/Parameters.h"
-#include <chrono>
 
-DestinationGenerator::DestinationGenerator()
-    : generator(std::chrono::system_clock::now().time_since_epoch().count())
+DestinationGenerator::DestinationGenerator(unsigned short source)
+    : generator(SEED,source,RNG_STREAM_DESTINATION)
 {}
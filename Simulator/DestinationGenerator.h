@@ -1,14 +1,15 @@
 #ifndef __DESTINATIONGENERATOR_H__
 #define __DESTINATIONGENERATOR_H__
 
-#include <random>
+#include "../Parameters/RandomStream.h"
 
 class DestinationGenerator {
 protected:
     // PRNG
-    std::default_random_engine generator;
+    RandomStream generator;
 public:
-    DestinationGenerator();
+    DestinationGenerator(unsigned short source);
+    virtual ~DestinationGenerator() {}
 
     virtual unsigned short getDestination(unsigned short source) = 0;
 };
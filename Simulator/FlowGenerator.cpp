@@ -1,17 +1,16 @@
 #include "FlowGenerator.h"
 #include <ctime>
 #include "../Parameters/Parameters.h"
+#include "../Parameters/PacketTracer.h"
 
 #include "UniformDistribution.h"
+#include "PacketTrace.h"
+#include "TaskGraph.h"
+#include "PhaseSchedule.h"
 
 // Types of Injection
 #include "TypeInjection.h"
-#include "ConstantInjection.h"
-#include "VarBurstFixInterval.h"
-#include "VarIdleFixPacketSize.h"
-#include "VarIntervalFixPacketSize.h"
-#include "VarPacketSizeFixIdle.h"
-#include "VarPacketSizeFixInterval.h"
+#include "PacketSizeDistribution.h"
 
 //#define DEBUG_FG_ADDRESSING
 
@@ -23,29 +22,65 @@ FlowGenerator::FlowGenerator(sc_module_name mn,
       topologyType(topologyType),
       FG_ID(FG_ID),
       numberCyclesPerFlit(numberOfCyclesPerFlit),
-      randomGenerator(SEED),
-      totalPacketsToSend(0)
+      flowRandom(SEED,FG_ID,RNG_STREAM_FLOW_SELECTION),
+      totalPacketsToSend(0),
+      currentPhase(PHASE_NONE),
+      packetsSent(0),
+      scheduledFlow(NULL),
+      nextInjectionCycle(0)
 {
 
-    // Initialize the default random engine with time seed
-    srand(SEED);
-
-    if(!this->readTrafficFile()) {
-        exit(-1);
+    if( REPLAY_FILE != NULL ) { // Packets from a trace instead of the flows in the traffic file
+        if( !PACKET_TRACE->isOpen() ) {
+            exit(-1);
+        }
+        totalPacketsToSend = PACKET_TRACE->packetsFrom(FG_ID);
+    } else if( TASK_GRAPH_FILE != NULL ) { // Messages of the application task graph
+        if( !TASK_GRAPH->isOpen() ) {
+            exit(-1);
+        }
+        totalPacketsToSend = TASK_GRAPH->messagesFrom(FG_ID);
+    } else if( PHASE_FILE != NULL ) { // One set of flows for each phase of the schedule
+        if( !PHASE_SCHEDULE->isOpen() ) {
+            exit(-1);
+        }
+        for( unsigned int phase = 0; phase < PHASE_SCHEDULE->numberOfPhases(); phase++ ) {
+            unsigned long packets = totalPacketsToSend;
+            if( !this->readTrafficFile(PHASE_SCHEDULE->trafficFile(phase),phase) ) {
+                exit(-1);
+            }
+            PHASE_SCHEDULE->addQuota(phase,totalPacketsToSend - packets);
+        }
+    } else {
+        char strTCF[256];
+        sprintf(strTCF,"%s/%s",WORK_DIR,TRAFFIC_FILENAME);
+        if( !this->readTrafficFile(strTCF,0) ) {
+            exit(-1);
+        }
     }
 
-    vcWidth = (unsigned short) ceil(log2(NUM_VC));
-    if(vcWidth>0) {
-        o_VC_SEND.init( vcWidth );
+    // The flows with packets to send take part in the selection
+    flowSelector.resize(flows.size());
+    for( unsigned int i = 0; i < flows.size(); i++ ) {
+        this->refreshFlowWeight(i);
     }
 
-    SC_CTHREAD(p_SEND, i_CLK.pos());
-    sensitive << i_CLK.pos() << i_RST.pos();
+    if( !CALENDAR_INJECTION ) { // Otherwise, the injection scheduler calls injectScheduled
+        SC_CTHREAD(p_SEND, i_CLK.pos());
+        sensitive << i_CLK.pos() << i_RST.pos();
+    }
 
     SC_CTHREAD(p_RECEIVE, i_CLK.pos());
     sensitive << i_CLK.pos() << i_RST.pos();
 }
 
+FlowGenerator::~FlowGenerator() {
+    for(unsigned int i = 0; i < flows.size(); i++) {
+        delete flows[i].injection;
+        delete flows[i].sizeDistribution;
+    }
+}
+
 UIntVar FlowGenerator::getHeaderAddresses(unsigned short src,unsigned short dst) {
 #ifdef DEBUG_FG_ADDRESSING
     std::cout << "\n[FG] Addressing - Src: " << src << ", Dst: " << dst;
@@ -95,31 +130,40 @@ UIntVar FlowGenerator::getHeaderAddresses(unsigned short src,unsigned short dst)
     return rib;
 }
 
-void FlowGenerator::sendFlit(Flit flit, unsigned short virtualChannel) {
-
-    UIntVar v_VC = virtualChannel;
-    bool    v_BOP= flit.data[FLIT_WIDTH-2];
-
-    if(v_BOP) {
-        for(unsigned short i = 0; i < vcWidth; i++) {
-            o_VC_SEND[i].write(v_VC[i]);
-        }
+/*!
+ * \brief FlowGenerator::getHeaderSource It extracts the source terminal
+ * from the addressing of a header (the inverse of getHeaderAddresses).
+ */
+unsigned short FlowGenerator::getHeaderSource(const UIntVar& header) {
+    switch ( topologyType ) {
+    case INoC::TT_Non_Orthogonal:
+        return header.range(RIB_WIDTH*2-1,RIB_WIDTH).to_uint();
+    case INoC::TT_Orthogonal2D: {
+        unsigned xSrc = header.range(RIB_WIDTH*2-1,RIB_WIDTH*2-RIB_WIDTH/2).to_uint();
+        unsigned ySrc = header.range(RIB_WIDTH*2-RIB_WIDTH/2-1,RIB_WIDTH).to_uint();
+        return COORDINATE_2D_TO_ID(xSrc,ySrc);
     }
-
-    o_WRITE_SEND.write(0);
-    o_DATA_SEND.write(flit);
-    o_WRITE_SEND.write(1);
-    wait();
-
-    while (i_WRITE_OK_SEND.read() == 0) {
-        wait();
+    case INoC::TT_Orthogonal3D:
+        unsigned xSrc = header.range(15,13).to_uint();
+        unsigned ySrc = header.range(12,10).to_uint();
+        unsigned zSrc = header.range( 9, 8).to_uint();
+        return COORDINATE_3D_TO_ID(xSrc,ySrc,zSrc);
     }
+    return 0;
 }
 
-void FlowGenerator::sendPacket(FlowParameters flowParam,
-                               unsigned long long cycleToSend,
-                               unsigned long payloadLength,
-                               unsigned short packetType) {
+/*!
+ * \brief FlowGenerator::sendPacket It writes a packet in the source queue.
+ * \param messageType Open-loop message, request or reply (closed-loop traffic) or task message
+ * \param requestId Identifier of the request replied or of the task graph edge, carried by the trailer
+ * \return The packet identifier
+ */
+unsigned long FlowGenerator::sendPacket(FlowParameters flowParam,
+                                        unsigned long long cycleToSend,
+                                        unsigned long payloadLength,
+                                        unsigned short packetType,
+                                        unsigned short messageType,
+                                        unsigned long requestId) {
 
     if( FG_ID == flowParam.destination ) { // The source and destination addresses are the same
         std::cout << "\n[FlowGenerator] WARNING: The packet source and destination addresses are the same - FG: "
@@ -127,53 +171,57 @@ void FlowGenerator::sendPacket(FlowParameters flowParam,
         sc_stop();
     }
 
-    UIntVar flit(0,FLIT_WIDTH); // Auxiliary variable to build the flit to be sent (FLIT_WIDTH is defined in Parameters.h)
-
     Packet* packet = new Packet;
     packet->requiredBW = flowParam.required_bw;
     packet->deadline = flowParam.deadline;
     packet->packetCreationCycle = cycleToSend + 1;
+    packet->injectionCycle = 0; // Stamped by the source queue
     packet->packetId = PARAMS->pckId++;
     packet->payloadLength = payloadLength;
     packet->hops = 0;
+    packet->traced = PACKET_TRACER->isOpen()
+            && PACKET_TRACER->sample(packet->packetId,FG_ID,flowParam.destination,packet->packetCreationCycle);
+
+    // The source queue only stores the packet descriptor, the payload and
+    // trailer flits are built by the queue when they are sent to the network
+    PacketDescriptor descriptor;
+    descriptor.packet = packet;
+    descriptor.payloadLength = payloadLength;
+    descriptor.trailer = (messageType == MSG_REPLY || messageType == MSG_TASK) ? requestId : packet->packetId;
 
     /////////////////// Header ///////////////////
+    UIntVar& flit = descriptor.header;
     flit = getHeaderAddresses(FG_ID,flowParam.destination); // Get Addressing according the topology type
     flit[FLIT_WIDTH-2] = 1;                                 // BOP high - Header
     flit.range(CMD_POSITION,CMD_POSITION-1) = packetType;   // Switching (NORMAL, ALLOC, RELEASE, GRANT)
     flit.range(CLS_POS,CLS_POS-2) = flowParam.traffic_class;// Traffic Class
     flit.range(FID_POS,FID_POS-1) = flowParam.flow_id;      // Flow id
+    flit.range(MSG_TYPE_POS,MSG_TYPE_POS-1) = messageType;  // Message type (closed-loop and task graph traffic)
 
     // TODO Verify what virtual channel must be used according the traffic class
-    unsigned short virtualChannel = flowParam.traffic_class;
-
-    // It sends the header
-    Flit headerFlit;
-    headerFlit.data = flit;
-    headerFlit.packet_ptr = packet;
-    this->sendFlit(headerFlit,virtualChannel); // Send header
-
-    /////////////////// Payload ///////////////////
-    for(unsigned short i = 0; i < payloadLength - 1; i++) {
-        Flit payload;
-        payload.data = i; // The content of the flit is only the number of flit in the packet
-        payload.packet_ptr = packet;
-        this->sendFlit(payload,virtualChannel); // Sending payload
-    }
-
-    /////////////////// Trailer ///////////////////
-    // It sends the trailer flit: the lowest word with "Bye" string
-    //    char msg[4] = "Bye"; // 4 bytes -> [0]: B , [1]: y, [2]: e, [3]: \0
-    //    //   =   ASCI:  B       |        y       |       e       |   \0
-    //    flit = ( (msg[0] << 24) | (msg[1] << 16) | (msg[2] << 8) | (msg[3]) );
-    // Send trailer with the packet id
-    flit = packet->packetId; // Put the packet ID on the trailer payload
-    flit[FLIT_WIDTH-1] = 1; // Trailer
-
-    Flit trailer;
-    trailer.data = flit;
-    trailer.packet_ptr = packet;
-    this->sendFlit(trailer, virtualChannel); // Send trailer
+    descriptor.virtualChannel = flowParam.traffic_class;
+
+    unsigned long packetId = packet->packetId; // The packet is released by the traffic meter after its delivery
+    if( currentPhase != PHASE_NONE ) {
+        PHASE_SCHEDULE->packetSent(currentPhase,packetId,packet->packetCreationCycle,payloadLength+HEADER_LENGTH);
+    }
+
+    if( CALENDAR_INJECTION ) { // Called by the injection scheduler - no handshake (the queue is unbounded)
+        u_FIFO->push(descriptor);
+        return packetId;
+    }
+
+    // It writes the packet in the source queue
+    o_WRITE_SEND.write(0);
+    o_PACKET_SEND.write(descriptor);
+    o_WRITE_SEND.write(1);
+    wait();
+
+    while (i_WRITE_OK_SEND.read() == 0) {
+        wait();
+    }
+
+    return packetId;
 }
 
 void FlowGenerator::sendBurst(FlowParameters flowParam, unsigned long long cycleToSend) {
@@ -189,11 +237,15 @@ void FlowGenerator::sendBurst(FlowParameters flowParam, unsigned long long cycle
 }
 
 
-bool FlowGenerator::readTrafficFile() {
+/*!
+ * \brief FlowGenerator::readTrafficFile It appends the flows of the traffic
+ * generator described in a traffic file (one file for each phase of the
+ * schedule).
+ */
+bool FlowGenerator::readTrafficFile(const char* fileName, unsigned int phase) {
 
     FILE* trafficFile;
     char fgName[20];
-    char strTCF[256];
     char str[30];
 
     unsigned int numberOfFlows;
@@ -202,9 +254,8 @@ bool FlowGenerator::readTrafficFile() {
     // READING THE FLOWS FROM THE DESCRIPTOR FILE
     /////////////////////////////////////////////
     // It tries to open the file
-    sprintf(strTCF,"%s/%s",WORK_DIR,TRAFFIC_FILENAME);
-    if ((trafficFile=fopen(strTCF,"rt")) == NULL) {
-        printf("\n[FlowGenerator] ERROR: Impossible to open file \"%s\". Exiting...", strTCF);
+    if ((trafficFile=fopen(fileName,"rt")) == NULL) {
+        printf("\n[FlowGenerator] ERROR: Impossible to open file \"%s\". Exiting...", fileName);
         return false;
     } else {
         // It searches for the traffic description in the file
@@ -225,11 +276,14 @@ bool FlowGenerator::readTrafficFile() {
         } while ((strcmp(fgName,str)));
     }
 
+    unsigned int firstFlow = flows.size();
+    numberOfFlows += firstFlow;
     flows.resize(numberOfFlows);
-    uniformRandom = std::uniform_int_distribution<int>(0, (int) numberOfFlows -1);
+    flowWeights.resize(numberOfFlows);
+    outstandingPerFlow.resize(numberOfFlows,0);
+    roundTrip.resize(numberOfFlows,RoundTripStats());
 
-    totalPacketsToSend = 0;
-    for(unsigned int flow_index = 0; flow_index < numberOfFlows; flow_index++){
+    for(unsigned int flow_index = firstFlow; flow_index < numberOfFlows; flow_index++){
         FlowParameters flow;
         fscanf(trafficFile,"%u" , &(flow.type));
         fscanf(trafficFile,"%hu", &(flow.destination));
@@ -246,10 +300,36 @@ bool FlowGenerator::readTrafficFile() {
         fscanf(trafficFile,"%u" , &(flow.last_payload_length));
         fscanf(trafficFile,"%f" , &(flow.parameter1));
         fscanf(trafficFile,"%f" , &(flow.parameter2));
+        flow.injection = TypeInjection::create(flow.type,numberCyclesPerFlit);
+        if( flow.injection == NULL ) {
+            printf("\n[FlowGenerator] ERROR: Unknown injection type (%u) in the flow %u of the traffic generator %u.",
+                   flow.type,flow_index,FG_ID);
+            flows.resize(flow_index);
+            fclose(trafficFile);
+            return false;
+        }
+        flow.injection->setRandomStream( RandomStream(SEED,FG_ID,RNG_STREAM_INJECTION,flow_index) );
+        if( !this->readSizeDistribution(trafficFile,flow,flow_index) ) {
+            delete flow.injection;
+            flows.resize(flow_index);
+            fclose(trafficFile);
+            return false;
+        }
         // It determines the total number of packets to be sent by all the flows
         totalPacketsToSend += flow.pck_2send;
         flow.pck_sent = 0;
+        flow.phase = phase;
         flows[flow_index] = flow;
+
+        // It determines the flow weight on the selection of the next packet
+        if( FLOW_WEIGHTING == 1 ) { // Proportional to the required bandwidth (in millionths of the channel)
+            flowWeights[flow_index] = (unsigned long long) (flow.required_bw * 1000000.0f + 0.5f);
+            if( flowWeights[flow_index] == 0 ) {
+                flowWeights[flow_index] = 1;
+            }
+        } else {                    // Uniform
+            flowWeights[flow_index] = 1;
+        }
     }
 
     // It closes the input file
@@ -258,47 +338,125 @@ bool FlowGenerator::readTrafficFile() {
     return true;
 }
 
-FlowGenerator::FlowParameters& FlowGenerator::getFlow() {
+/*!
+ * \brief FlowGenerator::readSizeDistribution It reads the optional payload
+ * length distribution that follows the flow parameters in the traffic file:
+ *   cdf <n> <length_1> <cumulative_probability_1> ... <length_n> <cumulative_probability_n>
+ *   cdf_file <file> (one "length cumulative_probability" per line - relative to the work folder)
+ */
+bool FlowGenerator::readSizeDistribution(FILE *trafficFile, FlowParameters &flow, unsigned int flowIndex) {
 
-    unsigned int flowIndex = 0;
-    FlowParameters* flowSelected = NULL;
+    flow.sizeDistribution = NULL;
 
-    bool hasFlow = false;
+    char token[256];
+    long position = ftell(trafficFile);
+    if( fscanf(trafficFile,"%255s",token) != 1 ) {
+        return true;
+    }
+    if( strcmp(token,"cdf") != 0 && strcmp(token,"cdf_file") != 0 ) {
+        fseek(trafficFile,position,SEEK_SET); // It is not a distribution - the next flow or traffic generator
+        return true;
+    }
 
-    // Verify if there are some flow with packets to send
-    for( unsigned int i = 0; i < flows.size(); i++ ) {
-        flowSelected = &flows[i];
-        if( flowSelected->pck_sent < flowSelected->pck_2send ) {
-            hasFlow = true;
-            break;
+    flow.sizeDistribution = new PacketSizeDistribution( RandomStream(SEED,FG_ID,RNG_STREAM_PACKET_SIZE,flowIndex) );
+    bool ok;
+    if( !strcmp(token,"cdf") ) {
+        unsigned int n = 0;
+        ok = fscanf(trafficFile,"%u",&n) == 1 && flow.sizeDistribution->readTable(trafficFile,n);
+    } else {
+        char fileName[512];
+        ok = fscanf(trafficFile,"%255s",token) == 1;
+        if( ok ) {
+            if( token[0] == '/' ) {
+                sprintf(fileName,"%s",token);
+            } else {
+                sprintf(fileName,"%s/%s",WORK_DIR,token);
+            }
+            ok = flow.sizeDistribution->readFile(fileName);
         }
     }
+    if( !ok ) {
+        printf("\n[FlowGenerator] ERROR: Invalid packet size distribution in the flow %u of the traffic generator %u.",
+               flowIndex,FG_ID);
+    } else if( !flow.injection->acceptSizeDistribution(flow) ) {
+        printf("\n[FlowGenerator] ERROR: The injection type %u determines the payload length"
+               " - a packet size distribution cannot be used in the flow %u of the traffic generator %u.",
+               flow.type,flowIndex,FG_ID);
+        ok = false;
+    }
+    if( !ok ) {
+        delete flow.sizeDistribution;
+        flow.sizeDistribution = NULL;
+    }
+    return ok;
+}
+
+/*!
+ * \brief FlowGenerator::nextPacketLength It samples the payload length of
+ * the next packet of a flow with a packet size distribution. The injection
+ * process sees the new length, so the idle time keeps the flow load (the
+ * types that derive the length from the load reject the distribution).
+ */
+void FlowGenerator::nextPacketLength(FlowParameters &flow) {
+    if( flow.sizeDistribution != NULL ) {
+        flow.payload_length = flow.sizeDistribution->sample();
+    }
+}
+
+/*!
+ * \brief FlowGenerator::getFlow It chooses one of the flows that still has
+ * some packet to send, proportionally to the flow weights.
+ */
+FlowGenerator::FlowParameters& FlowGenerator::getFlow() {
 
-    if( !hasFlow ) {
+    unsigned long long total = flowSelector.totalWeight();
+    if( total == 0 ) {
         std::cout << std::endl << "FG " << FG_ID << " has no flow with packets to send!";
+        return flows[0];
     }
 
-    // It randomly chooses one of the flows that still has some packet to send
-    do {
-        flowIndex = uniformRandom(randomGenerator);
-        flowSelected = &this->flows[flowIndex];
-    } while( flowSelected->pck_sent == flowSelected->pck_2send );
+    return flows[ flowSelector.select(flowRandom.uniformInt64(total)) ];
+}
+
+/*!
+ * \brief FlowGenerator::updateFlowStatus It removes the flow from the
+ * selection when all its packets were sent.
+ */
+void FlowGenerator::updateFlowStatus(FlowParameters &flow) {
+    this->refreshFlowWeight((unsigned int) (&flow - &flows[0]));
+}
 
-    return *flowSelected;
+/*!
+ * \brief FlowGenerator::refreshFlowWeight A flow takes part in the selection
+ * while it has packets to send and, in closed-loop traffic, while it has not
+ * reached the limit of outstanding requests. With a phase schedule, only the
+ * flows of the phase running take part.
+ */
+void FlowGenerator::refreshFlowWeight(unsigned int flowIndex) {
+    const FlowParameters& flow = flows[flowIndex];
+    bool active = flow.pck_sent < flow.pck_2send;
+    if( CLOSED_LOOP && outstandingPerFlow[flowIndex] >= MAX_OUTSTANDING ) {
+        active = false;
+    }
+    if( PHASE_FILE != NULL && flow.phase != currentPhase ) {
+        active = false; // The flow belongs to another phase of the schedule
+    }
+    flowSelector.setWeight(flowIndex, active ? flowWeights[flowIndex] : 0);
 }
 
 void FlowGenerator::reloadFlows() {
     for(unsigned int i = 0; i < flows.size(); i++) {
         FlowParameters* flow = &flows[i];
         flow->pck_sent = 0;
+        this->refreshFlowWeight(i);
     }
 }
 
 void FlowGenerator::p_SEND() {
 
     // Reseting
-    Flit fNull = 0;
-    o_DATA_SEND.write(fNull);
+    PacketDescriptor pNull;
+    o_PACKET_SEND.write(pNull);
     o_WRITE_SEND.write(0);
     o_END_OF_TRANSMISSION.write(0);
     o_NUMBER_OF_PACKETS_SENT.write(0);
@@ -306,55 +464,39 @@ void FlowGenerator::p_SEND() {
     wait();
 
     unsigned int numFlows = this->flows.size();
-    if(numFlows > 0) {
+    if( REPLAY_FILE != NULL ) {
+        this->replayTrace();
+    } else if( TASK_GRAPH_FILE != NULL ) {
+        this->runTaskGraph();
+    } else if( CLOSED_LOOP ) {
+        this->runClosedLoop(); // It never returns - the terminal replies the requests until the end of simulation
+    } else if(numFlows > 0) {
         unsigned long long cycleToSendNextPacket;
         // It determines the cycle to send the first packet
         cycleToSendNextPacket = i_CLK_CYCLES.read();
 
-        unsigned long long packetsSent = 0;
+        packetsSent = 0;
 
         ///// Sending the packets /////
         while( true ) { // Send packets
 
+            if( PHASE_FILE != NULL ) {
+                if( !this->followPhaseSchedule(cycleToSendNextPacket) ) {
+                    break; // The last phase has finished
+                }
+                if( flowSelector.totalWeight() == 0 ) { // The terminal sent all the packets of the phase
+                    wait();
+                    continue;
+                }
+            }
+
 // EDUARDO - only store one packet on the source queue
-            if( u_FIFO->m_FIFO.size() < 2 ) { // Dally approach, only put packet on the source queue when there is one or none packet
+            if( u_FIFO->numberOfFlits() < 2 ) { // Dally approach, only put packet on the source queue when there is one or none packet
 // EDUARDO - only store one packet on the source queue
                 FlowParameters& flow = this->getFlow(); // Get a flow randomly
 
-                TypeInjection* tpInjection = NULL;
-                switch (flow.type) {
-                case 0: // Constant
-                    tpInjection = new ConstantInjection(numberCyclesPerFlit);
-                    break;
-                case 1: // Variable idle time - Fix message size
-                    tpInjection = new VariableIdleFixPacketSize(numberCyclesPerFlit);
-                    break;
-                case 2: // Variable message size - Fix idle time
-                    tpInjection = new VarPacketSizeFixIdle(numberCyclesPerFlit);
-                    break;
-                case 3: // Variable message size - Fix message inteval
-                    tpInjection = new VarPacketSizeFixInterval(numberCyclesPerFlit);
-                    break;
-                case 4: // Variable message interval - Fix message size
-                    tpInjection = new VarIntervalFixPacketSize(numberCyclesPerFlit);
-                    break;
-                case 5: // Variable burst size - Fix message interval
-                    tpInjection = new VarBurstFixInterval(numberCyclesPerFlit);
-                    break;
-                default: break;
-                }
-
-                // PARETO-based generation
-                if(flow.type > 0 && flow.type <= 5) {
-                    do {
-                        float r    = ((float) (rand()%10000)) / (10000.0);
-                        float ton  = pow( (float)(1-r),(-1.0/flow.parameter1) );
-                        float toff = pow( (float)(1-r),(-1.0/flow.parameter2) );
-                        // If function of probability is Pareto, it determines the required bw
-                        flow.required_bw = ton/(ton+toff);
-                        tpInjection->adjustFlow(flow);
-                    } while (flow.payload_length == 0);
-                }
+                this->nextPacketLength(flow);
+                flow.injection->prepareNextPacket(flow);
 
                 /////////////////////////////////////////////////////////////////
                 // EMULATING PROCESSING (IDLE INTERVAL BEFORE INJECTING A PACKET)
@@ -367,91 +509,33 @@ void FlowGenerator::p_SEND() {
                    // std::cout << std::endl << "FG " << FG_ID << " under congestion to send packets.";
                 }
                 // ZEFERINO
-                while ( i_CLK_CYCLES.read() < cycleToSendNextPacket) wait(); // Wait until the cycle to send the packet
+                while ( i_CLK_CYCLES.read() < cycleToSendNextPacket) { // Wait until the cycle to send the packet
+                    wait();
+                    if( PHASE_FILE != NULL && PHASE_SCHEDULE->phaseAt(i_CLK_CYCLES.read()) != currentPhase ) {
+                        break; // The phase has finished while the terminal was idle
+                    }
+                }
+                if( PHASE_FILE != NULL && PHASE_SCHEDULE->phaseAt(i_CLK_CYCLES.read()) != currentPhase ) {
+                    continue; // The packet is not sent - the next phase has its own flows
+                }
                 /////////////////////
                 // SENDING THE PACKET
                 /////////////////////
-                // SENDING PACKETS IN A BURST
-                if (flow.burst_size != 0) {
-                    // It sends a burst of packets
-                    this->sendBurst(flow,cycleToSendNextPacket);
-
-                    // It increments the packet counters and calculates when the first packet
-                    // of the next burst of packets have to be injected. But, if last_payload_length
-                    // equals 0, the last packet is not taken into account because it was not
-                    // actually sent
-                    if (flow.last_payload_length != 0) {
-                        // It increments the packet counters
-                        o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + flow.burst_size );
-                        flow.pck_sent += flow.burst_size;
-
-                        // It calculates when the first packet of the next burst of packets have to be injected
-                        cycleToSendNextPacket += ((flow.payload_length+HEADER_LENGTH) * numberCyclesPerFlit * (flow.burst_size - 1))
-                                + ((flow.last_payload_length+HEADER_LENGTH) * numberCyclesPerFlit);
-//ZEFERINO                            + flow[flow_index].idle;
-                    } else {
-                        // It increments the packet counters
-                        o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + flow.burst_size - 1);
-                        flow.pck_sent += flow.burst_size - 1;
-
-                        // It calculates when the first packet of the next burst of packets have to be injected
-                        cycleToSendNextPacket += ((flow.payload_length+HEADER_LENGTH) * numberCyclesPerFlit * (flow.burst_size - 1));
-//ZEFERINO                            + flow[flow_index].idle;
-                    }
-
-                    // SENDING PACKETS ONE BY ONE (NOT IN A BURST)
-                } else {
-                    unsigned short pckType = NORMAL; // By default - NORMAL packet - WORMHOLE uses normal
-                    // It sends the packet
-                    switch (flow.switching_type) {
-                    case CS :
-                        if (flow.pck_sent == 0) {
-                            // If it is first packet, it alocates the circuit
-                            pckType = ALOC;
-                        } else {
-                            if (flow.pck_sent == (flow.pck_2send-1)) {
-                                // If it is last packet, it releases the circuit
-                                pckType = RELEASE;
-                            } else {
-                                // If its not the first and neither the last packets, send it as a normal packet
-                                pckType = NORMAL;
-                            }
-                        }
-                        break;
+                this->injectFlow(flow,cycleToSendNextPacket);
 
-                    default : break;
-                    }
-                    this->sendPacket(flow,cycleToSendNextPacket,flow.payload_length,pckType);
-
-                    // It increments the packet counters
-                    o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + 1);
-                    flow.pck_sent++;
-
-                    // It calculates when the next packet have to be injected
-                    cycleToSendNextPacket += ((flow.payload_length+HEADER_LENGTH) * numberCyclesPerFlit);
-//ZEFERINO                        + flow[flow_index].idle;
-                }
                 // Deallocates the channel after send a packet or a burst
                 o_WRITE_SEND.write(0);
-                o_DATA_SEND.write(fNull);
+                o_PACKET_SEND.write(pNull);
 
-                // It increments the number of total packets sent
-                if (flow.burst_size != 0)
-                    packetsSent += flow.burst_size;
-                else
-                    packetsSent++;
+                this->updateFlowStatus(flow);
 
 // ZEFERINO
 //            // It inserts wait states until cycle_to_inject is reached
 //            while(clock_cycles.read() < cycle_to_send_next_pck) wait();
 
 // EDUARDO - Sending packets forever
-                if( packetsSent % totalPacketsToSend == 0 ) { // Old stop condition while(packetsSent < totalPacketsToSend)
-                    if( stopMethod != StopSim::AllPacketsDelivered ) {
-                        this->reloadFlows();
-                    } else {
-                        break;
-                    }
+                if( this->countPacketsSent(flow) ) {
+                    break;
                 }
 // EDUARDO - Sendind packets forever
 // EDUARDO - only store one packet on the source queue
@@ -468,6 +552,383 @@ void FlowGenerator::p_SEND() {
 
 }
 
+/*!
+ * \brief FlowGenerator::injectFlow It sends the next packet (or burst of
+ * packets) of a flow and calculates when the next packet can be injected.
+ */
+void FlowGenerator::injectFlow(FlowParameters &flow, unsigned long long &cycleToSendNextPacket) {
+    // SENDING PACKETS IN A BURST
+    if (flow.burst_size != 0) {
+        // It sends a burst of packets
+        this->sendBurst(flow,cycleToSendNextPacket);
+
+        // It increments the packet counters and calculates when the first packet
+        // of the next burst of packets have to be injected. But, if last_payload_length
+        // equals 0, the last packet is not taken into account because it was not
+        // actually sent
+        if (flow.last_payload_length != 0) {
+            // It increments the packet counters
+            o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + flow.burst_size );
+            flow.pck_sent += flow.burst_size;
+
+            // It calculates when the first packet of the next burst of packets have to be injected
+            cycleToSendNextPacket += ((flow.payload_length+HEADER_LENGTH) * numberCyclesPerFlit * (flow.burst_size - 1))
+                    + ((flow.last_payload_length+HEADER_LENGTH) * numberCyclesPerFlit);
+//ZEFERINO                            + flow[flow_index].idle;
+        } else {
+            // It increments the packet counters
+            o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + flow.burst_size - 1);
+            flow.pck_sent += flow.burst_size - 1;
+
+            // It calculates when the first packet of the next burst of packets have to be injected
+            cycleToSendNextPacket += ((flow.payload_length+HEADER_LENGTH) * numberCyclesPerFlit * (flow.burst_size - 1));
+//ZEFERINO                            + flow[flow_index].idle;
+        }
+
+        // SENDING PACKETS ONE BY ONE (NOT IN A BURST)
+    } else {
+        unsigned short pckType = NORMAL; // By default - NORMAL packet - WORMHOLE uses normal
+        // It sends the packet
+        switch (flow.switching_type) {
+        case CS :
+            if (flow.pck_sent == 0) {
+                // If it is first packet, it alocates the circuit
+                pckType = ALOC;
+            } else {
+                if (flow.pck_sent == (flow.pck_2send-1)) {
+                    // If it is last packet, it releases the circuit
+                    pckType = RELEASE;
+                } else {
+                    // If its not the first and neither the last packets, send it as a normal packet
+                    pckType = NORMAL;
+                }
+            }
+            break;
+
+        default : break;
+        }
+        this->sendPacket(flow,cycleToSendNextPacket,flow.payload_length,pckType);
+
+        // It increments the packet counters
+        o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + 1);
+        flow.pck_sent++;
+
+        // It calculates when the next packet have to be injected
+        cycleToSendNextPacket += ((flow.payload_length+HEADER_LENGTH) * numberCyclesPerFlit);
+//ZEFERINO                        + flow[flow_index].idle;
+    }
+}
+
+/*!
+ * \brief FlowGenerator::countPacketsSent It accounts the packets sent by a
+ * flow and reloads the flows when all the packets were sent.
+ * \return true if the terminal finished the transmission
+ */
+bool FlowGenerator::countPacketsSent(const FlowParameters &flow) {
+    // It increments the number of total packets sent
+    if (flow.burst_size != 0)
+        packetsSent += flow.burst_size;
+    else
+        packetsSent++;
+
+    if( PHASE_FILE == NULL && packetsSent % totalPacketsToSend == 0 ) { // Old stop condition while(packetsSent < totalPacketsToSend)
+        if( stopMethod != StopSim::AllPacketsDelivered ) {
+            this->reloadFlows();
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief FlowGenerator::startScheduledInjection It starts the open-loop
+ * injection driven by the injection scheduler instead of p_SEND.
+ * \param nextCycle Cycle on which the scheduler must call injectScheduled
+ * \return false if the terminal has nothing to send
+ */
+bool FlowGenerator::startScheduledInjection(unsigned long long cycle, unsigned long long &nextCycle) {
+    o_END_OF_TRANSMISSION.write(0);
+    o_NUMBER_OF_PACKETS_SENT.write(0);
+
+    scheduledFlow = NULL;
+    nextInjectionCycle = cycle;
+    packetsSent = 0;
+    if( flowSelector.totalWeight() == 0 ) {
+        o_END_OF_TRANSMISSION.write(1);
+        return false;
+    }
+    return this->injectScheduled(cycle,nextCycle);
+}
+
+/*!
+ * \brief FlowGenerator::injectScheduled It is the body of the open-loop
+ * injection of p_SEND without waits: the scheduler calls it only on the
+ * cycle the next packet is due (or every cycle while the source queue is
+ * not drained). The next flow is chosen as soon as a packet is sent, so
+ * the idle cycles are known in advance.
+ * \return false when the terminal finished the transmission
+ */
+bool FlowGenerator::injectScheduled(unsigned long long cycle, unsigned long long &nextCycle) {
+    if( scheduledFlow == NULL ) {
+        this->scheduleNextFlow();
+    }
+    if( cycle < nextInjectionCycle ) {
+        nextCycle = nextInjectionCycle;
+        return true;
+    }
+    if( u_FIFO->numberOfFlits() >= 2 ) { // Only store one packet on the source queue (as p_SEND)
+        nextCycle = cycle + 1;
+        return true;
+    }
+
+    FlowParameters& flow = *scheduledFlow;
+    this->injectFlow(flow,nextInjectionCycle);
+    this->updateFlowStatus(flow);
+    if( this->countPacketsSent(flow) ) {
+        o_END_OF_TRANSMISSION.write(1);
+        return false;
+    }
+
+    this->scheduleNextFlow();
+    nextCycle = nextInjectionCycle > cycle ? nextInjectionCycle : cycle + 1;
+    return true;
+}
+
+/*!
+ * \brief FlowGenerator::scheduleNextFlow It chooses the flow of the next
+ * packet and adds its idle cycles to the injection cycle.
+ */
+void FlowGenerator::scheduleNextFlow() {
+    scheduledFlow = &this->getFlow();
+    this->nextPacketLength(*scheduledFlow);
+    scheduledFlow->injection->prepareNextPacket(*scheduledFlow);
+    nextInjectionCycle += scheduledFlow->idle;
+}
+
+/*!
+ * \brief FlowGenerator::followPhaseSchedule It switches the flows when the
+ * phase of the schedule changes. The injection of the new phase starts on
+ * the current cycle, whatever the idle time left by the previous phase.
+ * \return false after the last phase
+ */
+bool FlowGenerator::followPhaseSchedule(unsigned long long &cycleToSendNextPacket) {
+    unsigned int phase = PHASE_SCHEDULE->phaseAt(i_CLK_CYCLES.read());
+    if( phase == currentPhase ) {
+        return true;
+    }
+    currentPhase = phase;
+    for( unsigned int i = 0; i < flows.size(); i++ ) {
+        this->refreshFlowWeight(i);
+    }
+    cycleToSendNextPacket = i_CLK_CYCLES.read();
+    return phase != PHASE_NONE;
+}
+
+/*!
+ * \brief FlowGenerator::replayTrace It injects the packets of the terminal
+ * in the cycles recorded in the trace. A packet is delayed only when the
+ * source queue is not drained, and it keeps its recorded creation cycle.
+ */
+void FlowGenerator::replayTrace() {
+
+    PacketDescriptor pNull;
+    PacketTrace::TraceRecord record;
+    unsigned long long injectionCycle;
+    FlowParameters flow = FlowParameters();
+
+    while( !PACKET_TRACE->finished(FG_ID) ) {
+        if( u_FIFO->numberOfFlits() < 2
+                && PACKET_TRACE->nextPacket(FG_ID,i_CLK_CYCLES.read(),record,injectionCycle) ) {
+            flow.destination = record.destination;
+            flow.traffic_class = record.trafficClass;
+            flow.payload_length = record.payloadLength;
+            this->sendPacket(flow,injectionCycle,record.payloadLength,NORMAL);
+
+            o_WRITE_SEND.write(0);
+            o_PACKET_SEND.write(pNull);
+            o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + 1);
+        } else {
+            wait();
+        }
+    }
+}
+
+/*!
+ * \brief FlowGenerator::runTaskGraph It injects the messages of the tasks
+ * mapped to the terminal as soon as the tasks finish. The tasks are released
+ * by the messages received (p_RECEIVE). It returns (EOT) only after the finish
+ * cycle of the last task of the terminal, so the run ends with the application.
+ */
+void FlowGenerator::runTaskGraph() {
+
+    PacketDescriptor pNull;
+    TaskGraph::Message message;
+    FlowParameters flow = FlowParameters();
+
+    while( !TASK_GRAPH->finished(FG_ID) ) {
+        if( u_FIFO->numberOfFlits() < 2
+                && TASK_GRAPH->nextMessage(FG_ID,i_CLK_CYCLES.read(),message) ) {
+            flow.destination = message.destination;
+            flow.payload_length = message.payloadLength;
+            this->sendPacket(flow,message.readyCycle,message.payloadLength,NORMAL,MSG_TASK,message.edge);
+
+            o_WRITE_SEND.write(0);
+            o_PACKET_SEND.write(pNull);
+            o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + 1);
+        } else {
+            wait();
+        }
+    }
+}
+
+/*!
+ * \brief FlowGenerator::runClosedLoop Closed-loop traffic: the flows send
+ * requests and each request received is answered by a reply after the
+ * service delay. A flow stalls when the number of its requests waiting for
+ * the reply reaches the limit of outstanding requests.
+ */
+void FlowGenerator::runClosedLoop() {
+
+    PacketDescriptor pNull;
+    FlowParameters* request = NULL;     // Next request - waiting its injection cycle
+    unsigned long long cycleToSendNextRequest = i_CLK_CYCLES.read();
+    unsigned long long requestsSent = 0;
+    bool requestsFinished = (totalPacketsToSend == 0);
+
+    while( true ) {
+        bool sent = false;
+        unsigned long long cycle = i_CLK_CYCLES.read();
+
+        if( u_FIFO->numberOfFlits() < 2 ) { // Only store one packet on the source queue (as the open-loop)
+            if( !pendingReplies.empty() && pendingReplies.front().readyCycle <= cycle ) {
+                // The replies have priority over the requests
+                PendingReply reply = pendingReplies.front();
+                pendingReplies.pop_front();
+
+                FlowParameters flow = FlowParameters();
+                flow.destination = reply.destination;
+                flow.flow_id = reply.flowId;
+                flow.traffic_class = reply.trafficClass;
+                this->sendPacket(flow,reply.readyCycle,REPLY_LENGTH,NORMAL,MSG_REPLY,reply.requestId);
+                sent = true;
+            } else if( !requestsFinished ) {
+                if( request == NULL && flowSelector.totalWeight() > 0 ) {
+                    request = &this->getFlow();
+                    this->nextPacketLength(*request);
+                    request->injection->prepareNextPacket(*request);
+                    // A stalled source does not accumulate injection slots to be used after the reply
+                    if( cycleToSendNextRequest < cycle ) {
+                        cycleToSendNextRequest = cycle;
+                    }
+                    cycleToSendNextRequest += request->idle;
+                }
+
+                if( request != NULL && cycle >= cycleToSendNextRequest ) {
+                    unsigned int flowIndex = (unsigned int) (request - &flows[0]);
+                    unsigned long requestId = this->sendPacket(*request,cycleToSendNextRequest,
+                                                               request->payload_length,NORMAL,MSG_REQUEST);
+                    OutstandingRequest outstanding;
+                    outstanding.flowIndex = flowIndex;
+                    outstanding.issueCycle = cycleToSendNextRequest;
+                    outstandingRequests[requestId] = outstanding;
+                    outstandingPerFlow[flowIndex]++;
+
+                    request->pck_sent++;
+                    this->updateFlowStatus(*request);
+                    cycleToSendNextRequest += ((request->payload_length+HEADER_LENGTH) * numberCyclesPerFlit);
+                    request = NULL;
+                    sent = true;
+
+                    if( ++requestsSent % totalPacketsToSend == 0 ) {
+                        if( stopMethod != StopSim::AllPacketsDelivered ) {
+                            this->reloadFlows();
+                        } else {
+                            requestsFinished = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        if( sent ) {
+            o_WRITE_SEND.write(0);
+            o_PACKET_SEND.write(pNull);
+            o_NUMBER_OF_PACKETS_SENT.write( o_NUMBER_OF_PACKETS_SENT.read() + 1);
+        } else {
+            if( requestsFinished && outstandingRequests.empty() ) {
+                o_END_OF_TRANSMISSION.write(1); // All the requests replied - keep replying the other terminals
+            }
+            wait();
+        }
+    }
+}
+
+/*!
+ * \brief FlowGenerator::receiveClosedLoop It schedules the reply of a
+ * request received or it completes the transaction of a reply received.
+ */
+void FlowGenerator::receiveClosedLoop(unsigned short messageType,
+                                      unsigned short source,
+                                      unsigned short flowId,
+                                      unsigned short trafficClass,
+                                      unsigned long requestId) {
+
+    unsigned long long cycle = i_CLK_CYCLES.read();
+
+    if( messageType == MSG_REQUEST ) {
+        PendingReply reply;
+        reply.readyCycle = cycle + SERVICE_DELAY;
+        reply.destination = source;
+        reply.flowId = flowId;
+        reply.trafficClass = trafficClass;
+        reply.requestId = requestId;
+        pendingReplies.push_back(reply);
+    } else if( messageType == MSG_REPLY ) {
+        std::unordered_map<unsigned long,OutstandingRequest>::iterator it = outstandingRequests.find(requestId);
+        if( it == outstandingRequests.end() ) {
+            std::cout << "\n[FlowGenerator] WARNING: FG " << FG_ID << " received a reply of an unknown request ("
+                      << requestId << ")." << std::endl;
+            return;
+        }
+        unsigned int flowIndex = it->second.flowIndex;
+        unsigned long long rtt = cycle - it->second.issueCycle;
+        outstandingRequests.erase(it);
+
+        RoundTripStats& stats = roundTrip[flowIndex];
+        if( stats.replies == 0 || rtt < stats.min ) {
+            stats.min = rtt;
+        }
+        if( rtt > stats.max ) {
+            stats.max = rtt;
+        }
+        stats.sum += rtt;
+        stats.replies++;
+
+        outstandingPerFlow[flowIndex]--;
+        this->refreshFlowWeight(flowIndex); // The flow may be stalled by the limit of outstanding requests
+    }
+}
+
+/*!
+ * \brief FlowGenerator::writeClosedLoopReport It writes the round-trip
+ * latency of each flow of the terminal.
+ */
+void FlowGenerator::writeClosedLoopReport(FILE *out) const {
+    for( unsigned int i = 0; i < flows.size(); i++ ) {
+        const RoundTripStats& stats = roundTrip[i];
+        fprintf(out,"%4u\t%4u\t%4u\t%10lu\t%10lu\t%6u\t",
+                FG_ID, flows[i].flow_id, flows[i].destination,
+                flows[i].pck_sent, stats.replies, outstandingPerFlow[i]);
+        if( stats.replies > 0 ) {
+            fprintf(out,"%10.2f\t%10llu\t%10llu\n",
+                    (double) stats.sum / stats.replies, stats.min, stats.max);
+        } else {
+            fprintf(out,"%10s\t%10s\t%10s\n","-","-","-");
+        }
+    }
+}
+
 void FlowGenerator::p_RECEIVE() {
     o_READ_RECEIVE.write(1);
     o_NUMBER_OF_PACKETS_RECEIVED.write(0);
@@ -475,17 +936,41 @@ void FlowGenerator::p_RECEIVE() {
 
     UIntVar data;
     bool trailer;
-    //    bool header;
+    bool header;
     Flit f;
+
+    // Fields of the header of the packet being received (closed-loop and task graph traffic)
+    unsigned short messageType = MSG_OPEN_LOOP;
+    unsigned short source = 0;
+    unsigned short flowId = 0;
+    unsigned short trafficClass = 0;
     while(1) {
         f = i_DATA_RECEIVE.read();
         data = f.data;
         trailer = data[FLIT_WIDTH-1];
-        //        header = data[FLIT_WIDTH-2];
+        header = data[FLIT_WIDTH-2];
+
+        if( (CLOSED_LOOP || TASK_GRAPH_FILE != NULL) && (i_READ_OK_RECEIVE.read()==1) && header ) {
+            messageType = data.range(MSG_TYPE_POS,MSG_TYPE_POS-1).to_uint();
+            source = this->getHeaderSource(data);
+            flowId = data.range(FID_POS,FID_POS-1).to_uint();
+            trafficClass = data.range(CLS_POS,CLS_POS-2).to_uint();
+        }
 
         if ((i_READ_OK_RECEIVE.read()==1) && trailer) {
             o_NUMBER_OF_PACKETS_RECEIVED.write(o_NUMBER_OF_PACKETS_RECEIVED.read() + 1);
             //            std::cout << "\nFG " << FG_ID << " - received: " << number_of_packets_received << " @ " << sc_time_stamp();
+            if( TASK_GRAPH_FILE != NULL && messageType == MSG_TASK ) {
+                // The trailer carries the edge of the task graph - it may release the target task
+                TASK_GRAPH->messageArrived(data.range(FLIT_WIDTH-3,0).to_uint(),i_CLK_CYCLES.read());
+            } else if( PHASE_FILE != NULL ) {
+                // The trailer carries the packet id (open-loop traffic)
+                PHASE_SCHEDULE->packetDelivered(data.range(FLIT_WIDTH-3,0).to_ulong(),i_CLK_CYCLES.read());
+            } else if( CLOSED_LOOP ) {
+                // The trailer carries the packet id of a request or the id of the request replied
+                this->receiveClosedLoop(messageType,source,flowId,trafficClass,
+                                        data.range(FLIT_WIDTH-3,0).to_ulong());
+            }
         }
         wait();
     }
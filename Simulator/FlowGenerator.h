@@ -7,6 +7,11 @@
 #include "DestinationGenerator.h"
 #include "../StopSim/StopSim.h"
 #include "UnboundedFifo.h"
+#include "FlowSelector.h"
+#include "../Parameters/RandomStream.h"
+
+#include <deque>
+#include <unordered_map>
 
 // Switching types
 #define WH 0
@@ -18,10 +23,20 @@
 #define RELEASE 2
 #define GRANT   3
 
+// Message type (closed-loop and task graph traffic)
+#define MSG_OPEN_LOOP 0
+#define MSG_REQUEST   1
+#define MSG_REPLY     2
+#define MSG_TASK      3 // Message between two tasks of the application graph
+
 #define HEADER_LENGTH 1
+#define MSG_TYPE_POS 23 // Position of the message type in the header (2 bits, free in 2D and 3D formats)
 
 #define TRAFFIC_FILENAME "traffic.tcf"
 
+class TypeInjection;
+class PacketSizeDistribution;
+
 class FlowGenerator : public SoCINModule  {
 public:
     StopSim::StopMethod stopMethod;
@@ -41,10 +56,13 @@ public:
         unsigned int  iat;                  //  9: Inter-arrival time
         unsigned int  burst_size;           // 10: Number of packets in a burst transmission
         unsigned int  last_payload_length;  // 11: Number of flits in the payload (including the trailer) of the last packet in a burst
-        float         parameter1;           // 12: Additional parameter for TG-based trafic modelling (e.g.alfa_on in Pareto)
-        float         parameter2;           // 13: Additional parameter for TG-based trafic modelling (e.g.alfa_off in Pareto)
+        float         parameter1;           // 12: Additional parameter for TG-based trafic modelling (e.g.alfa_on in Pareto, Hurst exponent, MMPP low-to-high rate)
+        float         parameter2;           // 13: Additional parameter for TG-based trafic modelling (e.g.alfa_off in Pareto, number of sources, MMPP high-to-low rate)
         unsigned int  switching_type;       // 14: Switching type
         unsigned long pck_sent;             // 15: Status about the number of packets already sent
+        TypeInjection* injection;           // 16: Injection process of the flow (bound to the type when the flow is read)
+        PacketSizeDistribution* sizeDistribution; // 17: Empirical payload length distribution (optional - "cdf" or "cdf_file" after the flow)
+        unsigned int  phase;                // 18: Phase of the schedule in which the flow sends packets (0 without schedule)
     };
 
     // INTERFACE
@@ -54,10 +72,9 @@ public:
     sc_in<unsigned long long> i_CLK_CYCLES;
 
     // Interface to the VCs of the communication port (its is done by means of FIFOs)
-    sc_out<Flit>  o_DATA_SEND;          // I/F with the output FIFO
+    sc_out<PacketDescriptor> o_PACKET_SEND; // I/F with the output FIFO (a whole packet per write)
     sc_out<bool>  o_WRITE_SEND;
     sc_in<bool>   i_WRITE_OK_SEND;
-    sc_vector<sc_out<bool> > o_VC_SEND; // Virtual channel selector
     sc_in<Flit>   i_DATA_RECEIVE;       // I/F with the input FIFO
     sc_in<bool>   i_READ_OK_RECEIVE;
     sc_out<bool>  o_READ_RECEIVE;
@@ -77,13 +94,32 @@ public:
 
     // Auxiliar functions
     UIntVar getHeaderAddresses(unsigned short src, unsigned short destination);
-    void sendFlit(Flit flit, unsigned short virtualChannel);
-    void sendPacket(FlowParameters flowParam, unsigned long long cycleToSend,
-                    unsigned long payloadLength, unsigned short packetType);
+    unsigned short getHeaderSource(const UIntVar& header);
+    unsigned long sendPacket(FlowParameters flowParam, unsigned long long cycleToSend,
+                             unsigned long payloadLength, unsigned short packetType,
+                             unsigned short messageType = MSG_OPEN_LOOP, unsigned long requestId = 0);
     void sendBurst(FlowParameters flowParam, unsigned long long cycleToSend);
-
-    bool readTrafficFile();
+    void injectFlow(FlowParameters& flow, unsigned long long& cycleToSendNextPacket);
+    bool countPacketsSent(const FlowParameters& flow);
+    void replayTrace();
+    void runClosedLoop();
+    void runTaskGraph();
+    void receiveClosedLoop(unsigned short messageType, unsigned short source, unsigned short flowId,
+                           unsigned short trafficClass, unsigned long requestId);
+
+    // Open-loop injection driven by the injection scheduler (instead of p_SEND)
+    bool startScheduledInjection(unsigned long long cycle, unsigned long long& nextCycle);
+    bool injectScheduled(unsigned long long cycle, unsigned long long& nextCycle);
+
+    void writeClosedLoopReport(FILE* out) const;
+
+    bool readTrafficFile(const char* fileName, unsigned int phase);
+    bool followPhaseSchedule(unsigned long long& cycleToSendNextPacket);
+    bool readSizeDistribution(FILE* trafficFile, FlowParameters& flow, unsigned int flowIndex);
+    void nextPacketLength(FlowParameters& flow);
     void reloadFlows();
+    void updateFlowStatus(FlowParameters& flow);
+    void refreshFlowWeight(unsigned int flowIndex);
 
     SC_HAS_PROCESS(FlowGenerator);
     FlowGenerator(sc_module_name mn,
@@ -94,7 +130,7 @@ public:
     ModuleType moduleType() const { return SoCINModule::TFlowGenerator; }
     const char* moduleName() const { return "FlowGenerator"; }
 
-    ~FlowGenerator() {}
+    ~FlowGenerator();
 
     inline unsigned long getTotalPacketsToSend() const { return this->totalPacketsToSend; }
 
@@ -105,13 +141,43 @@ private:
     INoC::TopologyType topologyType;    // Topology type to identify the header addressing format
     unsigned short FG_ID;               // Flow generator identifier
     unsigned short numberCyclesPerFlit; // Number of cycles to transmit a flit in the link on the flow control used
-    unsigned short vcWidth;             // Virtual channel selector width
     std::vector<FlowParameters> flows;  // Flows from the descriptor on the traffic configuration file
+    std::vector<unsigned long long> flowWeights; // Selection weight of each flow with packets to send
+    FlowSelector flowSelector;          // Flows that still have packets to send
 
-    std::default_random_engine randomGenerator;
-    std::uniform_int_distribution<int> uniformRandom;
+    RandomStream flowRandom;            // Stream to choose the flow of the next packet
 
     unsigned long totalPacketsToSend;
+    unsigned int currentPhase;          // Phase of the schedule running (PHASE_NONE without schedule)
+    unsigned long long packetsSent;     // Packets sent since the flows were (re)loaded
+
+    // Injection scheduler
+    FlowParameters* scheduledFlow;      // Flow of the next packet (NULL: not chosen yet)
+    unsigned long long nextInjectionCycle;
+    void scheduleNextFlow();
+
+    // Closed-loop traffic
+    struct OutstandingRequest {         // Request waiting for the reply
+        unsigned int flowIndex;
+        unsigned long long issueCycle;
+    };
+    struct PendingReply {               // Reply waiting for the service delay or the source queue
+        unsigned long long readyCycle;
+        unsigned short destination;
+        unsigned short flowId;
+        unsigned short trafficClass;
+        unsigned long requestId;
+    };
+    struct RoundTripStats {             // Round-trip latency of the requests of a flow
+        unsigned long replies;
+        unsigned long long sum;
+        unsigned long long min;
+        unsigned long long max;
+    };
+    std::unordered_map<unsigned long,OutstandingRequest> outstandingRequests;
+    std::vector<unsigned int> outstandingPerFlow;
+    std::deque<PendingReply> pendingReplies;
+    std::vector<RoundTripStats> roundTrip;
 
     DestinationGenerator* destGen;
 };
@@ -0,0 +1,38 @@
+#include "FlowSelector.h"
+
+FlowSelector::FlowSelector()
+    : total(0), highestStep(0)
+{}
+
+void FlowSelector::resize(unsigned int numberOfFlows) {
+    weights.assign(numberOfFlows,0);
+    tree.assign(numberOfFlows+1,0);
+    total = 0;
+    highestStep = 1;
+    while( (highestStep << 1) <= numberOfFlows ) {
+        highestStep <<= 1;
+    }
+}
+
+void FlowSelector::setWeight(unsigned int flow, unsigned long long weight) {
+    // The tree only stores sums, so the difference is added to each covering node
+    unsigned long long previous = weights[flow];
+    weights[flow] = weight;
+    total = total - previous + weight;
+    for( unsigned int i = flow + 1; i < tree.size(); i += i & (~i + 1) ) {
+        tree[i] = tree[i] - previous + weight;
+    }
+}
+
+unsigned int FlowSelector::select(unsigned long long position) const {
+    // Descend the tree looking for the last node whose prefix sum is <= position
+    unsigned int node = 0;
+    for( unsigned int step = highestStep; step > 0; step >>= 1 ) {
+        unsigned int next = node + step;
+        if( next < tree.size() && tree[next] <= position ) {
+            node = next;
+            position -= tree[next];
+        }
+    }
+    return node; // 1-based node next to the prefix == 0-based flow index
+}
@@ -0,0 +1,47 @@
+#ifndef __FLOWSELECTOR_H__
+#define __FLOWSELECTOR_H__
+
+#include <vector>
+
+/*!
+ * \brief The FlowSelector class chooses the next flow of a Flow Generator
+ * among the flows that still have packets to send, proportionally to their
+ * weights.
+ *
+ * The weights are kept in a Fenwick (binary indexed) tree, so removing an
+ * exhausted flow and selecting a flow cost O(log n) with no rejections.
+ */
+class FlowSelector {
+public:
+    FlowSelector();
+
+    void resize(unsigned int numberOfFlows);
+
+    /*!
+     * \brief setWeight Change the weight of a flow. Zero removes the flow
+     * from the selection.
+     */
+    void setWeight(unsigned int flow, unsigned long long weight);
+
+    inline unsigned long long getWeight(unsigned int flow) const { return weights[flow]; }
+
+    /*!
+     * \brief totalWeight Sum of the weights of all the flows
+     */
+    inline unsigned long long totalWeight() const { return total; }
+
+    /*!
+     * \brief select Get the flow which owns the position in the cumulative weight
+     * \param position A value in the range [0,totalWeight())
+     * \return The flow index
+     */
+    unsigned int select(unsigned long long position) const;
+
+private:
+    std::vector<unsigned long long> weights; // Weight of each flow
+    std::vector<unsigned long long> tree;    // Fenwick tree (1-based) of the weights
+    unsigned long long total;
+    unsigned int highestStep;                // Highest power of 2 <= number of flows
+};
+
+#endif // __FLOWSELECTOR_H__
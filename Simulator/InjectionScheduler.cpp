@@ -0,0 +1,62 @@
+#include "InjectionScheduler.h"
+#include "FlowGenerator.h"
+
+InjectionScheduler::InjectionScheduler(sc_module_name mn)
+    : SoCINModule(mn),
+      i_CLK("InjectionScheduler_iCLK"),
+      i_RST("InjectionScheduler_iRST"),
+      i_CLK_CYCLES("InjectionScheduler_iCLK_CYCLES"),
+      calendar(CALENDAR_BUCKETS),
+      started(false)
+{
+    SC_METHOD(p_SCHEDULE);
+    sensitive << i_CLK.pos();
+    dont_initialize();
+}
+
+void InjectionScheduler::schedule(unsigned int generator, unsigned long long cycle) {
+    Entry e;
+    e.cycle = cycle;
+    e.generator = generator;
+    calendar[cycle & (CALENDAR_BUCKETS-1)].push_back(e);
+}
+
+void InjectionScheduler::p_SCHEDULE() {
+
+    unsigned long long cycle = i_CLK_CYCLES.read();
+    unsigned long long nextCycle;
+
+    if( i_RST.read() ) {
+        for( unsigned int i = 0; i < calendar.size(); i++ ) {
+            calendar[i].clear();
+        }
+        started = false;
+        return;
+    }
+
+    if( !started ) { // First cycle after the reset - as p_SEND, the injection starts now
+        started = true;
+        for( unsigned int i = 0; i < generators.size(); i++ ) {
+            if( generators[i]->startScheduledInjection(cycle,nextCycle) ) {
+                this->schedule(i,nextCycle);
+            }
+        }
+        return;
+    }
+
+    // The entries of the bucket due on a later turn of the calendar are kept
+    std::vector<Entry>& bucket = calendar[cycle & (CALENDAR_BUCKETS-1)];
+    if( bucket.empty() ) {
+        return;
+    }
+    dueEntries.swap(bucket);
+    for( unsigned int i = 0; i < dueEntries.size(); i++ ) {
+        const Entry& e = dueEntries[i];
+        if( e.cycle > cycle ) {
+            bucket.push_back(e);
+        } else if( generators[e.generator]->injectScheduled(cycle,nextCycle) ) {
+            this->schedule(e.generator,nextCycle);
+        }
+    }
+    dueEntries.clear();
+}
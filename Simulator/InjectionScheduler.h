@@ -0,0 +1,55 @@
+#ifndef __INJECTIONSCHEDULER_H__
+#define __INJECTIONSCHEDULER_H__
+
+#include "../SoCINModule.h"
+
+#include <vector>
+
+#define CALENDAR_BUCKETS 1024 // Cycles covered by one turn of the calendar (power of 2)
+
+class FlowGenerator;
+
+/*!
+ * \brief The InjectionScheduler class drives the open-loop injection of all
+ * the flow generators from a single process, instead of one thread per
+ * terminal that wakes up every cycle.
+ *
+ * The next injection cycle of each terminal is kept in a calendar queue
+ * (one bucket per cycle, modulo CALENDAR_BUCKETS), so a clock edge only
+ * visits the terminals with a packet due on that cycle.
+ */
+class InjectionScheduler : public SoCINModule {
+public:
+    // System signals
+    sc_in<bool>          i_CLK;
+    sc_in<bool>          i_RST;
+    sc_in<unsigned long long> i_CLK_CYCLES;
+
+    void addGenerator(FlowGenerator* generator) { generators.push_back(generator); }
+
+    // Module's process
+    void p_SCHEDULE();
+
+    SC_HAS_PROCESS(InjectionScheduler);
+    InjectionScheduler(sc_module_name mn);
+
+    ModuleType moduleType() const { return SoCINModule::TFlowGenerator; }
+    const char* moduleName() const { return "InjectionScheduler"; }
+
+    ~InjectionScheduler() {}
+
+private:
+    struct Entry {
+        unsigned long long cycle;   // Injection cycle
+        unsigned int generator;     // Index of the flow generator
+    };
+
+    std::vector<FlowGenerator*> generators;
+    std::vector<std::vector<Entry> > calendar;  // Buckets of the calendar queue
+    std::vector<Entry> dueEntries;              // Bucket being visited
+    bool started;
+
+    void schedule(unsigned int generator, unsigned long long cycle);
+};
+
+#endif // __INJECTIONSCHEDULER_H__
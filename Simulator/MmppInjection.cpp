@@ -0,0 +1,67 @@
+#include "MmppInjection.h"
+
+#include <cmath>
+
+REGISTER_TYPE_INJECTION(7,MmppInjection)
+
+MmppInjection::MmppInjection(unsigned short numCyclesPerFlit)
+    : ArrivalProcessInjection(numCyclesPerFlit),
+      initialized(false), high(true), sojourn(0),
+      rateLowToHigh(0), rateHighToLow(0), arrivalRate(0)
+{}
+
+void MmppInjection::initialize(FlowGenerator::FlowParameters &flow) {
+
+    float load = flow.required_bw > 0.0f ? flow.required_bw : 0.01f;
+    rateLowToHigh = flow.parameter1;
+    rateHighToLow = flow.parameter2;
+
+    double highLoad = load;
+    if( rateLowToHigh > 0 && rateHighToLow > 0 ) {
+        // The process is in the high state r01/(r01+r10) of the time
+        highLoad = load * (rateLowToHigh + rateHighToLow) / rateLowToHigh;
+        if( highLoad > 1.0 ) {
+            std::cout << "\n[MmppInjection] WARNING: The load in the high state exceeds the channel bandwidth"
+                         " - limited to 1 (mean load: " << rateLowToHigh / (rateLowToHigh + rateHighToLow)
+                      << ")" << std::endl;
+            highLoad = 1.0;
+        }
+    } else {
+        rateHighToLow = 0; // Without transitions, it is a Poisson process
+    }
+    arrivalRate = highLoad / this->packetCycles(flow);
+
+    // The initial state follows the stationary distribution
+    high = (rateHighToLow == 0) || random.uniform() < rateLowToHigh / (rateLowToHigh + rateHighToLow);
+    sojourn = high ? (rateHighToLow > 0 ? this->exponential(rateHighToLow) : HUGE_VAL)
+                   : this->exponential(rateLowToHigh);
+    initialized = true;
+}
+
+void MmppInjection::sampleArrivals(FlowGenerator::FlowParameters &flow, double *gaps, unsigned int n) {
+
+    if( !initialized ) {
+        this->initialize(flow);
+    }
+
+    for( unsigned int g = 0; g < n; g++ ) {
+        double gap = 0;
+        while( true ) {
+            if( !high ) {   // No arrivals in the low state
+                gap += sojourn;
+                high = true;
+                sojourn = this->exponential(rateHighToLow);
+            }
+            double next = this->exponential(arrivalRate); // Memoryless - sampled again after a state change
+            if( next < sojourn ) {
+                sojourn -= next;
+                gap += next;
+                break;
+            }
+            gap += sojourn;
+            high = false;
+            sojourn = this->exponential(rateLowToHigh);
+        }
+        gaps[g] = gap;
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef __MMPPINJECTION_H__
+#define __MMPPINJECTION_H__
+
+#include "ArrivalProcessInjection.h"
+
+/*!
+ * \brief The MmppInjection class generates traffic by a two-state
+ * Markov-modulated Poisson process, in which the low state is silent
+ * (Interrupted Poisson Process).
+ *
+ * The packets arrive as a Poisson process in the high state, and the
+ * arrival rate is chosen so the mean load is the flow required_bw.
+ *  - parameter1: Transition rate from the low to the high state (per cycle)
+ *  - parameter2: Transition rate from the high to the low state (per cycle)
+ */
+class MmppInjection : public ArrivalProcessInjection {
+public:
+    MmppInjection(unsigned short numCyclesPerFlit);
+
+protected:
+    void sampleArrivals(FlowGenerator::FlowParameters& flow, double* gaps, unsigned int n);
+
+private:
+    bool   initialized;
+    bool   high;            // Current state
+    double sojourn;         // Remaining time in the current state
+    double rateLowToHigh;
+    double rateHighToLow;
+    double arrivalRate;     // Packets per cycle in the high state
+
+    void initialize(FlowGenerator::FlowParameters& flow);
+};
+
+#endif // __MMPPINJECTION_H__
@@ -0,0 +1,100 @@
+#include "PacketSizeDistribution.h"
+
+#include <iostream>
+
+PacketSizeDistribution::PacketSizeDistribution(const RandomStream &stream)
+    : random(stream)
+{}
+
+bool PacketSizeDistribution::addEntry(unsigned int length, double cumulative) {
+    double previous = 0;
+    for( unsigned int i = 0; i < weights.size(); i++ ) {
+        previous += weights[i];
+    }
+    if( length == 0 || cumulative < previous || cumulative > 1.0 + 1e-6 ) {
+        printf("\n[PacketSizeDistribution] ERROR: Invalid entry (length: %u, cumulative probability: %f)."
+               "\nThe lengths must be positive and the probabilities non-decreasing until 1.",
+               length,cumulative);
+        return false;
+    }
+    lengths.push_back(length);
+    weights.push_back(cumulative - previous);
+    return true;
+}
+
+bool PacketSizeDistribution::readTable(FILE *file, unsigned int n) {
+    for( unsigned int i = 0; i < n; i++ ) {
+        unsigned int length;
+        double cumulative;
+        if( fscanf(file,"%u %lf",&length,&cumulative) != 2 ) {
+            printf("\n[PacketSizeDistribution] ERROR: The CDF table has less than %u entries.",n);
+            return false;
+        }
+        if( !this->addEntry(length,cumulative) ) {
+            return false;
+        }
+    }
+    return this->build();
+}
+
+bool PacketSizeDistribution::readFile(const char *fileName) {
+    FILE* file;
+    if( (file = fopen(fileName,"rt")) == NULL ) {
+        printf("\n[PacketSizeDistribution] ERROR: Impossible to open the CDF file \"%s\".",fileName);
+        return false;
+    }
+    unsigned int length;
+    double cumulative;
+    bool ok = true;
+    while( ok && fscanf(file,"%u %lf",&length,&cumulative) == 2 ) {
+        ok = this->addEntry(length,cumulative);
+    }
+    fclose(file);
+    return ok && this->build();
+}
+
+/*!
+ * \brief PacketSizeDistribution::build It builds the alias table. Bins with
+ * less than the average probability are completed by an alias from the bins
+ * with more than the average.
+ */
+bool PacketSizeDistribution::build() {
+
+    unsigned int n = (unsigned int) weights.size();
+    double total = 0;
+    for( unsigned int i = 0; i < n; i++ ) {
+        total += weights[i];
+    }
+    if( n == 0 || total <= 0 ) {
+        printf("\n[PacketSizeDistribution] ERROR: Empty packet size distribution.");
+        return false;
+    }
+
+    probability.assign(n,1.0);
+    alias.resize(n);
+    std::vector<double> scaled(n);
+    std::vector<unsigned int> small, large;
+    for( unsigned int i = 0; i < n; i++ ) {
+        alias[i] = i;
+        scaled[i] = weights[i] * n / total; // Normalized, so the last cumulative probability need not be exactly 1
+        if( scaled[i] < 1.0 ) {
+            small.push_back(i);
+        } else {
+            large.push_back(i);
+        }
+    }
+    while( !small.empty() && !large.empty() ) {
+        unsigned int s = small.back();
+        small.pop_back();
+        unsigned int l = large.back();
+        probability[s] = scaled[s];
+        alias[s] = l;
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if( scaled[l] < 1.0 ) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // The remaining bins have probability 1 (apart from rounding errors)
+    return true;
+}
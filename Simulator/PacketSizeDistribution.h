@@ -0,0 +1,51 @@
+#ifndef __PACKETSIZEDISTRIBUTION_H__
+#define __PACKETSIZEDISTRIBUTION_H__
+
+#include "../Parameters/RandomStream.h"
+
+#include <vector>
+#include <cstdio>
+
+/*!
+ * \brief The PacketSizeDistribution class is an empirical distribution of
+ * the payload length of the packets of a flow.
+ *
+ * It is built from a CDF table (pairs of payload length and cumulative
+ * probability) and it is sampled in O(1) by the alias method (Vose, 1991).
+ */
+class PacketSizeDistribution {
+public:
+    PacketSizeDistribution(const RandomStream& stream);
+
+    /*!
+     * \brief readTable It reads a CDF table with n entries "length probability"
+     * \return false if the table is not valid
+     */
+    bool readTable(FILE* file, unsigned int n);
+
+    /*!
+     * \brief readFile It reads a CDF table from a file, one entry per line
+     * \return false if the file cannot be read or the table is not valid
+     */
+    bool readFile(const char* fileName);
+
+    /*!
+     * \brief sample Payload length of the next packet
+     */
+    inline unsigned int sample() {
+        unsigned int bin = random.uniformInt((unsigned int) lengths.size());
+        return random.uniform() < probability[bin] ? lengths[bin] : lengths[alias[bin]];
+    }
+
+private:
+    RandomStream random;
+    std::vector<unsigned int> lengths;  // Payload length of each bin
+    std::vector<double> weights;        // Probability of each length (from the CDF)
+    std::vector<double> probability;    // Probability of keeping the bin (alias table)
+    std::vector<unsigned int> alias;    // Alternative bin (alias table)
+
+    bool addEntry(unsigned int length, double cumulative);
+    bool build();
+};
+
+#endif // __PACKETSIZEDISTRIBUTION_H__
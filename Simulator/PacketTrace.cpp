@@ -0,0 +1,306 @@
+#include "PacketTrace.h"
+#include "../Parameters/Parameters.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(__WIN32__) || defined(_WIN32)
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#define TRACE_MAGIC "SNPT"
+#define TRACE_VERSION 1
+#define TRACE_WINDOW_RECORDS (1 << 20) // 16 MB mapped at once
+#define TRACE_CURSOR_RECORDS 4096      // Records read ahead for a terminal that has not injected them yet
+#define TRACE_NO_SKIP ((uint64_t) -1)
+
+PacketTrace* PacketTrace::trace = 0;
+
+PacketTrace* PacketTrace::instance() {
+    if( !trace ) {
+        trace = new PacketTrace();
+        if( REPLAY_FILE != NULL ) {
+            trace->open(REPLAY_FILE);
+        }
+    }
+    return trace;
+}
+
+PacketTrace::PacketTrace()
+    : fileDescriptor(-1),
+      numberOfRecords(0),
+      nextRecord(0),
+      timeScale(REPLAY_TIME_SCALE),
+      windowBase(NULL),
+      windowLength(0),
+      windowRecords(NULL),
+      windowFirst(0),
+      windowCount(0),
+      windowCapacity(TRACE_WINDOW_RECORDS),
+      mappingHandle(NULL),
+      lastCycleAdvanced(0)
+{}
+
+PacketTrace::~PacketTrace() {
+    this->unmapWindow();
+    this->closeFile();
+}
+
+void PacketTrace::closeFile() {
+#if defined(__WIN32__) || defined(_WIN32)
+    if( mappingHandle != NULL ) {
+        CloseHandle((HANDLE) mappingHandle);
+        mappingHandle = NULL;
+    }
+#endif
+    if( fileDescriptor >= 0 ) {
+        close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+}
+
+bool PacketTrace::open(const char *fileName) {
+
+#if defined(__WIN32__) || defined(_WIN32)
+    fileDescriptor = ::_open(fileName,_O_RDONLY | _O_BINARY);
+#else
+    fileDescriptor = ::open(fileName,O_RDONLY);
+#endif
+    if( fileDescriptor < 0 ) {
+        printf("\n[PacketTrace] ERROR: Impossible to open trace file \"%s\".",fileName);
+        return false;
+    }
+
+    TraceHeader header;
+#if defined(__WIN32__) || defined(_WIN32)
+    struct _stati64 fileStatus; // 64-bit size - traces larger than 2 GB
+    bool statusOk = _fstati64(fileDescriptor,&fileStatus) == 0;
+#else
+    struct stat fileStatus;
+    bool statusOk = fstat(fileDescriptor,&fileStatus) == 0;
+#endif
+    if( read(fileDescriptor,&header,sizeof(header)) != (int) sizeof(header)
+            || strncmp(header.magic,TRACE_MAGIC,4) != 0
+            || header.version != TRACE_VERSION
+            || !statusOk
+            || (uint64_t) fileStatus.st_size < sizeof(header) + header.numberOfRecords * sizeof(TraceRecord) ) {
+        printf("\n[PacketTrace] ERROR: \"%s\" is not a valid packet trace (version %d).",fileName,TRACE_VERSION);
+        this->closeFile();
+        return false;
+    }
+
+#if defined(__WIN32__) || defined(_WIN32)
+    // The views of the windows are created from a single mapping of the file
+    mappingHandle = CreateFileMappingA((HANDLE) _get_osfhandle(fileDescriptor),NULL,PAGE_READONLY,0,0,NULL);
+    if( mappingHandle == NULL ) {
+        printf("\n[PacketTrace] ERROR: It is not possible to map the trace file \"%s\".",fileName);
+        this->closeFile();
+        return false;
+    }
+#endif
+
+    numberOfRecords = header.numberOfRecords;
+    cursors.resize(NUM_ELEMENTS);
+    skippedFrom.assign(NUM_ELEMENTS,TRACE_NO_SKIP);
+    packetsPerSource.assign(NUM_ELEMENTS,0);
+
+    if( !this->countPackets() ) {
+        this->unmapWindow();
+        this->closeFile();
+        return false;
+    }
+
+    printf("\n[PacketTrace] Replaying %llu packets from \"%s\" (time scale: %.3f)",
+           (unsigned long long) numberOfRecords,fileName,timeScale);
+    return true;
+}
+
+/*!
+ * \brief PacketTrace::countPackets It runs once over the trace to determine the
+ * number of packets of each source (used to stop the simulation when all the
+ * packets are delivered) and to validate the records.
+ */
+bool PacketTrace::countPackets() {
+    uint64_t previousCycle = 0;
+    for( uint64_t i = 0; i < numberOfRecords; i++ ) {
+        const TraceRecord* r = this->record(i);
+        if( r == NULL ) {
+            return false;
+        }
+        if( r->source >= NUM_ELEMENTS || r->destination >= NUM_ELEMENTS ) {
+            printf("\n[PacketTrace] ERROR: Record %llu addresses a terminal out of the network (%u -> %u).",
+                   (unsigned long long) i,r->source,r->destination);
+            return false;
+        }
+        if( r->payloadLength == 0 ) {
+            printf("\n[PacketTrace] ERROR: Record %llu has no payload (the trailer must be included).",
+                   (unsigned long long) i);
+            return false;
+        }
+        if( r->cycle < previousCycle ) {
+            printf("\n[PacketTrace] ERROR: Record %llu is not sorted by injection cycle.",(unsigned long long) i);
+            return false;
+        }
+        previousCycle = r->cycle;
+        packetsPerSource[r->source]++;
+    }
+    return this->mapWindow(0);
+}
+
+const PacketTrace::TraceRecord* PacketTrace::record(uint64_t index) {
+    if( windowRecords == NULL || index < windowFirst || index >= windowFirst + windowCount ) {
+        if( !this->mapWindow(index) ) {
+            return NULL;
+        }
+    }
+    return &windowRecords[index - windowFirst];
+}
+
+bool PacketTrace::mapWindow(uint64_t firstRecord) {
+
+    this->unmapWindow();
+    if( firstRecord >= numberOfRecords ) {
+        return true;
+    }
+
+    // The mapping offset must be aligned to the page size (allocation granularity on win32)
+    uint64_t offset  = sizeof(TraceHeader) + firstRecord * sizeof(TraceRecord);
+#if defined(__WIN32__) || defined(_WIN32)
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    uint64_t pageSize = systemInfo.dwAllocationGranularity;
+#else
+    uint64_t pageSize = (uint64_t) sysconf(_SC_PAGESIZE);
+#endif
+    uint64_t aligned = offset - (offset % pageSize);
+
+    windowCount = numberOfRecords - firstRecord;
+    if( windowCount > windowCapacity ) {
+        windowCount = windowCapacity;
+    }
+    windowLength = (size_t) (offset - aligned) + windowCount * sizeof(TraceRecord);
+
+#if defined(__WIN32__) || defined(_WIN32)
+    windowBase = MapViewOfFile((HANDLE) mappingHandle,FILE_MAP_READ,
+                               (DWORD) (aligned >> 32),(DWORD) (aligned & 0xFFFFFFFF),windowLength);
+    if( windowBase == NULL ) {
+#else
+    windowBase = mmap(NULL,windowLength,PROT_READ,MAP_PRIVATE,fileDescriptor,(off_t) aligned);
+    if( windowBase == MAP_FAILED ) {
+#endif
+        printf("\n[PacketTrace] ERROR: It is not possible to map the trace file.");
+        windowBase = NULL;
+        windowLength = 0;
+        windowCount = 0;
+        return false;
+    }
+#if !defined(__WIN32__) && !defined(_WIN32)
+    madvise(windowBase,windowLength,MADV_SEQUENTIAL);
+#endif
+
+    windowRecords = (const TraceRecord*) ((const char*) windowBase + (offset - aligned));
+    windowFirst = firstRecord;
+    return true;
+}
+
+void PacketTrace::unmapWindow() {
+    if( windowBase != NULL ) {
+#if defined(__WIN32__) || defined(_WIN32)
+        UnmapViewOfFile(windowBase);
+#else
+        munmap(windowBase,windowLength);
+#endif
+    }
+    windowBase = NULL;
+    windowLength = 0;
+    windowRecords = NULL;
+    windowCount = 0;
+}
+
+/*!
+ * \brief PacketTrace::advance It dispatches to the terminal cursors all the
+ * records due until the cycle. Only the first call in a cycle does some work.
+ * The records of a terminal with a full cursor are skipped (the first one is
+ * kept in skippedFrom) and read again by refill(), so the memory used is
+ * bounded and only the backed up terminal is delayed.
+ */
+void PacketTrace::advance(unsigned long long cycle) {
+    if( cycle < lastCycleAdvanced ) {
+        return;
+    }
+    lastCycleAdvanced = cycle + 1;
+
+    while( nextRecord < numberOfRecords ) {
+        const TraceRecord* r = this->record(nextRecord);
+        if( r == NULL || this->scaledCycle(*r) > cycle ) {
+            break;
+        }
+        if( skippedFrom[r->source] == TRACE_NO_SKIP ) {
+            if( cursors[r->source].size() < TRACE_CURSOR_RECORDS ) {
+                cursors[r->source].push_back(*r);
+            } else {
+                skippedFrom[r->source] = nextRecord;
+            }
+        }
+        nextRecord++;
+    }
+}
+
+/*!
+ * \brief PacketTrace::refill It reads again the records skipped for the
+ * terminal, from the first one until its cursor is full or the read position
+ * is reached (all these records are due).
+ */
+void PacketTrace::refill(unsigned short source) {
+    uint64_t index = skippedFrom[source];
+    std::deque<TraceRecord>& cursor = cursors[source];
+    while( index < nextRecord && cursor.size() < TRACE_CURSOR_RECORDS ) {
+        const TraceRecord* r = this->record(index);
+        if( r == NULL ) {
+            break;
+        }
+        if( r->source == source ) {
+            cursor.push_back(*r);
+        }
+        index++;
+    }
+    skippedFrom[source] = index < nextRecord ? index : TRACE_NO_SKIP;
+}
+
+bool PacketTrace::nextPacket(unsigned short source,
+                             unsigned long long cycle,
+                             TraceRecord &record,
+                             unsigned long long &injectionCycle) {
+    this->advance(cycle);
+
+    std::deque<TraceRecord>& cursor = cursors[source];
+    // Refilled at half capacity, so the mapping is not moved back on every packet
+    if( skippedFrom[source] != TRACE_NO_SKIP && cursor.size() <= TRACE_CURSOR_RECORDS / 2 ) {
+        this->refill(source);
+    }
+    if( cursor.empty() ) {
+        return false;
+    }
+    record = cursor.front();
+    injectionCycle = this->scaledCycle(record);
+    cursor.pop_front();
+    return true;
+}
+
+bool PacketTrace::finished(unsigned short source) const {
+    return packetsPerSource.empty()
+            || (nextRecord == numberOfRecords && cursors[source].empty() && skippedFrom[source] == TRACE_NO_SKIP);
+}
+
+unsigned long PacketTrace::packetsFrom(unsigned short source) const {
+    if( source < packetsPerSource.size() ) {
+        return packetsPerSource[source];
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#ifndef __PACKETTRACE_H__
+#define __PACKETTRACE_H__
+
+#include <deque>
+#include <vector>
+#include <stdint.h>
+#include <cstddef>
+
+#define PACKET_TRACE PacketTrace::instance() // Get the trace shared by all the flow generators
+
+/*!
+ * \brief The PacketTrace class replays a binary packet trace captured
+ * from a full-system run.
+ *
+ * The file is memory-mapped through a sliding window, so the memory
+ * used does not depend on the trace length. A single read position
+ * runs over the trace as the simulation advances and dispatches each
+ * record to the cursor of its source terminal, where it waits until
+ * the flow generator injects it. The cursors have a limited capacity:
+ * the records of a backed up terminal are skipped by the read position
+ * and read again from the mapping when its cursor drains.
+ *
+ * File format (native byte order - little-endian in x86 hosts):
+ *  - Header: 4-byte magic "SNPT", uint32 version (1), uint64 number of records
+ *  - Records sorted by injection cycle (TraceRecord - 16 bytes each)
+ */
+class PacketTrace {
+public:
+    struct TraceHeader {
+        char     magic[4];          // "SNPT"
+        uint32_t version;           // Format version
+        uint64_t numberOfRecords;   // Number of packets in the trace
+    };
+
+    struct TraceRecord {
+        uint64_t cycle;             // Injection cycle
+        uint16_t source;            // Source terminal
+        uint16_t destination;       // Destination terminal
+        uint16_t payloadLength;     // Number of flits in the payload (including the trailer)
+        uint8_t  trafficClass;      // Class of traffic
+        uint8_t  reserved;          // Padding (keep zero)
+    };
+
+    static PacketTrace* instance();
+
+    bool isOpen() const { return fileDescriptor >= 0; }
+
+    /*!
+     * \brief packetsFrom Number of packets that a terminal injects in the trace
+     */
+    unsigned long packetsFrom(unsigned short source) const;
+
+    /*!
+     * \brief nextPacket Get the next packet of the terminal to be
+     * injected until the current cycle
+     * \param source Terminal identifier
+     * \param cycle Current simulation cycle
+     * \param record Packet to be injected
+     * \param injectionCycle Scaled cycle on which the packet was due
+     * \return true if there is a packet to be injected
+     */
+    bool nextPacket(unsigned short source, unsigned long long cycle,
+                    TraceRecord& record, unsigned long long& injectionCycle);
+
+    /*!
+     * \brief finished It determines if the terminal has no more packets to inject
+     */
+    bool finished(unsigned short source) const;
+
+    ~PacketTrace();
+
+private:
+    static PacketTrace* trace;
+
+    int fileDescriptor;
+    uint64_t numberOfRecords;
+    uint64_t nextRecord;                // Index of the next record to be dispatched
+    float timeScale;
+
+    // Mapped window
+    void*  windowBase;                  // Address returned by mmap
+    size_t windowLength;                // Length of the mapping
+    const TraceRecord* windowRecords;   // First record in the window
+    uint64_t windowFirst;               // Index of the first record in the window
+    uint64_t windowCount;               // Number of records in the window
+    size_t   windowCapacity;            // Maximum number of records mapped at once
+    void*    mappingHandle;             // File mapping of the views (win32 only)
+
+    std::vector<std::deque<TraceRecord> > cursors; // Records dispatched and not yet injected by each terminal
+    std::vector<unsigned long> packetsPerSource;
+    std::vector<uint64_t> skippedFrom;  // First record skipped for a terminal with a full cursor (TRACE_NO_SKIP: none)
+
+    unsigned long long lastCycleAdvanced;
+
+    PacketTrace();
+    PacketTrace(const PacketTrace&);
+    PacketTrace& operator= (const PacketTrace&);
+
+    bool open(const char* fileName);
+    void closeFile();
+    bool countPackets();
+    const TraceRecord* record(uint64_t index);
+    bool mapWindow(uint64_t firstRecord);
+    void unmapWindow();
+    void advance(unsigned long long cycle);
+    void refill(unsigned short source);
+    inline unsigned long long scaledCycle(const TraceRecord& r) const
+        { return timeScale == 1.0f ? r.cycle : (unsigned long long) (r.cycle * (double) timeScale); }
+};
+
+#endif // __PACKETTRACE_H__
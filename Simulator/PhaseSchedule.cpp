@@ -0,0 +1,207 @@
+#include "PhaseSchedule.h"
+#include "../Parameters/Parameters.h"
+
+#include <cstdlib>
+#include <cstring>
+
+PhaseSchedule* PhaseSchedule::schedule = 0;
+
+PhaseSchedule* PhaseSchedule::instance() {
+    if( !schedule ) {
+        schedule = new PhaseSchedule();
+        if( PHASE_FILE != NULL ) {
+            schedule->open(PHASE_FILE);
+        }
+    }
+    return schedule;
+}
+
+PhaseSchedule::PhaseSchedule()
+    : currentPhase(PHASE_NONE),
+      drainFlits(0)
+{}
+
+/*!
+ * \brief readToken It reads the next token of the file, skipping the comments
+ */
+static bool readToken(FILE* file, char* token) {
+    while( fscanf(file,"%255s",token) == 1 ) {
+        if( token[0] != '#' ) {
+            return true;
+        }
+        int c;
+        do {
+            c = fgetc(file);
+        } while( c != '\n' && c != EOF );
+    }
+    return false;
+}
+
+bool PhaseSchedule::open(const char *fileName) {
+
+    FILE* file;
+    if( (file = fopen(fileName,"rt")) == NULL ) {
+        printf("\n[PhaseSchedule] ERROR: Impossible to open phase schedule file \"%s\".",fileName);
+        return false;
+    }
+
+    char token[256];
+    char* end;
+    unsigned long numberOfPhases = 0;
+    if( !readToken(file,token) || strcmp(token,"phases") != 0
+            || !readToken(file,token) || (numberOfPhases = strtoul(token,&end,10)) == 0 || *end != '\0' ) {
+        printf("\n[PhaseSchedule] ERROR: Section \"phases <number>\" expected in \"%s\".",fileName);
+        fclose(file);
+        return false;
+    }
+
+    std::vector<Phase> schedulePhases(numberOfPhases);
+    for( unsigned int i = 0; i < numberOfPhases; i++ ) {
+        Phase& p = schedulePhases[i];
+        char name[256];
+        char trafficFile[256];
+        if( !readToken(file,name) || !readToken(file,trafficFile) || !readToken(file,token)
+                || token[0] == '-' ) {
+            printf("\n[PhaseSchedule] ERROR: Phase %u must be \"<name> <traffic_file> <duration_cycles>\".",i);
+            fclose(file);
+            return false;
+        }
+        p.duration = strtoull(token,&end,10);
+        if( *end != '\0' ) {
+            printf("\n[PhaseSchedule] ERROR: Invalid duration \"%s\" of the phase \"%s\".",token,name);
+            fclose(file);
+            return false;
+        }
+        p.name = name;
+        if( trafficFile[0] == '/' ) {
+            p.trafficFile = trafficFile;
+        } else {
+            p.trafficFile = std::string(WORK_DIR) + "/" + trafficFile;
+        }
+        p.quota = 0;
+        p.startCycle = p.endCycle = 0;
+        p.endReason = NotStarted;
+        p.packetsSent = p.packetsDelivered = 0;
+        p.latencySum = p.latencyMin = p.latencyMax = 0;
+        p.flitsAccepted = 0;
+    }
+    fclose(file);
+
+    phases.swap(schedulePhases);
+    printf("\n[PhaseSchedule] Schedule \"%s\": %lu phases",fileName,numberOfPhases);
+    return true;
+}
+
+void PhaseSchedule::startPhase(unsigned int phase, unsigned long long cycle) {
+    currentPhase = phase;
+    if( phase < phases.size() ) {
+        phases[phase].startCycle = cycle;
+        phases[phase].endReason = Running;
+    }
+}
+
+/*!
+ * \brief PhaseSchedule::phaseAt The first call starts the first phase. A
+ * phase that ends starts the next one on the same cycle, so phases with
+ * nothing to send are skipped at once.
+ */
+unsigned int PhaseSchedule::phaseAt(unsigned long long cycle) {
+    if( currentPhase == PHASE_NONE ) {
+        if( phases.empty() || phases[0].endReason != NotStarted ) {
+            return PHASE_NONE; // The schedule has finished
+        }
+        this->startPhase(0,cycle);
+    }
+
+    while( currentPhase < phases.size() ) {
+        Phase& p = phases[currentPhase];
+        if( p.duration > 0 ) {
+            if( cycle < p.startCycle + p.duration ) {
+                break;
+            }
+            p.endReason = ByCycles;
+            p.endCycle = p.startCycle + p.duration;
+        } else {
+            if( p.packetsSent < p.quota ) {
+                break;
+            }
+            p.endReason = ByQuota;
+            p.endCycle = cycle;
+        }
+        this->startPhase(currentPhase+1,p.endCycle);
+    }
+    if( currentPhase >= phases.size() ) {
+        currentPhase = PHASE_NONE;
+    }
+    return currentPhase;
+}
+
+void PhaseSchedule::packetSent(unsigned int phase, unsigned long packetId,
+                               unsigned long long creationCycle, unsigned int flits) {
+    if( phase >= phases.size() ) {
+        return;
+    }
+    phases[phase].packetsSent++;
+    InFlight packet;
+    packet.phase = phase;
+    packet.flits = flits;
+    packet.creationCycle = creationCycle;
+    inFlight[packetId] = packet;
+}
+
+/*!
+ * \brief PhaseSchedule::packetDelivered The latency is accounted to the
+ * phase that created the packet and the flits to the phase running on
+ * the delivery (accepted throughput).
+ */
+void PhaseSchedule::packetDelivered(unsigned long packetId, unsigned long long cycle) {
+    std::unordered_map<unsigned long,InFlight>::iterator it = inFlight.find(packetId);
+    if( it == inFlight.end() ) {
+        return;
+    }
+    Phase& p = phases[it->second.phase];
+    unsigned long long latency = cycle > it->second.creationCycle ? cycle - it->second.creationCycle : 0;
+    if( p.packetsDelivered == 0 || latency < p.latencyMin ) {
+        p.latencyMin = latency;
+    }
+    if( latency > p.latencyMax ) {
+        p.latencyMax = latency;
+    }
+    p.latencySum += latency;
+    p.packetsDelivered++;
+
+    unsigned int running = this->phaseAt(cycle);
+    if( running != PHASE_NONE ) {
+        phases[running].flitsAccepted += it->second.flits;
+    } else {
+        drainFlits += it->second.flits;
+    }
+    inFlight.erase(it);
+}
+
+void PhaseSchedule::writeReport(FILE *out, unsigned long long endCycle) const {
+
+    static const char* reasons[] = {"-","running","cycles","quota"};
+
+    fprintf(out,"# Phase\t      Start\t        End\t End by\t     Quota\t      Sent\t Delivered"
+                "\t Avg latency\t Min latency\t Max latency\tAccepted (flits/cycle/node)\n");
+    for( unsigned int i = 0; i < phases.size(); i++ ) {
+        const Phase& p = phases[i];
+        unsigned long long end = p.endReason == Running ? endCycle : p.endCycle;
+        fprintf(out,"%s\t%11llu\t%11llu\t%7s\t%10lu\t%10lu\t%10lu\t",
+                p.name.c_str(),p.startCycle,end,reasons[p.endReason],p.quota,p.packetsSent,p.packetsDelivered);
+        if( p.packetsDelivered > 0 ) {
+            fprintf(out,"%12.2f\t%12llu\t%12llu\t",
+                    (double) p.latencySum / p.packetsDelivered,p.latencyMin,p.latencyMax);
+        } else {
+            fprintf(out,"%12s\t%12s\t%12s\t","-","-","-");
+        }
+        if( p.endReason != NotStarted && end > p.startCycle ) {
+            fprintf(out,"%.6f\n",(double) p.flitsAccepted / ((end - p.startCycle) * (double) NUM_ELEMENTS));
+        } else {
+            fprintf(out,"-\n");
+        }
+    }
+    fprintf(out,"# Flits delivered after the last phase: %llu, packets not delivered: %lu\n",
+            drainFlits,(unsigned long) inFlight.size());
+}
@@ -0,0 +1,102 @@
+#ifndef __PHASESCHEDULE_H__
+#define __PHASESCHEDULE_H__
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdio>
+
+#define PHASE_SCHEDULE PhaseSchedule::instance() // Get the phase schedule shared by all the flow generators
+
+#define PHASE_NONE ((unsigned int) -1) // No phase running (before the first one or after the last one)
+
+/*!
+ * \brief The PhaseSchedule class switches the traffic of all the flow
+ * generators along a sequence of phases (e.g. boot, streaming, compute
+ * bursts), each one with its own traffic file.
+ *
+ * A phase with a duration ends after that number of cycles. A phase
+ * without duration (0) ends when all the packets of its flows are sent
+ * (phase quota). The packets are accounted to the phase in which they
+ * were created, so the statistics of each phase are reported separately,
+ * including the packets delivered after the phase boundary.
+ *
+ * File format (text - lines started by '#' are comments):
+ *   phases <N>
+ *   <name> <traffic_file> <duration_cycles>   (N lines, traffic file relative to the work folder)
+ */
+class PhaseSchedule {
+public:
+    static PhaseSchedule* instance();
+
+    bool isOpen() const { return !phases.empty(); }
+
+    unsigned int numberOfPhases() const { return (unsigned int) phases.size(); }
+
+    /*!
+     * \brief trafficFile Traffic file (with the work folder) of a phase
+     */
+    const char* trafficFile(unsigned int phase) const { return phases[phase].trafficFile.c_str(); }
+
+    /*!
+     * \brief addQuota It adds the packets of a flow generator to the quota of a phase
+     */
+    void addQuota(unsigned int phase, unsigned long packets) { phases[phase].quota += packets; }
+
+    /*!
+     * \brief phaseAt It ends the phases finished until the cycle
+     * \return The phase running on the cycle or PHASE_NONE after the last phase
+     */
+    unsigned int phaseAt(unsigned long long cycle);
+
+    void packetSent(unsigned int phase, unsigned long packetId,
+                    unsigned long long creationCycle, unsigned int flits);
+
+    void packetDelivered(unsigned long packetId, unsigned long long cycle);
+
+    void writeReport(FILE* out, unsigned long long endCycle) const;
+
+    ~PhaseSchedule() {}
+
+private:
+    enum EndReason { NotStarted, Running, ByCycles, ByQuota };
+
+    struct Phase {
+        std::string name;
+        std::string trafficFile;
+        unsigned long long duration;    // 0: the phase ends by its quota
+        unsigned long quota;            // Packets of all the flow generators in the phase
+        unsigned long long startCycle;
+        unsigned long long endCycle;
+        EndReason endReason;
+        // Statistics
+        unsigned long packetsSent;
+        unsigned long packetsDelivered;     // Packets created in the phase and delivered
+        unsigned long long latencySum;
+        unsigned long long latencyMin;
+        unsigned long long latencyMax;
+        unsigned long long flitsAccepted;   // Flits delivered during the phase (any phase packet)
+    };
+
+    struct InFlight {                   // Packet sent and not yet delivered
+        unsigned int phase;
+        unsigned int flits;
+        unsigned long long creationCycle;
+    };
+
+    static PhaseSchedule* schedule;
+
+    std::vector<Phase> phases;
+    std::unordered_map<unsigned long,InFlight> inFlight;
+    unsigned int currentPhase;
+    unsigned long long drainFlits;      // Flits delivered after the last phase
+
+    PhaseSchedule();
+    PhaseSchedule(const PhaseSchedule&);
+    PhaseSchedule& operator= (const PhaseSchedule&);
+
+    bool open(const char* fileName);
+    void startPhase(unsigned int phase, unsigned long long cycle);
+};
+
+#endif // __PHASESCHEDULE_H__
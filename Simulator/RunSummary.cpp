@@ -0,0 +1,315 @@
+#include "RunSummary.h"
+#include "TerminalInstrumentation.h"
+#include "../TrafficMeter/TrafficMeter.h"
+#include "../TrafficMeter/LogWriter.h"
+#include "../PluginManager/PluginManager.h"
+
+#include <cmath>
+#include <map>
+#include <string>
+
+#if defined(__WIN32__) || defined(_WIN32)
+#else
+#include <sys/resource.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// JsonWriter
+////////////////////////////////////////////////////////////////////////////////
+
+void JsonWriter::string(const char *value) {
+    fputc('"',out);
+    for( const char* c = value; *c != '\0'; c++ ) {
+        switch( *c ) {
+            case '"':  fputs("\\\"",out); break;
+            case '\\': fputs("\\\\",out); break;
+            case '\n': fputs("\\n",out);  break;
+            case '\t': fputs("\\t",out);  break;
+            case '\r': fputs("\\r",out);  break;
+            default:
+                if( (unsigned char) *c < 0x20 ) {
+                    fprintf(out,"\\u%04x",(unsigned int) *c);
+                } else {
+                    fputc(*c,out);
+                }
+        }
+    }
+    fputc('"',out);
+}
+
+void JsonWriter::member(const char *key) {
+    if( !firstMember.empty() ) {
+        fputs(firstMember.back() ? "\n" : ",\n",out);
+        firstMember.back() = false;
+        for( unsigned int i = 0; i < firstMember.size(); i++ ) {
+            fputs("  ",out);
+        }
+    }
+    if( key != NULL ) {
+        string(key);
+        fputs(": ",out);
+    }
+}
+
+void JsonWriter::close(char delimiter) {
+    bool empty = firstMember.back();
+    firstMember.pop_back();
+    if( !empty ) {
+        fputc('\n',out);
+        for( unsigned int i = 0; i < firstMember.size(); i++ ) {
+            fputs("  ",out);
+        }
+    }
+    fputc(delimiter,out);
+    if( firstMember.empty() ) {
+        fputc('\n',out);
+    }
+}
+
+void JsonWriter::beginObject(const char *key) {
+    member(key);
+    fputc('{',out);
+    firstMember.push_back(true);
+}
+
+void JsonWriter::endObject() {
+    close('}');
+}
+
+void JsonWriter::beginArray(const char *key) {
+    member(key);
+    fputc('[',out);
+    firstMember.push_back(true);
+}
+
+void JsonWriter::endArray() {
+    close(']');
+}
+
+void JsonWriter::field(const char *key, const char *value) {
+    member(key);
+    if( value == NULL ) {
+        fputs("null",out);
+    } else {
+        string(value);
+    }
+}
+
+void JsonWriter::field(const char *key, unsigned long long value) {
+    member(key);
+    fprintf(out,"%llu",value);
+}
+
+void JsonWriter::field(const char *key, long long value) {
+    member(key);
+    fprintf(out,"%lld",value);
+}
+
+void JsonWriter::field(const char *key, double value) {
+    member(key);
+    if( std::isfinite(value) ) {
+        fprintf(out,"%.9g",value);
+    } else {
+        fputs("null",out);
+    }
+}
+
+void JsonWriter::field(const char *key, bool value) {
+    member(key);
+    fputs(value ? "true" : "false",out);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// RunSummary
+////////////////////////////////////////////////////////////////////////////////
+
+RunSummary::RunSummary(int argc, char *argv[])
+    : argc(argc), argv(argv), wallTime(0.0) {}
+
+void RunSummary::startRun() {
+    start = std::chrono::steady_clock::now();
+}
+
+void RunSummary::finishRun() {
+    wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+long long RunSummary::peakMemory() {
+#if defined(__WIN32__) || defined(_WIN32)
+    return -1;
+#else
+    struct rusage usage;
+    if( getrusage(RUSAGE_SELF,&usage) != 0 ) {
+        return -1;
+    }
+#if defined(__APPLE__)
+    return (long long) usage.ru_maxrss / 1024; // Bytes
+#else
+    return (long long) usage.ru_maxrss;        // KiB
+#endif
+#endif
+}
+
+static void writeLatency(JsonWriter& json, const char* key, const LatencyHistogram& h) {
+    json.beginObject(key);
+    json.field("packets",h.count());
+    json.field("mean",h.mean());
+    json.field("min",h.min());
+    json.field("p50",h.percentile(50));
+    json.field("p99",h.percentile(99));
+    json.field("p99_9",h.percentile(99.9));
+    json.field("max",h.max());
+    json.endObject();
+}
+
+bool RunSummary::write(const char *fileName, unsigned long long cycles, unsigned short stopMethod,
+                       const std::vector<TerminalInstrumentation *> &terminals,
+                       const std::vector<TrafficMeter *> &meters) const {
+
+    FILE* out;
+    if( (out = fopen(fileName,"wt")) == NULL ) {
+        return false;
+    }
+
+    static const char* STOP_METHODS[] = {"all_packets_delivered","by_time","by_cycles","by_packets_delivered"};
+    double simulatedCycles = cycles > 0 ? (double) cycles : 1.0;
+    unsigned int numTerminals = (unsigned int) terminals.size();
+
+    JsonWriter json(out);
+    json.beginObject();
+
+    json.beginArray("command");
+    for( int i = 0; i < argc; i++ ) {
+        json.field(NULL,argv[i]);
+    }
+    json.endArray();
+
+    // Configuration
+    json.beginObject("configuration");
+    json.field("clk_period_ns",CLK_PERIOD);
+    json.field("work_dir",WORK_DIR);
+    json.field("plugins_dir",PLUGINS_DIR);
+    json.field("conf_file",CONF_FILE);
+    json.field("elements",NUM_ELEMENTS);
+    json.field("x_size",X_SIZE);
+    json.field("y_size",Y_SIZE);
+    json.field("z_size",Z_SIZE);
+    json.field("data_width",(unsigned short) (FLIT_WIDTH-2));
+    json.field("virtual_channels",NUM_VC);
+    json.field("fifo_in_depth",FIFO_IN_DEPTH);
+    json.field("fifo_out_depth",FIFO_OUT_DEPTH);
+    json.field("traffic_classes",N_CLASSES);
+    json.field("seed",SEED);
+    json.field("trace",TRACE);
+    json.field("replay_file",REPLAY_FILE);
+    json.field("replay_time_scale",REPLAY_TIME_SCALE);
+    json.field("flow_weighting",FLOW_WEIGHTING);
+    json.field("closed_loop",CLOSED_LOOP);
+    json.field("reply_length",REPLY_LENGTH);
+    json.field("service_delay",SERVICE_DELAY);
+    json.field("max_outstanding",MAX_OUTSTANDING);
+    json.field("task_graph_file",TASK_GRAPH_FILE);
+    json.field("phase_file",PHASE_FILE);
+    json.field("calendar_injection",CALENDAR_INJECTION);
+    json.field("packet_logging",PACKET_LOGGING);
+    json.field("binary_packet_log",BINARY_PACKET_LOG);
+    json.field("latency_statistics",LATENCY_STATISTICS);
+    json.field("link_counters",LINK_COUNTERS);
+    json.field("buffer_occupancy",BUFFER_OCCUPANCY);
+    json.field("async_log",ASYNC_LOG);
+    json.field("telemetry_interval",TELEMETRY_INTERVAL);
+    json.field("tracer_sampling",TRACER_SAMPLING);
+    json.field("tracer_flows",TRACER_FLOWS);
+    json.field("trace_start",TRACE_START);
+    json.field("trace_stop",TRACE_STOP);
+    json.field("trace_routers",TRACE_ROUTERS);
+    json.field("trace_internal",TRACE_INTERNAL);
+    json.field("latency_stages",LATENCY_STAGES);
+    json.field("stall_counters",STALL_COUNTERS);
+    json.field("stall_interval",STALL_INTERVAL);
+    json.field("activity_counters",ACTIVITY_COUNTERS);
+    json.field("energy_file",ENERGY_FILE);
+    json.field("time_series_interval",TIME_SERIES_INTERVAL);
+    json.endObject();
+
+    json.beginObject("plugins");
+    const std::map<std::string,std::string>& plugins = PLUGIN_MANAGER->pluginProperties();
+    std::map<std::string,std::string>::const_iterator it;
+    for( it = plugins.begin(); it != plugins.end(); it++ ) {
+        json.field(it->first.c_str(),it->second.c_str());
+    }
+    json.endObject();
+
+    // Execution
+    long long memory = peakMemory();
+    json.beginObject("run");
+    json.field("stop_method",stopMethod < 4 ? STOP_METHODS[stopMethod] : NULL);
+    json.field("cycles",cycles);
+    json.field("wall_time_s",wallTime);
+    json.field("cycles_per_second",wallTime > 0 ? cycles / wallTime : NAN);
+    if( memory >= 0 ) {
+        json.field("peak_memory_kib",memory);
+    } else {
+        json.field("peak_memory_kib",(const char*) NULL);
+    }
+    json.field("log_writer_waits",LOG_WRITER->backPressureWaits());
+    json.endObject();
+
+    // Traffic
+    unsigned long long packetsOffered = 0, packetsInjected = 0, packetsDelivered = 0;
+    unsigned long long flitsOffered = 0, flitsDelivered = 0;
+    LatencyHistogram networkLatency, totalLatency;
+    for( unsigned int i = 0; i < numTerminals; i++ ) {
+        const UnboundedFifo* source = terminals[i]->u_FIFO_OUT;
+        packetsOffered += source->packetsOffered;
+        packetsInjected += source->packetsInjected;
+        flitsOffered += source->flitsOffered;
+        packetsDelivered += meters[i]->packetsReceived;
+        flitsDelivered += meters[i]->flitsReceived;
+        networkLatency.merge(meters[i]->networkLatency);
+        totalLatency.merge(meters[i]->totalLatency);
+    }
+
+    json.beginObject("traffic");
+    json.field("packets_offered",packetsOffered);
+    json.field("packets_injected",packetsInjected);
+    json.field("packets_delivered",packetsDelivered);
+    json.field("flits_offered",flitsOffered);
+    json.field("flits_delivered",flitsDelivered);
+    json.field("offered_flits_per_node_cycle",numTerminals > 0 ? flitsOffered / simulatedCycles / numTerminals : 0.0);
+    json.field("accepted_flits_per_node_cycle",numTerminals > 0 ? flitsDelivered / simulatedCycles / numTerminals : 0.0);
+    json.beginObject("packets_in_flight");
+    json.field("source_queues",packetsOffered - packetsInjected);
+    json.field("network",packetsInjected > packetsDelivered ? packetsInjected - packetsDelivered : 0ULL);
+    json.endObject();
+    json.endObject();
+
+    json.beginObject("latency");
+    writeLatency(json,"network",networkLatency);
+    writeLatency(json,"total",totalLatency);
+    json.endObject();
+
+    // By terminal: offered at the source, accepted at the destination
+    json.beginArray("nodes");
+    for( unsigned int i = 0; i < numTerminals; i++ ) {
+        const UnboundedFifo* source = terminals[i]->u_FIFO_OUT;
+        const TrafficMeter* meter = meters[i];
+        json.beginObject();
+        json.field("id",i);
+        json.field("packets_offered",source->packetsOffered);
+        json.field("packets_injected",source->packetsInjected);
+        json.field("packets_delivered",meter->packetsReceived);
+        json.field("offered_flits_per_cycle",source->flitsOffered / simulatedCycles);
+        json.field("injected_flits_per_cycle",source->flitsInjected / simulatedCycles);
+        json.field("accepted_flits_per_cycle",meter->flitsReceived / simulatedCycles);
+        json.field("network_latency_mean",meter->networkLatency.mean());
+        json.field("network_latency_max",meter->networkLatency.max());
+        json.endObject();
+    }
+    json.endArray();
+
+    json.endObject();
+
+    fclose(out);
+    return true;
+}
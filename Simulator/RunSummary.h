@@ -0,0 +1,82 @@
+#ifndef __RUNSUMMARY_H__
+#define __RUNSUMMARY_H__
+
+#include <vector>
+#include <cstdio>
+#include <chrono>
+
+#define SUMMARY_FILENAME "summary.json"
+
+class TerminalInstrumentation;
+class TrafficMeter;
+
+/*!
+ * \brief The JsonWriter class writes a JSON document in a file, one
+ * member per line. The writer only keeps the separators and indentation:
+ * the caller is responsible for opening and closing the scopes in order.
+ */
+class JsonWriter {
+public:
+    JsonWriter(FILE* out) : out(out) {}
+
+    void beginObject(const char* key = NULL);
+    void endObject();
+    void beginArray(const char* key = NULL);
+    void endArray();
+
+    void field(const char* key, const char* value);  // NULL value: null
+    void field(const char* key, unsigned long long value);
+    void field(const char* key, long long value);
+    void field(const char* key, double value);       // Non-finite value: null
+    void field(const char* key, bool value);
+    void field(const char* key, unsigned int value) { field(key,(unsigned long long) value); }
+    void field(const char* key, unsigned short value) { field(key,(unsigned long long) value); }
+    void field(const char* key, int value) { field(key,(long long) value); }
+    void field(const char* key, float value) { field(key,(double) value); }
+
+private:
+    FILE* out;
+    std::vector<bool> firstMember; // One level by scope opened
+
+    void member(const char* key);
+    void string(const char* value);
+    void close(char delimiter);
+};
+
+/*!
+ * \brief The RunSummary class measures the simulation run (wall time)
+ * and writes a machine-readable summary of it at the end: command line,
+ * configuration and plugins, simulation speed, peak memory, offered and
+ * accepted throughput by terminal, latency and packets in flight on stop.
+ */
+class RunSummary {
+public:
+    RunSummary(int argc, char* argv[]);
+
+    void startRun();
+    void finishRun();
+
+    /*!
+     * \brief write It writes the summary file
+     * \param cycles Cycles simulated
+     * \param stopMethod Stop method of the StopSim
+     * \return false if the file could not be written
+     */
+    bool write(const char* fileName, unsigned long long cycles, unsigned short stopMethod,
+               const std::vector<TerminalInstrumentation*>& terminals,
+               const std::vector<TrafficMeter*>& meters) const;
+
+    /*!
+     * \brief peakMemory Peak resident memory of the process in KiB
+     * (-1 if not available in the platform)
+     */
+    static long long peakMemory();
+
+private:
+    int argc;
+    char** argv;
+    std::chrono::steady_clock::time_point start;
+    double wallTime;  // Seconds
+};
+
+#endif // __RUNSUMMARY_H__
@@ -0,0 +1,62 @@
+#include "SelfSimilarInjection.h"
+
+#include <cmath>
+
+REGISTER_TYPE_INJECTION(6,SelfSimilarInjection)
+
+SelfSimilarInjection::SelfSimilarInjection(unsigned short numCyclesPerFlit)
+    : ArrivalProcessInjection(numCyclesPerFlit),
+      alfa(0), minimumPeriod(0), emissionInterval(0), lastArrival(0)
+{}
+
+void SelfSimilarInjection::initialize(FlowGenerator::FlowParameters &flow) {
+
+    float hurst = flow.parameter1;
+    if( hurst <= 0.5f || hurst >= 1.0f ) {
+        std::cout << "\n[SelfSimilarInjection] WARNING: Hurst exponent " << hurst
+                  << " out of the range (0.5,1) - using 0.8" << std::endl;
+        hurst = 0.8f;
+    }
+    unsigned int numberOfSources = flow.parameter2 >= 1.0f ? (unsigned int) flow.parameter2 : 16;
+    float load = flow.required_bw > 0.0f ? flow.required_bw : 0.01f;
+
+    alfa = 3.0 - 2.0 * hurst;
+    // ON and OFF periods have the same distribution (each source is ON half of the time), then
+    // each source emits at twice its share of the load while it is ON
+    emissionInterval = this->packetCycles(flow) * numberOfSources / (2.0 * load);
+    minimumPeriod = 4.0 * emissionInterval; // At least some packets in an ON period
+
+    // The sources start in a random point of an OFF period, so they are not synchronized
+    sources.resize(numberOfSources);
+    for( unsigned int i = 0; i < numberOfSources; i++ ) {
+        sources[i].nextEmission = random.uniform() * this->pareto();
+        sources[i].onEnd = sources[i].nextEmission + this->pareto();
+    }
+}
+
+void SelfSimilarInjection::sampleArrivals(FlowGenerator::FlowParameters &flow, double *gaps, unsigned int n) {
+
+    if( sources.empty() ) {
+        this->initialize(flow);
+    }
+
+    for( unsigned int g = 0; g < n; g++ ) {
+        // The aggregate emits the earliest packet among the sources
+        unsigned int first = 0;
+        for( unsigned int i = 1; i < sources.size(); i++ ) {
+            if( sources[i].nextEmission < sources[first].nextEmission ) {
+                first = i;
+            }
+        }
+        OnOffSource& source = sources[first];
+        double arrival = source.nextEmission;
+        gaps[g] = arrival - lastArrival;
+        lastArrival = arrival;
+
+        source.nextEmission += emissionInterval;
+        if( source.nextEmission >= source.onEnd ) { // End of the ON period - OFF, then a new ON period
+            source.nextEmission = source.onEnd + this->pareto();
+            source.onEnd = source.nextEmission + this->pareto();
+        }
+    }
+}
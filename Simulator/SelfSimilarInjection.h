@@ -0,0 +1,40 @@
+#ifndef __SELFSIMILARINJECTION_H__
+#define __SELFSIMILARINJECTION_H__
+
+#include "ArrivalProcessInjection.h"
+
+#include <vector>
+
+/*!
+ * \brief The SelfSimilarInjection class generates self-similar traffic by
+ * aggregating Pareto ON/OFF sources (Willinger et al., 1997).
+ *
+ * Each source alternates ON and OFF periods with Pareto-distributed lengths
+ * of shape alfa = 3 - 2H, and it emits packets at a constant rate during
+ * the ON periods. The mean load of the aggregate is the flow required_bw.
+ *  - parameter1: Hurst exponent (0.5 < H < 1)
+ *  - parameter2: Number of ON/OFF sources aggregated (default 16)
+ */
+class SelfSimilarInjection : public ArrivalProcessInjection {
+public:
+    SelfSimilarInjection(unsigned short numCyclesPerFlit);
+
+protected:
+    void sampleArrivals(FlowGenerator::FlowParameters& flow, double* gaps, unsigned int n);
+
+private:
+    struct OnOffSource {
+        double nextEmission;    // Next packet of the source
+        double onEnd;           // End of the current ON period
+    };
+    std::vector<OnOffSource> sources;
+    double alfa;                // Pareto shape
+    double minimumPeriod;       // Pareto scale (the shortest ON/OFF period)
+    double emissionInterval;    // Interval between the packets of a source in the ON period
+    double lastArrival;
+
+    void initialize(FlowGenerator::FlowParameters& flow);
+    inline double pareto() { return minimumPeriod * pow(1.0 - random.uniform(), -1.0/alfa); }
+};
+
+#endif // __SELFSIMILARINJECTION_H__
@@ -1,5 +1,6 @@
 TARGET = SNoCS
 CONFIG += c++11
+CONFIG += thread
 
 include(../app.pri)
 include(../socindefines.pri)
@@ -10,6 +11,9 @@ SOURCES += \
     ../SystemSignals/SystemSignals.cpp \
     ../StopSim/StopSim.cpp \
     ../TrafficMeter/TrafficMeter.cpp \
+    ../TrafficMeter/PacketLog.cpp \
+    ../TrafficMeter/LogWriter.cpp \
+    ../TrafficMeter/LatencyStatistics.cpp \
     UnboundedFifo.cpp \
     FlowGenerator.cpp \
     DestinationGenerator.cpp \
@@ -20,7 +24,19 @@ SOURCES += \
     VarPacketSizeFixInterval.cpp \
     VarIdleFixPacketSize.cpp \
     VarBurstFixInterval.cpp \
-    ConstantInjection.cpp
+    ConstantInjection.cpp \
+    PacketTrace.cpp \
+    FlowSelector.cpp \
+    ArrivalProcessInjection.cpp \
+    SelfSimilarInjection.cpp \
+    MmppInjection.cpp \
+    PacketSizeDistribution.cpp \
+    TaskGraph.cpp \
+    PhaseSchedule.cpp \
+    InjectionScheduler.cpp \
+    RunSummary.cpp \
+    Telemetry.cpp \
+    TimeSeries.cpp
 #    tm_single.cpp
 
 HEADERS += \
@@ -28,6 +44,9 @@ HEADERS += \
     ../SystemSignals/SystemSignals.h \
     ../StopSim/StopSim.h \
     ../TrafficMeter/TrafficMeter.h \
+    ../TrafficMeter/PacketLog.h \
+    ../TrafficMeter/LogWriter.h \
+    ../TrafficMeter/LatencyStatistics.h \
     UnboundedFifo.h \
     TerminalInstrumentation.h \
     FlowGenerator.h \
@@ -39,7 +58,20 @@ HEADERS += \
     VarPacketSizeFixInterval.h \
     VarIdleFixPacketSize.h \
     VarBurstFixInterval.h \
-    ConstantInjection.h
+    ConstantInjection.h \
+    PacketTrace.h \
+    FlowSelector.h \
+    ArrivalProcessInjection.h \
+    SelfSimilarInjection.h \
+    MmppInjection.h \
+    PacketSizeDistribution.h \
+    TaskGraph.h \
+    PhaseSchedule.h \
+    InjectionScheduler.h \
+    RunSummary.h \
+    Telemetry.h \
+    TelemetrySegment.h \
+    TimeSeries.h
 #    tm_single.h
 
 OTHER_FILES += simconf.conf
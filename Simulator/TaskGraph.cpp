@@ -0,0 +1,367 @@
+#include "TaskGraph.h"
+#include "../Parameters/Parameters.h"
+
+#include <cstdlib>
+#include <cstring>
+
+TaskGraph* TaskGraph::taskGraph = 0;
+
+TaskGraph* TaskGraph::instance() {
+    if( !taskGraph ) {
+        taskGraph = new TaskGraph();
+        if( TASK_GRAPH_FILE != NULL ) {
+            taskGraph->open(TASK_GRAPH_FILE);
+        }
+    }
+    return taskGraph;
+}
+
+TaskGraph::TaskGraph()
+    : started(false),
+      startCycle(0),
+      lastFinishCycle(0),
+      lastTask(TASK_NONE),
+      finishedTasks(0)
+{}
+
+/*!
+ * \brief readToken It reads the next token of the file, skipping the comments
+ */
+static bool readToken(FILE* file, char* token) {
+    while( fscanf(file,"%63s",token) == 1 ) {
+        if( token[0] != '#' ) {
+            return true;
+        }
+        int c;
+        do {
+            c = fgetc(file);
+        } while( c != '\n' && c != EOF );
+    }
+    return false;
+}
+
+static bool readNumber(FILE* file, unsigned long long& value) {
+    char token[64];
+    char* end;
+    if( !readToken(file,token) ) {
+        return false;
+    }
+    value = strtoull(token,&end,10);
+    return *end == '\0' && token[0] != '-';
+}
+
+bool TaskGraph::readCount(FILE *file, const char *section, unsigned int &count) {
+    char token[64];
+    unsigned long long value;
+    if( !readToken(file,token) || strcmp(token,section) != 0 || !readNumber(file,value) ) {
+        printf("\n[TaskGraph] ERROR: Section \"%s <number>\" expected.",section);
+        return false;
+    }
+    count = (unsigned int) value;
+    return true;
+}
+
+bool TaskGraph::open(const char *fileName) {
+
+    FILE* file;
+    if( (file = fopen(fileName,"rt")) == NULL ) {
+        printf("\n[TaskGraph] ERROR: Impossible to open task graph file \"%s\".",fileName);
+        return false;
+    }
+
+    unsigned int numberOfTasks, numberOfEdges;
+    if( !this->readCount(file,"tasks",numberOfTasks) ) {
+        fclose(file);
+        return false;
+    }
+
+    std::vector<Task> graphTasks(numberOfTasks);
+    std::vector<bool> defined(numberOfTasks,false);
+    for( unsigned int i = 0; i < numberOfTasks; i++ ) {
+        unsigned long long id, terminal, compute;
+        if( !readNumber(file,id) || !readNumber(file,terminal) || !readNumber(file,compute) ) {
+            printf("\n[TaskGraph] ERROR: Task %u must be \"<task> <terminal> <compute_cycles>\".",i);
+            fclose(file);
+            return false;
+        }
+        if( id >= numberOfTasks || defined[id] || terminal >= NUM_ELEMENTS ) {
+            printf("\n[TaskGraph] ERROR: Task %llu is duplicated or mapped out of the network (terminal %llu).",
+                   id,terminal);
+            fclose(file);
+            return false;
+        }
+        Task& t = graphTasks[id];
+        t.terminal = (unsigned short) terminal;
+        t.computeCycles = compute;
+        t.pendingInputs = 0;
+        t.lastInput = TASK_NONE;
+        t.previousTask = TASK_NONE;
+        t.readyCycle = t.startCycle = t.finishCycle = 0;
+        t.finished = false;
+        defined[id] = true;
+    }
+
+    if( !this->readCount(file,"edges",numberOfEdges) ) {
+        fclose(file);
+        return false;
+    }
+
+    std::vector<Edge> graphEdges(numberOfEdges);
+    for( unsigned int i = 0; i < numberOfEdges; i++ ) {
+        unsigned long long source, target, length;
+        if( !readNumber(file,source) || !readNumber(file,target) || !readNumber(file,length) ) {
+            printf("\n[TaskGraph] ERROR: Edge %u must be \"<source_task> <target_task> <payload_length>\".",i);
+            fclose(file);
+            return false;
+        }
+        if( source >= numberOfTasks || target >= numberOfTasks || source == target || length == 0 ) {
+            printf("\n[TaskGraph] ERROR: Edge %u (%llu -> %llu) addresses an unknown task or has no payload.",
+                   i,source,target);
+            fclose(file);
+            return false;
+        }
+        Edge& e = graphEdges[i];
+        e.source = (unsigned int) source;
+        e.target = (unsigned int) target;
+        e.payloadLength = (unsigned int) length;
+        e.readyCycle = e.arrivalCycle = 0;
+        graphTasks[source].outputs.push_back(i);
+        graphTasks[target].pendingInputs++;
+    }
+    fclose(file);
+
+    tasks.swap(graphTasks);
+    edges.swap(graphEdges);
+    if( !this->isAcyclic() ) {
+        printf("\n[TaskGraph] ERROR: The task graph \"%s\" has a cycle.",fileName);
+        tasks.clear();
+        edges.clear();
+        return false;
+    }
+
+    Terminal idle;
+    idle.runningTask = TASK_NONE;
+    idle.lastTask = TASK_NONE;
+    idle.unfinishedTasks = 0;
+    idle.networkMessages = 0;
+    terminals.assign(NUM_ELEMENTS,idle);
+    for( unsigned int i = 0; i < tasks.size(); i++ ) {
+        terminals[tasks[i].terminal].unfinishedTasks++;
+    }
+    for( unsigned int i = 0; i < edges.size(); i++ ) {
+        if( tasks[edges[i].source].terminal != tasks[edges[i].target].terminal ) {
+            terminals[tasks[edges[i].source].terminal].networkMessages++;
+        }
+    }
+
+    printf("\n[TaskGraph] Application \"%s\": %u tasks, %u edges",fileName,numberOfTasks,numberOfEdges);
+    return true;
+}
+
+/*!
+ * \brief TaskGraph::isAcyclic Topological sort (Kahn) - a cycle would
+ * never be released
+ */
+bool TaskGraph::isAcyclic() const {
+    std::vector<unsigned int> inputs(tasks.size());
+    std::vector<unsigned int> sorted;
+    for( unsigned int i = 0; i < tasks.size(); i++ ) {
+        inputs[i] = tasks[i].pendingInputs;
+        if( inputs[i] == 0 ) {
+            sorted.push_back(i);
+        }
+    }
+    for( unsigned int i = 0; i < sorted.size(); i++ ) {
+        const std::vector<unsigned int>& outputs = tasks[sorted[i]].outputs;
+        for( unsigned int j = 0; j < outputs.size(); j++ ) {
+            if( --inputs[edges[outputs[j]].target] == 0 ) {
+                sorted.push_back(edges[outputs[j]].target);
+            }
+        }
+    }
+    return sorted.size() == tasks.size();
+}
+
+/*!
+ * \brief TaskGraph::advance It releases the tasks without inputs on the
+ * first call and it completes all the tasks that finish until the cycle.
+ */
+void TaskGraph::advance(unsigned long long cycle) {
+    if( !started ) {
+        started = true;
+        startCycle = cycle;
+        for( unsigned int i = 0; i < tasks.size(); i++ ) {
+            if( tasks[i].pendingInputs == 0 ) {
+                this->inputArrived(i,TASK_NONE,cycle);
+            }
+        }
+    }
+    while( !events.empty() && events.top().cycle <= cycle ) {
+        FinishEvent e = events.top();
+        events.pop();
+        this->finishTask(e.task,e.cycle);
+    }
+}
+
+void TaskGraph::inputArrived(unsigned int task, unsigned int edge, unsigned long long cycle) {
+    Task& t = tasks[task];
+    if( edge != TASK_NONE ) {
+        edges[edge].arrivalCycle = cycle;
+        t.lastInput = edge;
+        if( --t.pendingInputs > 0 ) {
+            return;
+        }
+    }
+    t.readyCycle = cycle;
+    Terminal& terminal = terminals[t.terminal];
+    if( terminal.runningTask == TASK_NONE ) {
+        this->startTask(task,cycle);
+    } else {
+        terminal.readyTasks.push_back(task);
+    }
+}
+
+void TaskGraph::startTask(unsigned int task, unsigned long long cycle) {
+    Task& t = tasks[task];
+    Terminal& terminal = terminals[t.terminal];
+    if( cycle > t.readyCycle ) {
+        t.previousTask = terminal.lastTask; // The start was delayed by the task executed before
+    }
+    t.startCycle = cycle;
+    t.finishCycle = cycle + t.computeCycles;
+    terminal.runningTask = task;
+
+    FinishEvent e;
+    e.cycle = t.finishCycle;
+    e.task = task;
+    events.push(e);
+}
+
+void TaskGraph::finishTask(unsigned int task, unsigned long long cycle) {
+    Task& t = tasks[task];
+    t.finished = true;
+    finishedTasks++;
+    if( lastTask == TASK_NONE || cycle >= lastFinishCycle ) {
+        lastFinishCycle = cycle;
+        lastTask = task;
+    }
+
+    Terminal& terminal = terminals[t.terminal];
+    terminal.runningTask = TASK_NONE;
+    terminal.lastTask = task;
+    terminal.unfinishedTasks--;
+
+    for( unsigned int i = 0; i < t.outputs.size(); i++ ) {
+        Edge& e = edges[t.outputs[i]];
+        e.readyCycle = cycle;
+        if( tasks[e.target].terminal == t.terminal ) {
+            this->inputArrived(e.target,t.outputs[i],cycle); // Local message - it does not use the network
+        } else {
+            Message m;
+            m.edge = t.outputs[i];
+            m.destination = tasks[e.target].terminal;
+            m.payloadLength = e.payloadLength;
+            m.readyCycle = cycle;
+            terminal.outbox.push_back(m);
+        }
+    }
+
+    if( terminal.runningTask == TASK_NONE && !terminal.readyTasks.empty() ) {
+        unsigned int next = terminal.readyTasks.front();
+        terminal.readyTasks.pop_front();
+        this->startTask(next,cycle);
+    }
+}
+
+unsigned long TaskGraph::messagesFrom(unsigned short terminal) const {
+    if( terminal < terminals.size() ) {
+        return terminals[terminal].networkMessages;
+    }
+    return 0;
+}
+
+bool TaskGraph::nextMessage(unsigned short terminal, unsigned long long cycle, Message &message) {
+    this->advance(cycle);
+
+    std::deque<Message>& outbox = terminals[terminal].outbox;
+    if( outbox.empty() ) {
+        return false;
+    }
+    message = outbox.front();
+    outbox.pop_front();
+    return true;
+}
+
+void TaskGraph::messageArrived(unsigned int edge, unsigned long long cycle) {
+    if( edge >= edges.size() ) {
+        printf("\n[TaskGraph] WARNING: Message of an unknown edge (%u) received.",edge);
+        return;
+    }
+    this->advance(cycle);
+    this->inputArrived(edges[edge].target,edge,cycle);
+}
+
+bool TaskGraph::finished(unsigned short terminal) const {
+    return terminal >= terminals.size()
+            || (terminals[terminal].unfinishedTasks == 0 && terminals[terminal].outbox.empty());
+}
+
+/*!
+ * \brief TaskGraph::writeReport It writes the makespan and the critical
+ * path, from the last task to finish back to a task without inputs. Each
+ * step is a computation, a message (from the source task end until its
+ * delivery) or a wait for the terminal busy with another task. The wait is
+ * the part of the previous task computation after the task was ready, so it
+ * is not counted again as computation and the steps add up to the makespan.
+ */
+void TaskGraph::writeReport(FILE *out) const {
+
+    fprintf(out,"# Tasks: %u, Edges: %u\n",(unsigned int) tasks.size(),(unsigned int) edges.size());
+    if( !this->completed() ) {
+        fprintf(out,"# Application not completed: %u of %u tasks finished\n",
+                finishedTasks,(unsigned int) tasks.size());
+        return;
+    }
+    fprintf(out,"# Makespan (cycles): %llu\n",this->makespan());
+
+    unsigned long long computeCycles = 0;
+    unsigned long long communicationCycles = 0;
+    unsigned long long waitCycles = 0;
+    unsigned long long overlap = 0; // Computation of the task already counted as wait of the next one
+    fprintf(out,"# Critical path (reverse order)\n");
+    fprintf(out,"#   Step\t    Id\tSrc\tDst\t     Begin\t       End\t    Cycles\n");
+    unsigned int task = lastTask;
+    while( task != TASK_NONE ) {
+        const Task& t = tasks[task];
+        fprintf(out,"compute\t%6u\t%3u\t%3u\t%10llu\t%10llu\t%10llu\n",
+                task,t.terminal,t.terminal,t.startCycle - startCycle,t.finishCycle - startCycle,t.computeCycles);
+        computeCycles += t.computeCycles - overlap;
+        overlap = 0;
+        if( t.startCycle > t.readyCycle && t.previousTask != TASK_NONE ) {
+            // The previous task finished on the start of this one
+            const Task& previous = tasks[t.previousTask];
+            unsigned long long begin = previous.startCycle > t.readyCycle ? previous.startCycle : t.readyCycle;
+            overlap = t.startCycle - begin;
+            fprintf(out,"wait   \t%6u\t%3u\t%3u\t%10llu\t%10llu\t%10llu\n",
+                    t.previousTask,t.terminal,t.terminal,begin - startCycle,
+                    t.startCycle - startCycle,overlap);
+            waitCycles += overlap;
+            task = t.previousTask;
+        } else if( t.lastInput != TASK_NONE ) {
+            const Edge& e = edges[t.lastInput];
+            fprintf(out,"message\t%6u\t%3u\t%3u\t%10llu\t%10llu\t%10llu\n",
+                    t.lastInput,tasks[e.source].terminal,t.terminal,e.readyCycle - startCycle,
+                    e.arrivalCycle - startCycle,e.arrivalCycle - e.readyCycle);
+            communicationCycles += e.arrivalCycle - e.readyCycle;
+            task = e.source;
+        } else {
+            task = TASK_NONE;
+        }
+    }
+    fprintf(out,"# Critical path - Compute: %llu, Communication: %llu, Terminal wait: %llu\n",
+            computeCycles,communicationCycles,waitCycles);
+    if( computeCycles + communicationCycles + waitCycles != this->makespan() ) {
+        printf("\n[TaskGraph] WARNING: The critical path (%llu cycles) does not match the makespan (%llu cycles).",
+               computeCycles + communicationCycles + waitCycles,this->makespan());
+    }
+}
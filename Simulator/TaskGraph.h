@@ -0,0 +1,138 @@
+#ifndef __TASKGRAPH_H__
+#define __TASKGRAPH_H__
+
+#include <deque>
+#include <queue>
+#include <vector>
+#include <cstdio>
+
+#define TASK_GRAPH TaskGraph::instance() // Get the application task graph shared by all the flow generators
+
+#define TASK_NONE ((unsigned int) -1)
+
+/*!
+ * \brief The TaskGraph class drives the injection by an application
+ * described as a directed acyclic graph of tasks mapped to the terminals.
+ *
+ * A task starts when all its input messages have arrived and its terminal
+ * is free (a terminal computes one task at a time, in the order they become
+ * ready). After its compute cycles, the task sends one message on each
+ * output edge. Messages between tasks of the same terminal do not use the
+ * network. The makespan and the critical path are reported at the end.
+ *
+ * File format (text - lines started by '#' are comments):
+ *   tasks <N>
+ *   <task> <terminal> <compute_cycles>        (N lines, task in 0..N-1)
+ *   edges <M>
+ *   <source_task> <target_task> <payload_length>   (M lines, flits including the trailer)
+ */
+class TaskGraph {
+public:
+    struct Message {                    // Message ready to be injected
+        unsigned int edge;                  // Edge identifier - carried by the trailer
+        unsigned short destination;         // Terminal of the target task
+        unsigned int payloadLength;         // Number of flits in the payload (including the trailer)
+        unsigned long long readyCycle;      // Cycle on which the source task finished
+    };
+
+    static TaskGraph* instance();
+
+    bool isOpen() const { return !tasks.empty(); }
+
+    /*!
+     * \brief messagesFrom Number of messages that a terminal injects in the network
+     */
+    unsigned long messagesFrom(unsigned short terminal) const;
+
+    /*!
+     * \brief nextMessage Get the next message of the terminal ready until the current cycle
+     * \return true if there is a message to be injected
+     */
+    bool nextMessage(unsigned short terminal, unsigned long long cycle, Message& message);
+
+    /*!
+     * \brief messageArrived It resolves the dependency of the target task of the edge
+     */
+    void messageArrived(unsigned int edge, unsigned long long cycle);
+
+    /*!
+     * \brief finished It determines if the terminal has no more messages to inject
+     */
+    bool finished(unsigned short terminal) const;
+
+    /*!
+     * \brief completed It determines if all the tasks were executed
+     */
+    bool completed() const { return finishedTasks == tasks.size(); }
+
+    unsigned long long makespan() const { return completed() ? lastFinishCycle - startCycle : 0; }
+
+    void writeReport(FILE* out) const;
+
+    ~TaskGraph() {}
+
+private:
+    struct Task {
+        unsigned short terminal;
+        unsigned long long computeCycles;
+        std::vector<unsigned int> outputs;  // Output edges
+        unsigned int pendingInputs;         // Input messages not yet arrived
+        unsigned int lastInput;             // Last input edge to arrive (TASK_NONE: no inputs)
+        unsigned int previousTask;          // Task executed before on the terminal, if it delayed the start
+        unsigned long long readyCycle;
+        unsigned long long startCycle;
+        unsigned long long finishCycle;
+        bool finished;
+    };
+
+    struct Edge {
+        unsigned int source;
+        unsigned int target;
+        unsigned int payloadLength;
+        unsigned long long readyCycle;      // Source task finished
+        unsigned long long arrivalCycle;    // Trailer delivered to the target terminal
+    };
+
+    struct Terminal {
+        std::deque<unsigned int> readyTasks;    // Tasks waiting for the terminal
+        std::deque<Message> outbox;             // Messages waiting for the injection (sorted by ready cycle)
+        unsigned int runningTask;               // TASK_NONE: idle
+        unsigned int lastTask;                  // Last task executed on the terminal
+        unsigned int unfinishedTasks;
+        unsigned long networkMessages;
+    };
+
+    struct FinishEvent {
+        unsigned long long cycle;
+        unsigned int task;
+        bool operator> (const FinishEvent& e) const
+            { return cycle > e.cycle || (cycle == e.cycle && task > e.task); }
+    };
+
+    static TaskGraph* taskGraph;
+
+    std::vector<Task> tasks;
+    std::vector<Edge> edges;
+    std::vector<Terminal> terminals;
+    std::priority_queue<FinishEvent,std::vector<FinishEvent>,std::greater<FinishEvent> > events;
+
+    bool started;
+    unsigned long long startCycle;
+    unsigned long long lastFinishCycle;
+    unsigned int lastTask;              // Last task to finish - end of the critical path
+    unsigned int finishedTasks;
+
+    TaskGraph();
+    TaskGraph(const TaskGraph&);
+    TaskGraph& operator= (const TaskGraph&);
+
+    bool open(const char* fileName);
+    bool readCount(FILE* file, const char* section, unsigned int& count);
+    bool isAcyclic() const;
+    void advance(unsigned long long cycle);
+    void inputArrived(unsigned int task, unsigned int edge, unsigned long long cycle);
+    void startTask(unsigned int task, unsigned long long cycle);
+    void finishTask(unsigned int task, unsigned long long cycle);
+};
+
+#endif // __TASKGRAPH_H__
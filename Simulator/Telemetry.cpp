@@ -0,0 +1,179 @@
+#include "Telemetry.h"
+#include "../StopSim/StopSim.h"
+#include "../TrafficMeter/TrafficMeter.h"
+#include "../Parameters/Instrumentation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__WIN32__) || defined(_WIN32)
+#include <windows.h>
+#include <process.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+Telemetry::Telemetry(sc_module_name mn,
+                     unsigned int interval,
+                     StopSim *stopSim,
+                     const std::vector<TrafficMeter *> &meters)
+    : SoCINModule(mn),
+      i_CLK("Telemetry_iCLK"),
+      i_RST("Telemetry_iRST"),
+      i_CLK_CYCLES("Telemetry_iCLK_CYCLES"),
+      interval(interval > 0 ? interval : 1),
+      stopSim(stopSim),
+      meters(meters),
+      segment(NULL),
+      lastCycle(0),
+      lastFlits(0),
+      lastPackets(0),
+      lastLatencySum(0),
+      lastWallTime(0.0)
+{
+    // Woken up by time (every interval cycles), not on each clock edge
+    SC_METHOD(p_UPDATE);
+}
+
+Telemetry::~Telemetry() {
+    if( segment == NULL ) {
+        return;
+    }
+#if defined(__WIN32__) || defined(_WIN32)
+    UnmapViewOfFile(segment);
+#else
+    munmap(segment,sizeof(TelemetrySegment));
+#endif
+}
+
+bool Telemetry::open(const char *fileName) {
+
+    void* memory = NULL;
+#if defined(__WIN32__) || defined(_WIN32)
+    HANDLE file = CreateFileA(fileName,GENERIC_READ | GENERIC_WRITE,FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              NULL,CREATE_ALWAYS,FILE_ATTRIBUTE_NORMAL,NULL);
+    if( file != INVALID_HANDLE_VALUE ) {
+        HANDLE mapping = CreateFileMappingA(file,NULL,PAGE_READWRITE,0,sizeof(TelemetrySegment),NULL);
+        if( mapping != NULL ) {
+            memory = MapViewOfFile(mapping,FILE_MAP_ALL_ACCESS,0,0,sizeof(TelemetrySegment));
+            CloseHandle(mapping); // The view keeps the mapping
+        }
+        CloseHandle(file);
+    }
+#else
+    int file = ::open(fileName,O_RDWR | O_CREAT | O_TRUNC,0644);
+    if( file >= 0 ) {
+        if( ftruncate(file,sizeof(TelemetrySegment)) == 0 ) {
+            memory = mmap(NULL,sizeof(TelemetrySegment),PROT_READ | PROT_WRITE,MAP_SHARED,file,0);
+            if( memory == MAP_FAILED ) {
+                memory = NULL;
+            }
+        }
+        ::close(file); // The mapping keeps the file
+    }
+#endif
+    if( memory == NULL ) {
+        printf("\n[Telemetry] ERROR: It is not possible to map the file \"%s\".",fileName);
+        return false;
+    }
+
+    segment = (TelemetrySegment*) memory;
+    memset(segment,0,sizeof(TelemetrySegment));
+    memcpy(segment->magic,TELEMETRY_MAGIC,4);
+    segment->version = TELEMETRY_VERSION;
+#if defined(__WIN32__) || defined(_WIN32)
+    segment->processId = (uint32_t) _getpid();
+#else
+    segment->processId = (uint32_t) getpid();
+#endif
+    segment->numElements = (uint32_t) meters.size();
+    segment->interval = interval;
+    segment->state = TelemetrySegment::Running;
+
+    start = std::chrono::steady_clock::now();
+    return true;
+}
+
+void Telemetry::p_UPDATE() {
+    if( segment != NULL && sc_time_stamp() > SC_ZERO_TIME ) {
+        this->update(i_CLK_CYCLES.read(),TelemetrySegment::Running);
+    }
+    next_trigger(interval * CLK_PERIOD,SC_NS);
+}
+
+void Telemetry::finish() {
+    if( segment != NULL ) {
+        this->update(i_CLK_CYCLES.read(),TelemetrySegment::Finished);
+    }
+}
+
+static bool moreCongested(const TelemetrySegment::Link& a, const TelemetrySegment::Link& b) {
+    return a.stallRatio > b.stallRatio || (a.stallRatio == b.stallRatio && a.utilization > b.utilization);
+}
+
+void Telemetry::update(unsigned long long cycle, TelemetrySegment::State state) {
+
+    // Totals
+    unsigned long long flits = 0, packets = 0, latencySum = 0, latencyMax = 0;
+    for( unsigned int i = 0; i < meters.size(); i++ ) {
+        flits += meters[i]->flitsReceived;
+        packets += meters[i]->networkLatency.count();
+        latencySum += meters[i]->networkLatency.sumOfValues();
+        latencyMax = std::max(latencyMax,meters[i]->networkLatency.max());
+    }
+    double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double windowCycles = cycle > lastCycle ? (double) (cycle - lastCycle) : 1.0;
+
+    // Links with the most cycles waiting in the window
+    const std::vector<LinkCounters*>& links = INSTRUMENTATION->linkList();
+    lastLinkFlits.resize(links.size(),0);
+    lastLinkStalls.resize(links.size(),0);
+    std::vector<TelemetrySegment::Link> linkWindow(links.size());
+    for( unsigned int i = 0; i < links.size(); i++ ) {
+        TelemetrySegment::Link& l = linkWindow[i];
+        l.routerId = links[i]->routerId;
+        l.portId = links[i]->portId;
+        l.reserved = 0;
+        l.utilization = (links[i]->flits - lastLinkFlits[i]) / windowCycles;
+        l.stallRatio = (links[i]->stallCycles - lastLinkStalls[i]) / windowCycles;
+        lastLinkFlits[i] = links[i]->flits;
+        lastLinkStalls[i] = links[i]->stallCycles;
+    }
+    unsigned int numberOfLinks = std::min((unsigned int) linkWindow.size(),(unsigned int) TELEMETRY_TOP_LINKS);
+    std::partial_sort(linkWindow.begin(),linkWindow.begin()+numberOfLinks,linkWindow.end(),moreCongested);
+
+    // Publishing - the readers retry while the sequence is odd or changes
+    segment->sequence++;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    segment->state = state;
+    segment->cycle = cycle;
+    segment->updates++;
+    segment->wallTime = wallTime;
+    segment->cyclesPerSecond = wallTime > lastWallTime ? (cycle - lastCycle) / (wallTime - lastWallTime) : 0.0;
+    segment->packetsSent = stopSim->r_TOTAL_PACKETS_SENT.read();
+    segment->packetsReceived = stopSim->r_TOTAL_PACKETS_RECEIVED.read();
+    segment->packetsDelivered = packets;
+    segment->flitsDelivered = flits;
+    segment->latencyMean = packets > 0 ? (double) latencySum / packets : 0.0;
+    segment->latencyMax = latencyMax;
+    segment->throughput = meters.empty() ? 0.0 : (flits - lastFlits) / windowCycles / meters.size();
+    segment->packetsPerCycle = (packets - lastPackets) / windowCycles;
+    segment->windowLatencyMean = packets > lastPackets ? (double) (latencySum - lastLatencySum) / (packets - lastPackets) : 0.0;
+    segment->numberOfLinks = numberOfLinks;
+    for( unsigned int i = 0; i < numberOfLinks; i++ ) {
+        segment->topLinks[i] = linkWindow[i];
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    segment->sequence++;
+
+    lastCycle = cycle;
+    lastFlits = flits;
+    lastPackets = packets;
+    lastLatencySum = latencySum;
+    lastWallTime = wallTime;
+}
@@ -0,0 +1,69 @@
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include "../SoCINModule.h"
+#include "TelemetrySegment.h"
+
+#include <vector>
+#include <chrono>
+
+class StopSim;
+class TrafficMeter;
+
+/*!
+ * \brief The Telemetry class publishes the progress of the simulation in
+ * a file mapped in memory (TelemetrySegment), updated every interval
+ * cycles, to be watched by the telemetry viewer while the simulation runs.
+ * The update only writes memory: no I/O is done by the simulation.
+ */
+class Telemetry : public SoCINModule {
+public:
+    // System signals
+    sc_in<bool>          i_CLK;
+    sc_in<bool>          i_RST;
+    sc_in<unsigned long long> i_CLK_CYCLES;
+
+    // Module's process
+    void p_UPDATE();
+
+    /*!
+     * \brief open It creates and maps the telemetry file
+     */
+    bool open(const char* fileName);
+
+    /*!
+     * \brief finish It publishes the last update and the end of simulation
+     */
+    void finish();
+
+    SC_HAS_PROCESS(Telemetry);
+    Telemetry(sc_module_name mn,
+              unsigned int interval,
+              StopSim* stopSim,
+              const std::vector<TrafficMeter*>& meters);
+
+    ModuleType moduleType() const { return SoCINModule::OtherT; }
+    const char* moduleName() const { return "Telemetry"; }
+
+    ~Telemetry();
+
+private:
+    unsigned int interval;
+    StopSim* stopSim;
+    std::vector<TrafficMeter*> meters;
+    TelemetrySegment* segment;
+
+    // Totals of the previous update - for the window
+    unsigned long long lastCycle;
+    unsigned long long lastFlits;
+    unsigned long long lastPackets;
+    unsigned long long lastLatencySum;
+    std::vector<unsigned long long> lastLinkFlits;
+    std::vector<unsigned long long> lastLinkStalls;
+    std::chrono::steady_clock::time_point start;
+    double lastWallTime;
+
+    void update(unsigned long long cycle, TelemetrySegment::State state);
+};
+
+#endif // __TELEMETRY_H__
@@ -0,0 +1,58 @@
+#ifndef __TELEMETRYSEGMENT_H__
+#define __TELEMETRYSEGMENT_H__
+
+#include <stdint.h>
+
+#define TELEMETRY_FILENAME "telemetry.bin"
+#define TELEMETRY_MAGIC    "SNTM"
+#define TELEMETRY_VERSION  1
+#define TELEMETRY_TOP_LINKS 8 // Most congested links published
+
+/*!
+ * \brief The TelemetrySegment struct is the content of the telemetry file,
+ * mapped in memory by the simulator (writer) and by the viewers (readers).
+ *
+ * The simulator updates it every interval cycles. The sequence is odd
+ * while an update is in progress: a reader copies the segment and retries
+ * if the sequence was odd or changed during the copy.
+ */
+struct TelemetrySegment {
+    enum State { Running = 0, Finished };
+
+    char     magic[4];              // "SNTM"
+    uint32_t version;               // Format version
+    volatile uint32_t sequence;     // Update counter (odd: updating)
+    uint32_t state;                 // Running or Finished
+    uint32_t processId;             // Simulator process
+    uint32_t numElements;           // Terminals of the network
+    uint32_t interval;              // Cycles between two updates
+    uint32_t numberOfLinks;         // Valid entries in topLinks (0 without link counters)
+
+    uint64_t cycle;                 // Cycle of the last update
+    uint64_t updates;               // Number of updates
+    double   wallTime;              // Seconds since the simulation started
+    double   cyclesPerSecond;       // Simulation speed in the last window
+
+    // Totals since the beginning of the simulation
+    uint64_t packetsSent;           // Summed by the StopSim
+    uint64_t packetsReceived;
+    uint64_t packetsDelivered;      // Received by the traffic meters
+    uint64_t flitsDelivered;
+    double   latencyMean;           // Network latency (cycles)
+    uint64_t latencyMax;
+
+    // Last window (interval cycles)
+    double   throughput;            // Accepted traffic (flits/cycle/node)
+    double   packetsPerCycle;       // Packets delivered per cycle
+    double   windowLatencyMean;     // Network latency of the packets delivered in the window
+
+    struct Link {
+        uint16_t routerId;
+        uint16_t portId;
+        uint32_t reserved;
+        double   utilization;       // Flits/cycle in the window
+        double   stallRatio;        // Fraction of the window cycles with a flit waiting for the link
+    } topLinks[TELEMETRY_TOP_LINKS]; // Sorted by stall ratio
+};
+
+#endif // __TELEMETRYSEGMENT_H__
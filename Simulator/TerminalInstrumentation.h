@@ -37,7 +37,7 @@ public:
     sc_vector<sc_out<bool> > o_VC; // Virtual channel selector of the packet sent
 
     // Internal signals
-    sc_signal<Flit> w_DATA_SEND;
+    sc_signal<PacketDescriptor> w_PACKET_SEND;
     sc_signal<bool> w_WRITE_OK_SEND;
     sc_signal<bool> w_WRITE_SEND;
     sc_signal<bool> w_READ_OK_SEND;
@@ -86,12 +86,16 @@ public:
         u_FIFO_OUT = new UnboundedFifo("FifoOutTG"); // Unbounded Fifo Packet Source
         u_FIFO_OUT->i_CLK(i_CLK);
         u_FIFO_OUT->i_RST(i_RST);
-        u_FIFO_OUT->i_DATA_IN(w_DATA_SEND);
+        u_FIFO_OUT->i_CLK_CYCLES(i_CLK_CYCLES);
+        u_FIFO_OUT->i_PACKET_IN(w_PACKET_SEND);
         u_FIFO_OUT->i_WR(w_WRITE_SEND);
         u_FIFO_OUT->i_RD(w_READ_SEND);
         u_FIFO_OUT->o_WR_OK(w_WRITE_OK_SEND);
         u_FIFO_OUT->o_RD_OK(w_READ_OK_SEND);
         u_FIFO_OUT->o_DATA_OUT(o_DATA_OUT);
+        if( NUM_VC > 1 ) {
+            u_FIFO_OUT->o_VC(o_VC);
+        }
 
         //////////////////////////////////////////////
         u_OFC = PLUGIN_MANAGER->outputFlowControlInstance("TG_OFC",0,0,FIFO_IN_DEPTH);
@@ -150,7 +154,7 @@ public:
         u_FG->i_CLK(i_CLK);
         u_FG->i_RST(i_RST);
         u_FG->i_CLK_CYCLES(i_CLK_CYCLES);
-        u_FG->o_DATA_SEND(w_DATA_SEND);
+        u_FG->o_PACKET_SEND(w_PACKET_SEND);
         u_FG->o_WRITE_SEND(w_WRITE_SEND);
         u_FG->i_WRITE_OK_SEND(w_WRITE_OK_SEND);
         u_FG->i_DATA_RECEIVE(w_DATA_RECEIVE);
@@ -159,9 +163,6 @@ public:
         u_FG->o_END_OF_TRANSMISSION(o_END_OF_TRANSMISSION);
         u_FG->o_NUMBER_OF_PACKETS_SENT(o_NUMBER_OF_PACKETS_SENT);
         u_FG->o_NUMBER_OF_PACKETS_RECEIVED(o_NUMBER_OF_PACKETS_RECEIVED);
-        if( NUM_VC > 1 ) {
-            u_FG->o_VC_SEND(o_VC);
-        }
 #endif
     }
 
@@ -0,0 +1,103 @@
+#include "TimeSeries.h"
+#include "TerminalInstrumentation.h"
+#include "../TrafficMeter/TrafficMeter.h"
+#include "../TrafficMeter/LogWriter.h"
+
+TimeSeries::TimeSeries(sc_module_name mn,
+                       unsigned int interval,
+                       const std::vector<TerminalInstrumentation *> &terminals,
+                       const std::vector<TrafficMeter *> &meters)
+    : SoCINModule(mn),
+      i_CLK("TimeSeries_iCLK"),
+      i_RST("TimeSeries_iRST"),
+      i_CLK_CYCLES("TimeSeries_iCLK_CYCLES"),
+      interval(interval > 0 ? interval : 1),
+      terminals(terminals),
+      meters(meters),
+      out(NULL),
+      lastCycle(0),
+      lastInjected(0),
+      lastDelivered(0),
+      lastFlits(0),
+      lastNetworkLatency(0),
+      lastTotalLatency(0)
+{
+    // Woken up by time (every interval cycles), not on each clock edge
+    SC_METHOD(p_SAMPLE);
+}
+
+TimeSeries::~TimeSeries() {
+    if( out != NULL ) {
+        fclose(out);
+    }
+}
+
+bool TimeSeries::open(const char *fileName) {
+    if( (out = fopen(fileName,"wt")) == NULL ) {
+        printf("\n[TimeSeries] ERROR: It is not possible to open the file \"%s\".",fileName);
+        return false;
+    }
+    LOG_WRITER->print(out,"# Traffic by window of %u cycles (Cycle: end of the window) - Accepted: flits/cycle/node;\n"
+                          "# Latency (mean, max): injection to delivery of the packets delivered in the window;\n"
+                          "# Total: creation to delivery; In flight: injected and not delivered at the end of the window\n",
+                      interval);
+    LOG_WRITER->print(out,"#        Cycle\tAccepted\tDelivered\tLatency\t    Max\t  Total\tInjected\tIn flight\n");
+    return true;
+}
+
+void TimeSeries::p_SAMPLE() {
+    if( out != NULL && sc_time_stamp() > SC_ZERO_TIME ) {
+        this->sample(i_CLK_CYCLES.read());
+    }
+    next_trigger(interval * CLK_PERIOD,SC_NS);
+}
+
+void TimeSeries::finish() {
+    if( out == NULL ) {
+        return;
+    }
+    unsigned long long cycle = i_CLK_CYCLES.read();
+    if( cycle > lastCycle ) {
+        this->sample(cycle);
+    }
+    LOG_WRITER->close(out);
+    out = NULL;
+}
+
+void TimeSeries::sample(unsigned long long cycle) {
+
+    // Totals
+    unsigned long long injected = 0, delivered = 0, flits = 0;
+    unsigned long long networkLatency = 0, totalLatency = 0, latencyMax = 0;
+    for( unsigned int i = 0; i < terminals.size(); i++ ) {
+        injected += terminals[i]->u_FIFO_OUT->packetsInjected;
+    }
+    for( unsigned int i = 0; i < meters.size(); i++ ) {
+        TrafficMeter* meter = meters[i];
+        delivered += meter->packetsReceived;
+        flits += meter->flitsReceived;
+        networkLatency += meter->networkLatency.sumOfValues();
+        totalLatency += meter->totalLatency.sumOfValues();
+        if( meter->windowLatencyMax > latencyMax ) {
+            latencyMax = meter->windowLatencyMax;
+        }
+        meter->windowLatencyMax = 0;
+    }
+
+    // Window
+    double windowCycles = cycle > lastCycle ? (double) (cycle - lastCycle) : 1.0;
+    unsigned long long packets = delivered - lastDelivered;
+    double accepted = meters.empty() ? 0.0 : (flits - lastFlits) / windowCycles / meters.size();
+    double latencyMean = packets > 0 ? (double) (networkLatency - lastNetworkLatency) / packets : 0.0;
+    double totalMean = packets > 0 ? (double) (totalLatency - lastTotalLatency) / packets : 0.0;
+    LOG_WRITER->print(out,"%14llu\t%8.5f\t%9llu\t%7.2f\t%7llu\t%7.2f\t%8llu\t%9llu\n",
+                      cycle,accepted,packets,latencyMean,latencyMax,totalMean,
+                      injected - lastInjected,injected > delivered ? injected - delivered : 0);
+
+    lastCycle = cycle;
+    lastInjected = injected;
+    lastDelivered = delivered;
+    lastFlits = flits;
+    lastNetworkLatency = networkLatency;
+    lastTotalLatency = totalLatency;
+}
@@ -0,0 +1,72 @@
+#ifndef __TIMESERIES_H__
+#define __TIMESERIES_H__
+
+#include "../SoCINModule.h"
+
+#include <vector>
+#include <cstdio>
+
+#define TIME_SERIES_FILENAME "timeseries.out"
+
+class TerminalInstrumentation;
+class TrafficMeter;
+
+/*!
+ * \brief The TimeSeries class writes, every interval cycles, one line with
+ * the traffic of the window: accepted throughput, packets delivered, mean
+ * and maximum latency of these packets, packets injected and packets in
+ * the network at the end of the window. The windows are the differences
+ * of the totals kept by the sources and the traffic meters (the maximum
+ * latency of the window is kept by the meters and reset here), so the
+ * simulation only updates its counters and the line is written by the
+ * log writer.
+ */
+class TimeSeries : public SoCINModule {
+public:
+    // System signals
+    sc_in<bool>          i_CLK;
+    sc_in<bool>          i_RST;
+    sc_in<unsigned long long> i_CLK_CYCLES;
+
+    // Module's process
+    void p_SAMPLE();
+
+    /*!
+     * \brief open It creates the time series file
+     */
+    bool open(const char* fileName);
+
+    /*!
+     * \brief finish It writes the last window (incomplete) and closes the file
+     */
+    void finish();
+
+    SC_HAS_PROCESS(TimeSeries);
+    TimeSeries(sc_module_name mn,
+               unsigned int interval,
+               const std::vector<TerminalInstrumentation*>& terminals,
+               const std::vector<TrafficMeter*>& meters);
+
+    ModuleType moduleType() const { return SoCINModule::OtherT; }
+    const char* moduleName() const { return "TimeSeries"; }
+
+    ~TimeSeries();
+
+private:
+    unsigned int interval;
+    std::vector<TerminalInstrumentation*> terminals;
+    std::vector<TrafficMeter*> meters;
+    FILE* out;
+
+    // Totals of the previous window
+    unsigned long long lastCycle;
+    unsigned long long lastInjected;
+    unsigned long long lastDelivered;
+    unsigned long long lastFlits;
+    unsigned long long lastNetworkLatency;
+    unsigned long long lastTotalLatency;
+
+    void sample(unsigned long long cycle);
+};
+
+#endif // __TIMESERIES_H__
@@ -1,5 +1,38 @@
 #include "TypeInjection.h"
 
+#include <cmath>
+
 TypeInjection::TypeInjection(unsigned short numCyclesPerFlit)
-    : numCyclesPerFlit(numCyclesPerFlit)
+    : numCyclesPerFlit(numCyclesPerFlit), onPeriod(0), offPeriod(0)
 {}
+
+void TypeInjection::prepareNextPacket(FlowGenerator::FlowParameters &flow) {
+    // PARETO-based generation
+    do {
+        float r   = (float) random.uniform();
+        onPeriod  = pow( (float)(1-r),(-1.0/flow.parameter1) );
+        offPeriod = pow( (float)(1-r),(-1.0/flow.parameter2) );
+        // If function of probability is Pareto, it determines the required bw
+        flow.required_bw = onPeriod/(onPeriod+offPeriod);
+        this->adjustFlow(flow);
+    } while (flow.payload_length == 0);
+}
+
+TypeInjection* TypeInjection::create(unsigned int type, unsigned short numCyclesPerFlit) {
+    std::map<unsigned int,Creator>::iterator it = registry().find(type);
+    if( it == registry().end() ) {
+        return NULL;
+    }
+    return it->second(numCyclesPerFlit);
+}
+
+bool TypeInjection::registerType(unsigned int type, Creator creator) {
+    registry()[type] = creator;
+    return true;
+}
+
+std::map<unsigned int,TypeInjection::Creator>& TypeInjection::registry() {
+    // Built on first use, because the processes register themselves during the static initialization
+    static std::map<unsigned int,Creator> creators;
+    return creators;
+}
@@ -2,14 +2,59 @@
 #define __TYPEINJECTION_H__
 
 #include "FlowGenerator.h"
+#include "../Parameters/RandomStream.h"
 
+#include <map>
+
+/*!
+ * \brief The TypeInjection class is the injection process of a flow.
+ *
+ * One object is bound to each flow when the traffic file is read and it is
+ * kept during all the simulation, so it may hold the state of the process.
+ * New processes are made available to the traffic file by registering them
+ * with REGISTER_TYPE_INJECTION in their source file.
+ */
 class TypeInjection {
 protected:
     unsigned short numCyclesPerFlit;
+    float onPeriod;     // Last ON period sampled by the Pareto model
+    float offPeriod;    // Last OFF period sampled by the Pareto model
+    RandomStream random;// Stream of the flow (one independent stream per flow)
 public:
+    typedef TypeInjection* (*Creator)(unsigned short numCyclesPerFlit);
+
     TypeInjection(unsigned short numCyclesPerFlit);
+    virtual ~TypeInjection() {}
+
+    void setRandomStream(const RandomStream& stream) { random = stream; }
+
+    /*!
+     * \brief prepareNextPacket It determines the parameters of the next
+     * packet of the flow. By default, the required bandwidth is sampled
+     * from a Pareto ON/OFF model (alfa_on = parameter1, alfa_off =
+     * parameter2) and the flow is adjusted to it.
+     */
+    virtual void prepareNextPacket(FlowGenerator::FlowParameters& flow);
 
     virtual void adjustFlow(FlowGenerator::FlowParameters& flow) = 0;
+
+    /*!
+     * \brief acceptSizeDistribution It is called when the flow has a packet
+     * size distribution (the payload length is sampled for each packet).
+     * \return false if the process determines the payload length itself
+     */
+    virtual bool acceptSizeDistribution(const FlowGenerator::FlowParameters&) { return true; }
+
+    static TypeInjection* create(unsigned int type, unsigned short numCyclesPerFlit);
+    static bool registerType(unsigned int type, Creator creator);
+
+private:
+    static std::map<unsigned int,Creator>& registry();
 };
 
+// Register an injection process to be used by the flows with the type identifier
+#define REGISTER_TYPE_INJECTION(TYPE_ID,CLASS) \
+    static TypeInjection* new_##CLASS(unsigned short numCyclesPerFlit) { return new CLASS(numCyclesPerFlit); } \
+    static const bool registered_##CLASS = TypeInjection::registerType(TYPE_ID,new_##CLASS);
+
 #endif // __TYPEINJECTION_H__
@@ -1,25 +1,92 @@
 #include "UnboundedFifo.h"
+#include "../Parameters/Parameters.h"
+#include "../Parameters/PacketTracer.h"
+#include "../Parameters/LatencyBreakdown.h"
 
 UnboundedFifo::UnboundedFifo(sc_module_name mn)
     : SoCINModule(mn),
       i_CLK("UnboundedFifo_i"),
       i_RST("UnboundedFifo_iRST"),
-      i_DATA_IN("UnboundedFifo_iDATA_IN"),
+      i_CLK_CYCLES("UnboundedFifo_iCLK_CYCLES"),
+      i_PACKET_IN("UnboundedFifo_iPACKET_IN"),
       i_RD("UnboundedFifo_iREAD"),
       i_WR("UnboundedFifo_iWRITE"),
       o_RD_OK("UnboundedFifo_oREAD_OK"),
       o_WR_OK("UnboundedFifo_oWRITE_OK"),
-      o_DATA_OUT("UnboundedFifo_oDATA_OUT")
+      o_DATA_OUT("UnboundedFifo_oDATA_OUT"),
+      o_VC("UnboundedFifo_oVC"),
+      packetsOffered(0),
+      flitsOffered(0),
+      packetsInjected(0),
+      flitsInjected(0),
+      flitIndex(0),
+      flitsStored(0),
+      flitsPending(0)
 {
     o_WR_OK.initialize(1);
 
+    vcWidth = (unsigned short) ceil(log2(NUM_VC));
+    if( vcWidth > 0 ) {
+        o_VC.init( vcWidth );
+    }
+
     SC_METHOD(fifoProcess);
     sensitive << i_CLK.pos();
 }
 
 UnboundedFifo::~UnboundedFifo() {
-    while(!m_FIFO.empty()) {
-        m_FIFO.pop();
+    m_FIFO.clear();
+}
+
+unsigned long UnboundedFifo::numberOfFlits() const {
+    if( i_WR.read() == 1 ) {
+        return flitsStored + flitsPending + i_PACKET_IN.read().numberOfFlits();
+    }
+    return flitsStored + flitsPending;
+}
+
+void UnboundedFifo::push(const PacketDescriptor &descriptor) {
+    PendingPacket pending;
+    pending.descriptor = descriptor;
+    pending.pushTime = sc_time_stamp();
+    m_PENDING.push_back(pending);
+    flitsPending += descriptor.numberOfFlits();
+}
+
+/*!
+ * \brief UnboundedFifo::frontFlit It builds the flit of the packet in the
+ * front of the FIFO that is pointed by the flit index.
+ */
+Flit UnboundedFifo::frontFlit() const {
+
+    const PacketDescriptor& descriptor = m_FIFO.front();
+
+    Flit flit;
+    flit.packet_ptr = descriptor.packet;
+    if( flitIndex == 0 ) {                              // Header
+        flit.data = descriptor.header;
+    } else if( flitIndex < descriptor.payloadLength ) { // Payload
+        flit.data = flitIndex - 1; // The content of the flit is only the number of flit in the packet
+    } else {                                            // Trailer
+        flit.data = descriptor.trailer;
+        flit.data[FLIT_WIDTH-1] = 1;
+    }
+    return flit;
+}
+
+void UnboundedFifo::updateOutputs(bool newPacket) {
+    if( m_FIFO.empty() ) {
+        o_DATA_OUT.write(0);
+        o_RD_OK.write(0);
+    } else {
+        o_DATA_OUT.write( this->frontFlit() );
+        o_RD_OK.write(1);
+        if( newPacket ) {   // The VC selector follows the packet in the front
+            UIntVar v_VC = m_FIFO.front().virtualChannel;
+            for(unsigned short i = 0; i < vcWidth; i++) {
+                o_VC[i].write(v_VC[i]);
+            }
+        }
     }
 }
 
@@ -29,29 +96,66 @@ void UnboundedFifo::fifoProcess() {
         o_RD_OK.write(0);
         o_WR_OK.write(1);
         o_DATA_OUT.write(0);
-        while(!m_FIFO.empty()) {
-            m_FIFO.pop();
-        }
+        m_FIFO.clear();
+        m_PENDING.clear();
+        flitIndex = 0;
+        flitsStored = 0;
+        flitsPending = 0;
     } else {
+        bool updateOutput = false;
+        bool newPacket = false;
+
         if( i_RD.read() == 1 ) {    // Read - only remove data from the FIFO if it isn't empty
             if(!m_FIFO.empty()) {
-                m_FIFO.pop();
+                flitsStored--;
+                flitsInjected++;
+                if( flitIndex == 0 ) {
+                    packetsInjected++;
+                    if( m_FIFO.front().packet != NULL ) { // Header read - the packet enters the network
+                        m_FIFO.front().packet->injectionCycle = i_CLK_CYCLES.read();
+                        if( m_FIFO.front().packet->traced ) {
+                            PACKET_TRACER->injected(m_FIFO.front().packet->packetId,i_CLK_CYCLES.read());
+                        }
+                        LATENCY_BREAKDOWN->injected(m_FIFO.front().packet->packetId,i_CLK_CYCLES.read());
+                    }
+                }
+                if( flitIndex == m_FIFO.front().payloadLength ) { // Trailer read - remove the packet
+                    m_FIFO.pop_front();
+                    flitIndex = 0;
+                    newPacket = true;
+                } else {
+                    flitIndex++;
+                }
             }
+            updateOutput = true;
+        }
 
-            if( m_FIFO.empty() ) {  // if the fifo is empty after remove the data, then reset the outputs
-                o_DATA_OUT.write(0);
-                o_RD_OK.write(0);
-            } else {                // if fifo isn't empty after remove the data, then update the outputs
-                o_DATA_OUT.write( m_FIFO.front() );
-                o_RD_OK.write(1);
-            }
+        if( i_WR.read() == 1 ) {    // It writes in fifo a whole packet
+            const PacketDescriptor& descriptor = i_PACKET_IN.read();
+            newPacket = newPacket || m_FIFO.empty();
+            m_FIFO.push_back( descriptor );
+            flitsStored += descriptor.numberOfFlits();
+            packetsOffered++;
+            flitsOffered += descriptor.numberOfFlits();
+            updateOutput = true;
         }
 
-        if( i_WR.read() == 1 ) {              // It writes in fifo
-            m_FIFO.push( i_DATA_IN.read() );  // Puts on the queue
-            o_DATA_OUT.write(m_FIFO.front()); // Update the output data if necessary
-            o_RD_OK.write(1);                 // Enable FIFO-!EMPTY because of the write
+        // Packets pushed before this clock edge (the ones pushed on the same
+        // edge are stored on the next one, whatever the process order)
+        while( !m_PENDING.empty() && m_PENDING.front().pushTime < sc_time_stamp() ) {
+            const PacketDescriptor& descriptor = m_PENDING.front().descriptor;
+            newPacket = newPacket || m_FIFO.empty();
+            m_FIFO.push_back( descriptor );
+            flitsStored += descriptor.numberOfFlits();
+            flitsPending -= descriptor.numberOfFlits();
+            packetsOffered++;
+            flitsOffered += descriptor.numberOfFlits();
+            m_PENDING.pop_front();
+            updateOutput = true;
+        }
+
+        if( updateOutput ) {
+            this->updateOutputs(newPacket);
         }
     }
 }
-
@@ -4,26 +4,81 @@
 #include "../SoCINModule.h"
 #include "../SoCINDefines.h"
 
-#include <queue>
+#include <deque>
+
+/*!
+ * \brief The PacketDescriptor struct is a packet waiting in the terminal
+ * source queue. The flits are only built when they are read by the output
+ * flow controller.
+ */
+struct PacketDescriptor {
+    Packet* packet;                 // Packet information (shared by all the flits)
+    UIntVar header;                 // Header flit (framing, addressing and control fields)
+    unsigned short virtualChannel;  // Virtual channel used by the packet
+    unsigned short payloadLength;   // Number of flits in the payload (including the trailer)
+    unsigned long  trailer;         // Content of the trailer (packet id, or the request id in a reply)
+
+    PacketDescriptor() : packet(NULL), virtualChannel(0), payloadLength(0), trailer(0) {}
+
+    inline unsigned int numberOfFlits() const { return packet != NULL ? payloadLength + 1 : 0; }
+
+    bool operator== (const PacketDescriptor& d) const
+    { return ( this->packet == d.packet && this->header == d.header
+               && this->virtualChannel == d.virtualChannel && this->payloadLength == d.payloadLength
+               && this->trailer == d.trailer ); }
+
+    friend std::ostream& operator<<(std::ostream& os, const PacketDescriptor& d)
+    {
+        os << "{" << "Header:" << d.header.to_string(SC_HEX_US) << ","
+           << "VC:" << d.virtualChannel << ","
+           << "Payload:" << d.payloadLength << ","
+           << "Packet_ID:" << d.packet << "}";
+        return os;
+    }
+
+    friend void sc_trace(::sc_core::sc_trace_file* tf, const PacketDescriptor& d, const std::string& nm)
+    { sc_trace( tf, d.header, nm ); }
+};
 
 class UnboundedFifo : public SoCINModule {
 public:
     // System signals
     sc_in<bool>      i_CLK;     // Clock
     sc_in<bool>      i_RST;     // Reset
+    sc_in<unsigned long long> i_CLK_CYCLES; // Global clock counter - to stamp the injection of the packets
     // FIFO interface
-    sc_in<Flit>      i_DATA_IN; // Input data channel
-    sc_in<bool>      i_RD;      // Command to read a data from the FIFO
-    sc_in<bool>      i_WR;      // Command to write a data into FIFO
+    sc_in<PacketDescriptor> i_PACKET_IN; // Input packet channel
+    sc_in<bool>      i_RD;      // Command to read a flit from the FIFO
+    sc_in<bool>      i_WR;      // Command to write a packet into FIFO
     sc_out<bool>     o_RD_OK;   // FIFO has a data to be read (not empty)
     sc_out<bool>     o_WR_OK;   // FIFO has room to be written (not full)
     sc_out<Flit>     o_DATA_OUT;// Output data channel
+    sc_vector<sc_out<bool> > o_VC; // Virtual channel selector of the packet in the front
 
-    std::queue<Flit> m_FIFO; // The FIFO
+    std::deque<PacketDescriptor> m_FIFO; // The FIFO
+
+    // Totals of the traffic of the terminal (run summary)
+    unsigned long long packetsOffered;  // Packets written by the source
+    unsigned long long flitsOffered;
+    unsigned long long packetsInjected; // Packets whose header was read (entered the network)
+    unsigned long long flitsInjected;
+
+    /*!
+     * \brief push It writes a whole packet without the write signals (used by
+     * the injection scheduler). As a write by i_WR, the packet is stored on
+     * the next clock edge.
+     */
+    void push(const PacketDescriptor& descriptor);
 
     // Module's processes
     void fifoProcess();
 
+    /*!
+     * \brief numberOfFlits Number of flits not yet read from the FIFO,
+     * including a packet that is being written in the current cycle.
+     */
+    unsigned long numberOfFlits() const;
+
     SC_HAS_PROCESS(UnboundedFifo);
     UnboundedFifo(sc_module_name mn);
 
@@ -31,6 +86,21 @@ public:
     const char* moduleName() const { return "UnboundedFifo"; }
 
     ~UnboundedFifo();
+
+private:
+    unsigned short flitIndex;   // Flit of the packet in the front available in the output
+    unsigned long  flitsStored; // Number of flits stored in the FIFO
+    unsigned short vcWidth;     // Virtual channel selector width
+
+    struct PendingPacket {      // Packet pushed and not yet stored
+        PacketDescriptor descriptor;
+        sc_time pushTime;
+    };
+    std::deque<PendingPacket> m_PENDING;
+    unsigned long  flitsPending;// Number of flits of the pending packets
+
+    Flit frontFlit() const;
+    void updateOutputs(bool newPacket);
 };
 
 
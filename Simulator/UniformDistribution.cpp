@@ -2,15 +2,15 @@
 
 #include "../Parameters/Parameters.h"
 
-UniformDistribution::UniformDistribution()
-    : DestinationGenerator(), distribution(0,NUM_ELEMENTS-1)
+UniformDistribution::UniformDistribution(unsigned short source)
+    : DestinationGenerator(source)
 {}
 
 unsigned short UniformDistribution::getDestination(unsigned short source) {
 
     unsigned short dest;
     do {
-        dest = distribution(generator);
+        dest = (unsigned short) generator.uniformInt(NUM_ELEMENTS);
     } while(dest == source);
     return dest;
 }
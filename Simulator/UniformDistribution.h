@@ -4,10 +4,8 @@
 #include "DestinationGenerator.h"
 
 class UniformDistribution : public DestinationGenerator {
-private:
-    std::uniform_int_distribution<int> distribution;
 public:
-    UniformDistribution();
+    UniformDistribution(unsigned short source);
 
     unsigned short getDestination(unsigned short source);
 };
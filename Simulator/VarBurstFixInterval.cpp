@@ -2,6 +2,8 @@
 
 #include <cmath>
 
+REGISTER_TYPE_INJECTION(5,VarBurstFixInterval)
+
 VarBurstFixInterval::VarBurstFixInterval(unsigned short numCyclesPerFlit)
     : TypeInjection(numCyclesPerFlit)
 {}
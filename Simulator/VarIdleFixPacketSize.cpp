@@ -1,5 +1,7 @@
 #include "VarIdleFixPacketSize.h"
 
+REGISTER_TYPE_INJECTION(1,VariableIdleFixPacketSize)
+
 VariableIdleFixPacketSize::VariableIdleFixPacketSize(unsigned short numCyclesPerFlit)
     : TypeInjection(numCyclesPerFlit)
 {}
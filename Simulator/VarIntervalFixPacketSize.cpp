@@ -1,5 +1,7 @@
 #include "VarIntervalFixPacketSize.h"
 
+REGISTER_TYPE_INJECTION(4,VarIntervalFixPacketSize)
+
 VarIntervalFixPacketSize::VarIntervalFixPacketSize(unsigned short numCyclesPerFlit)
     : TypeInjection(numCyclesPerFlit)
 {}
@@ -1,5 +1,7 @@
 #include "VarPacketSizeFixIdle.h"
 
+REGISTER_TYPE_INJECTION(2,VarPacketSizeFixIdle)
+
 VarPacketSizeFixIdle::VarPacketSizeFixIdle(unsigned short numCyclesPerFlit)
     : TypeInjection(numCyclesPerFlit)
 {}
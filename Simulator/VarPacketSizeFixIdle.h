@@ -8,6 +8,7 @@ public:
     VarPacketSizeFixIdle(unsigned short numCyclesPerFlit);
 
     void adjustFlow(FlowGenerator::FlowParameters& flow);
+    bool acceptSizeDistribution(const FlowGenerator::FlowParameters&) { return false; } // The length follows the bandwidth
 };
 
 #endif // __VARPACKETSIZEFIXIDLE_H__
@@ -1,5 +1,7 @@
 #include "VarPacketSizeFixInterval.h"
 
+REGISTER_TYPE_INJECTION(3,VarPacketSizeFixInterval)
+
 VarPacketSizeFixInterval::VarPacketSizeFixInterval(unsigned short numCyclesPerFlit)
     : TypeInjection(numCyclesPerFlit)
 {}
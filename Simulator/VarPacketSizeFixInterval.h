@@ -8,6 +8,7 @@ public:
     VarPacketSizeFixInterval(unsigned short numCyclesPerFlit);
 
     void adjustFlow(FlowGenerator::FlowParameters& flow);
+    bool acceptSizeDistribution(const FlowGenerator::FlowParameters&) { return false; } // The length follows the bandwidth
 };
 
 #endif // VARPACKETSIZEFIXINTERARRIVAL_H
@@ -2,17 +2,29 @@
 #include "../StopSim/StopSim.h"
 #include "../SystemSignals/SystemSignals.h"
 #include "../TrafficMeter/TrafficMeter.h"
+#include "../TrafficMeter/LogWriter.h"
 
 #include "../PluginManager/PluginManager.h"
+#include "../Parameters/Instrumentation.h"
+#include "../Parameters/PacketTracer.h"
+#include "../Parameters/Waveform.h"
+#include "../Parameters/LatencyBreakdown.h"
 
 // TEMP
 #include "TerminalInstrumentation.h"
+#include "TaskGraph.h"
+#include "PhaseSchedule.h"
+#include "InjectionScheduler.h"
+#include "RunSummary.h"
+#include "Telemetry.h"
+#include "TimeSeries.h"
 
 // SystemC
 #include <systemc>
 
 // STL
 #include <ctime>
+#include <cstring>
 
 #define SNOCS_MAJOR 2
 #define SNOCS_MINOR 0
@@ -28,6 +40,17 @@ class InputParser;
 // Forward declaration of functions below the main
 unsigned int setupSimulator(int argc, char* argv[],InputParser& opt);
 void generateListNodesGtkwave(unsigned short numElements);
+static FILE* openReport(char* fileName, const char* name, const char* content);
+static unsigned short topologyDimensions(INoC::TopologyType topologyType);
+void writeClosedLoopReport(std::vector<TerminalInstrumentation *>& terminals);
+void writeTaskGraphReport();
+void writePhaseReport(unsigned long long endCycle);
+void writeLatencyReport(std::vector<TrafficMeter *>& meters);
+void writeLinkReport(unsigned long long cycles, unsigned short dimensions);
+void writeBufferReport(unsigned short dimensions);
+void writeBreakdownReport();
+void writeStallReport(unsigned short dimensions);
+void writeActivityReport(unsigned long long cycles, unsigned short dimensions, const std::vector<TrafficMeter*>& meters);
 char *print_time(unsigned long long total_sec);
 void printConfiguration(InputParser& opt);
 
@@ -98,10 +121,95 @@ void showHelp() {
               << "                      Default=0 (no output buffers), Min: 0, Max: 1024" << std::endl << std::endl
               << "  -vc value           Number of virtual channels. 0 <= Value <= 32" << std::endl
               << "                      Default=0 (no virtual channels), Min: 0, Max: 32" << std::endl << std::endl
-              << "  -trace              Generate waveforms." << std::endl
+              << "  -trace              Generate waveforms (" WAVEFORM_FILENAME ": " WAVEFORM_FORMAT ")." << std::endl
               << "                      Default= Don't generate waveforms" << std::endl << std::endl
+              << "  -tracewindow <start>:<stop> Write in the waveform only the cycles from <start> to <stop>" << std::endl
+              << "                      (<stop> = 0: until the end of simulation). Implies -trace." << std::endl
+              << "                      Default= All cycles" << std::endl << std::endl
+              << "  -tracerouters <list> Write in the waveform only the routers of the list (e.g. 0-3,7)." << std::endl
+              << "                      Implies -trace." << std::endl
+              << "                      Default= All routers" << std::endl << std::endl
+              << "  -traceinternal      Write in the waveform the internal signals of the routers" << std::endl
+              << "                      (ParIS: requests, grants and FIFO handshake). Implies -trace." << std::endl
+              << "                      Default= Only the ports of the routers" << std::endl << std::endl
               << "  -seed               Simulation seed for the pseudo-random number generators." << std::endl
-              << "                      Default=0" << std::endl << std::endl;
+              << "                      Default=0" << std::endl << std::endl
+              << "  -replay file        Inject the packets recorded in a binary packet trace" << std::endl
+              << "                      instead of the flows of the traffic file." << std::endl
+              << "                      Default= Don't replay a trace" << std::endl << std::endl
+              << "  -replayscale value  Scale factor applied to the cycles of the replayed trace. 0 < Value" << std::endl
+              << "                      Default=1 (original timing)" << std::endl << std::endl
+              << "  -flowweight value   Flow selection in the traffic generators. 0 <= Value <= 1" << std::endl
+              << "                      0: uniform, 1: proportional to the required bandwidth" << std::endl
+              << "                      Default=0 (uniform)" << std::endl << std::endl
+              << "  -closedloop         Closed-loop traffic: the flows send requests and each" << std::endl
+              << "                      request received is answered by a reply." << std::endl
+              << "                      Default= Open-loop traffic" << std::endl << std::endl
+              << "  -replylength value  Reply payload length (flits including the trailer). 1 <= Value <= 1024" << std::endl
+              << "                      Default=4" << std::endl << std::endl
+              << "  -servicedelay value Cycles to serve a request before injecting the reply. 0 <= Value" << std::endl
+              << "                      Default=0" << std::endl << std::endl
+              << "  -outstanding value  Maximum number of requests of a flow waiting for the reply. 1 <= Value" << std::endl
+              << "                      Default=4" << std::endl << std::endl
+              << "  -taskgraph file     Inject the messages of an application task graph (tasks mapped" << std::endl
+              << "                      to the terminals) instead of the flows of the traffic file." << std::endl
+              << "                      Default= Don't use a task graph" << std::endl << std::endl
+              << "  -phases file        Phase schedule: each phase has its own traffic file and ends" << std::endl
+              << "                      after a number of cycles or when all its packets are sent." << std::endl
+              << "                      Default= Single traffic file (" TRAFFIC_FILENAME ")" << std::endl << std::endl
+              << "  -calendar           Open-loop injection of all the terminals driven by a single" << std::endl
+              << "                      scheduler (calendar queue) instead of one thread per terminal." << std::endl
+              << "                      Default= One injection thread per terminal" << std::endl << std::endl
+              << "  -packetlog          Log the delivered packets in a single binary file (" PACKET_LOG_FILENAME ")" << std::endl
+              << "                      instead of the text files ext_*_out (see PacketLogConverter)." << std::endl
+              << "                      Default= Text files" << std::endl << std::endl
+              << "  -nopacketlog        Don't log each packet delivered (ext_*_out or " PACKET_LOG_FILENAME ")." << std::endl
+              << "                      Default= Log all the packets" << std::endl << std::endl
+              << "  -latency            Latency histograms (mean, percentiles) by class, flow and" << std::endl
+              << "                      source-destination pair, written in " LATENCY_FILENAME "." << std::endl
+              << "                      Default= No latency histograms" << std::endl << std::endl
+              << "  -linkstats          Flits, busy and stall cycles of each router output port (link)," << std::endl
+              << "                      with utilization heatmaps by port, written in links.out." << std::endl
+              << "                      Default= No link counters" << std::endl << std::endl
+              << "  -fifostats          Time-weighted occupancy (mean, max, p99, fraction of cycles full)" << std::endl
+              << "                      and histogram of each input and output buffer, by router, port" << std::endl
+              << "                      and virtual channel, written in buffers.out." << std::endl
+              << "                      Default= No buffer occupancy" << std::endl << std::endl
+              << "  -synclog            Write the logs (ext_*_out, " PACKET_LOG_FILENAME ", stopsim.out) in the" << std::endl
+              << "                      simulation thread instead of a background writer thread." << std::endl
+              << "                      Default= Background writer thread" << std::endl << std::endl
+              << "  -telemetry <cycles> Publish the progress (throughput, latency, most congested links)" << std::endl
+              << "                      every <cycles> in " TELEMETRY_FILENAME ", a file mapped in memory" << std::endl
+              << "                      to be watched while simulating with snocs_telemetry." << std::endl
+              << "                      Default= No telemetry" << std::endl << std::endl
+              << "  -tracepackets <n>   Trace the lifecycle of one of each <n> packets (creation, injection," << std::endl
+              << "                      arrival, grant and departure in each router, delivery) in " PACKET_TRACER_FILENAME << std::endl
+              << "                      (Chrome trace events - chrome://tracing or ui.perfetto.dev)." << std::endl
+              << "                      Default= No packet tracing" << std::endl << std::endl
+              << "  -traceflows <flows> Trace the lifecycle of the packets of the flows <src>:<dst>,..." << std::endl
+              << "                      ('*' matches any terminal, e.g. 0:15,3:*)." << std::endl
+              << "                      Default= No packet tracing" << std::endl << std::endl
+              << "  -breakdown          Latency breakdown by stage (source queue, injection, wait for grant," << std::endl
+              << "                      forward, ejection) of each flow and router in " LATENCY_BREAKDOWN_FILENAME "." << std::endl
+              << "                      Default= No latency breakdown" << std::endl << std::endl
+              << "  -stallstats         Cycles that the flit at the head of each input buffer waits, by cause" << std::endl
+              << "                      (routing, arbitration, output busy, VC unavailable, no credit), by" << std::endl
+              << "                      router, port and virtual channel, written in stalls.out." << std::endl
+              << "                      Default= No stall counters" << std::endl << std::endl
+              << "  -stallseries <cycles> Stall cycles by cause of each window of <cycles> in stalls_series.out" << std::endl
+              << "                      (implies -stallstats)." << std::endl
+              << "                      Default= No stall time series" << std::endl << std::endl
+              << "  -activity           Events of each router (buffer writes and reads, crossbar traversals," << std::endl
+              << "                      arbitrations, route computations, link traversals) in energy.out." << std::endl
+              << "                      Default= No activity counters" << std::endl << std::endl
+              << "  -energy file        Energy by event (pJ) and leakage (mW) of a router, one \"<event> <value>\"" << std::endl
+              << "                      by line: buffer_write, buffer_read, crossbar, arbitration, routing," << std::endl
+              << "                      link, leakage. Adds the energy and power by router to energy.out" << std::endl
+              << "                      (implies -activity)." << std::endl
+              << "                      Default= No energy estimation" << std::endl << std::endl
+              << "  -timeseries <cycles> Accepted throughput, mean and max latency, packets delivered, injected" << std::endl
+              << "                      and in flight of each window of <cycles> in " TIME_SERIES_FILENAME "." << std::endl
+              << "                      Default= No time series" << std::endl << std::endl;
     std::cout << "\nIMPORTANT: <xsize> and <ysize> options define the system size for 2D and 3D\n"
                  "topologies (i.e. number of elements). In 2D the the limits for the <values> are\n"
                  " different than 3D, because the network protocol used (Header Flit Format).\n";
@@ -163,6 +271,33 @@ int sc_main(int argc, char* argv[]) {
     }
 
     printConfiguration(optParser);
+    RunSummary summary(argc,argv);
+
+    // Packet tracing - opened before the routers are built (they check it)
+    if( TRACER_SAMPLING > 0 || TRACER_FLOWS != NULL ) {
+        char strPacketTrace[256];
+        sprintf(strPacketTrace,"%s/%s",WORK_DIR,PACKET_TRACER_FILENAME);
+        PACKET_TRACER->open(strPacketTrace,TRACER_SAMPLING,TRACER_FLOWS);
+    }
+
+    // Latency breakdown - enabled before the routers are built (they check it)
+    if( LATENCY_STAGES ) {
+        LATENCY_BREAKDOWN->enable();
+    }
+
+    // Energy table of the activity counters
+    if( ENERGY_FILE != NULL && !INSTRUMENTATION->readEnergyTable(ENERGY_FILE) ) {
+        printf("\n\tOnly the events of the routers will be reported.\n");
+    }
+
+    // Waveform - opened before the routers are built (they register their signals)
+    if( TRACE ) {
+        char strWaveformFile[256];
+        sprintf(strWaveformFile,"%s/%s",WORK_DIR,WAVEFORM_FILENAME);
+        if( !WAVEFORM->open(strWaveformFile,TRACE_START,TRACE_STOP,TRACE_ROUTERS,TRACE_INTERNAL) ) {
+            TRACE = false;
+        }
+    }
 
     /// [2] Network models building
     INoC* u_NOC = PLUGIN_MANAGER->nocInstance("NoC");
@@ -232,6 +367,14 @@ int sc_main(int argc, char* argv[]) {
     u_STOP->o_EOS(w_EOS);
     u_STOP->i_CLK_CYCLES(w_GLOBAL_CLOCK);
 
+    InjectionScheduler* u_SCHEDULER = NULL;
+    if( CALENDAR_INJECTION ) {
+        u_SCHEDULER = new InjectionScheduler("InjectionScheduler");
+        u_SCHEDULER->i_CLK(w_CLK);
+        u_SCHEDULER->i_RST(w_RST);
+        u_SCHEDULER->i_CLK_CYCLES(w_GLOBAL_CLOCK);
+    }
+
     //////////////////////////////////////////////////////////////////////////////
     INoC_VC *u_NOC_VC = dynamic_cast<INoC_VC *>(u_NOC);
     //////////////////////////////////////////////////////////////////////////////
@@ -248,6 +391,14 @@ int sc_main(int argc, char* argv[]) {
 
     unsigned long long totalPacketsToSend = 0;
 
+    if( BINARY_PACKET_LOG ) {
+        char strPacketLog[256];
+        sprintf(strPacketLog,"%s/%s",WORK_DIR,PACKET_LOG_FILENAME);
+        if( !PACKET_LOG->open(strPacketLog) ) {
+            return -1;
+        }
+    }
+
     // Instantiating System Components (TGs, TMs) & binding dynamic ports
     for( unsigned short elementId = 0; elementId < numElements; elementId++ ) {
         // Assembling TG name
@@ -257,6 +408,9 @@ int sc_main(int argc, char* argv[]) {
         TerminalInstrumentation* u_TG = new TerminalInstrumentation(strTgName,elementId,u_NOC->topologyType());
         totalPacketsToSend += u_TG->u_FG->getTotalPacketsToSend();
         u_TG->u_FG->stopMethod = u_STOP->stopMethod;
+        if( u_SCHEDULER != NULL ) {
+            u_SCHEDULER->addGenerator(u_TG->u_FG);
+        }
         u_TIs[elementId] = u_TG;
 
         // Assembling TM name
@@ -324,22 +478,49 @@ int sc_main(int argc, char* argv[]) {
         u_STOP->i_TG_NUM_PACKETS_RECEIVED[elementId](w_TG_NUM_PACKETS_RECEIVED[elementId]);
         u_STOP->i_TG_EOT[elementId](w_TG_EOT[elementId]);
     }
+    if( CLOSED_LOOP && REPLAY_FILE == NULL && TASK_GRAPH_FILE == NULL ) {
+        totalPacketsToSend *= 2; // Each request is answered by a reply
+    }
     if( u_STOP->stopMethod == StopSim::AllPacketsDelivered ) {
         u_STOP->setTotalPacketsToSend(totalPacketsToSend);
     }
 
+    Telemetry* u_TELEMETRY = NULL;
+    if( TELEMETRY_INTERVAL > 0 ) {
+        //////////////////////////////////////////////////////////////////////////////
+        u_TELEMETRY = new Telemetry("Telemetry",TELEMETRY_INTERVAL,u_STOP,u_TMs);
+        //////////////////////////////////////////////////////////////////////////////
+        u_TELEMETRY->i_CLK(w_CLK);
+        u_TELEMETRY->i_RST(w_RST);
+        u_TELEMETRY->i_CLK_CYCLES(w_GLOBAL_CLOCK);
+        char strTelemetry[256];
+        sprintf(strTelemetry,"%s/%s",WORK_DIR,TELEMETRY_FILENAME);
+        u_TELEMETRY->open(strTelemetry);
+    }
+
+    TimeSeries* u_TIME_SERIES = NULL;
+    if( TIME_SERIES_INTERVAL > 0 ) {
+        //////////////////////////////////////////////////////////////////////////////
+        u_TIME_SERIES = new TimeSeries("TimeSeries",TIME_SERIES_INTERVAL,u_TIs,u_TMs);
+        //////////////////////////////////////////////////////////////////////////////
+        u_TIME_SERIES->i_CLK(w_CLK);
+        u_TIME_SERIES->i_RST(w_RST);
+        u_TIME_SERIES->i_CLK_CYCLES(w_GLOBAL_CLOCK);
+        char strTimeSeries[256];
+        sprintf(strTimeSeries,"%s/%s",WORK_DIR,TIME_SERIES_FILENAME);
+        u_TIME_SERIES->open(strTimeSeries);
+    }
+
     /// [5] Trace generation
-    sc_trace_file *tf = NULL;
     if( TRACE ) {
-        char strWaveformFile[256];
-        sprintf(strWaveformFile,"%s/snocs_wave",WORK_DIR);
-        tf=sc_create_vcd_trace_file(strWaveformFile);
-        // Signal tracing
-        sc_trace(tf, w_CLK, "CLK");
-        sc_trace(tf, w_RST, "RST");
-        sc_trace(tf, w_EOS, "EOS");
-        sc_trace(tf, w_GLOBAL_CLOCK, "GLOBAL_CLK");
+        // Signal tracing (the clock is written by the waveform)
+        WAVEFORM->trace(w_RST,"","RST");
+        WAVEFORM->trace(w_EOS,"","EOS");
+        WAVEFORM->trace(w_GLOBAL_CLOCK,"","GLOBAL_CLK");
         for( unsigned short elementId = 0; elementId < numElements; elementId++ ) {
+            if( !WAVEFORM->routerSelected(elementId) ) {
+                continue;
+            }
             // Assembling signal names to trace
             char strDataIn[20];
             sprintf(strDataIn,"L_DATA_IN_%u",elementId);
@@ -366,19 +547,19 @@ int sc_main(int argc, char* argv[]) {
                     char strVcSelOutBit[30];
                     sprintf(strVcSelOutBit,"%s(%u)",strVcSelOut,vcBit);
 
-                    sc_trace(tf,w_IN_VC_SEL[elementId][vcBit],strVcSelInBit);
-                    sc_trace(tf,w_OUT_VC_SEL[elementId][vcBit],strVcSelOutBit);
+                    WAVEFORM->trace(w_IN_VC_SEL[elementId][vcBit],"",strVcSelInBit);
+                    WAVEFORM->trace(w_OUT_VC_SEL[elementId][vcBit],"",strVcSelOutBit);
                 }
             }
 
             // Add to trace
-            sc_trace(tf,w_IN_DATA[elementId],strDataIn);
-            sc_trace(tf,w_IN_VALID[elementId],strValIn);
-            sc_trace(tf,w_IN_RETURN[elementId],strRetIn);
-            sc_trace(tf,w_OUT_DATA[elementId],strDataOut);
-            sc_trace(tf,w_OUT_VALID[elementId],strValOut);
-            sc_trace(tf,w_OUT_RETURN[elementId],strRetOut);
-            sc_trace(tf,w_TG_EOT[elementId],strTgEOT);
+            WAVEFORM->trace(w_IN_DATA[elementId],"",strDataIn);
+            WAVEFORM->trace(w_IN_VALID[elementId],"",strValIn);
+            WAVEFORM->trace(w_IN_RETURN[elementId],"",strRetIn);
+            WAVEFORM->trace(w_OUT_DATA[elementId],"",strDataOut);
+            WAVEFORM->trace(w_OUT_VALID[elementId],"",strValOut);
+            WAVEFORM->trace(w_OUT_RETURN[elementId],"",strRetOut);
+            WAVEFORM->trace(w_TG_EOT[elementId],"",strTgEOT);
         }
     }
 
@@ -388,13 +569,28 @@ int sc_main(int argc, char* argv[]) {
     std::cout << "////////////// Start Simulation //////////////" << std::endl;
     std::cout << "//////////////////////////////////////////////" << std::endl << std::endl << std::endl;
 
+    // Logs written during the simulation go to the writer thread - started after
+    // the last configuration check, so no error path leaves it running
+    if( ASYNC_LOG ) {
+        LOG_WRITER->start();
+    }
+
     // Start the simulation (the StopSim will stop it with sc_stop())
     time_t start;
     time_t finish;
     sc_set_stop_mode(SC_STOP_IMMEDIATE);
     time(&start);
+    summary.startRun();
     sc_start();
+    summary.finishRun();
     time(&finish);
+    if( u_TELEMETRY != NULL ) {
+        u_TELEMETRY->finish();
+    }
+    if( u_TIME_SERIES != NULL ) {
+        u_TIME_SERIES->finish();
+    }
+    LOG_WRITER->stop();
 
     double execTime = difftime(finish,start);
     char* formattedTime = print_time((unsigned long long) execTime);
@@ -403,16 +599,67 @@ int sc_main(int argc, char* argv[]) {
 
     /// [8] System destroying
     if(TRACE) {
-        sc_close_vcd_trace_file(tf);
+        WAVEFORM->close();
         generateListNodesGtkwave(numElements);
     }
 
+    if( BINARY_PACKET_LOG ) {
+        PACKET_LOG->close();
+    }
+    if( PACKET_TRACER->isOpen() ) {
+        printf("\n%llu packets traced in %s\n",PACKET_TRACER->tracedPackets(),PACKET_TRACER_FILENAME);
+        PACKET_TRACER->close();
+    }
+    if( LATENCY_STATISTICS ) {
+        writeLatencyReport(u_TMs);
+    }
+    unsigned short dimensions = topologyDimensions(u_NOC->topologyType()); // Heatmaps layout
+    if( LINK_COUNTERS ) {
+        writeLinkReport(w_GLOBAL_CLOCK.read(),dimensions);
+    }
+    if( BUFFER_OCCUPANCY ) {
+        writeBufferReport(dimensions);
+    }
+    if( LATENCY_STAGES ) {
+        writeBreakdownReport();
+    }
+    if( STALL_COUNTERS ) {
+        writeStallReport(dimensions);
+    }
+    if( ACTIVITY_COUNTERS ) {
+        writeActivityReport(w_GLOBAL_CLOCK.read(),dimensions,u_TMs);
+    }
+
+    if( CLOSED_LOOP && REPLAY_FILE == NULL && TASK_GRAPH_FILE == NULL ) {
+        writeClosedLoopReport(u_TIs);
+    }
+    if( TASK_GRAPH_FILE != NULL && REPLAY_FILE == NULL ) {
+        writeTaskGraphReport();
+    }
+    if( PHASE_FILE != NULL && REPLAY_FILE == NULL && TASK_GRAPH_FILE == NULL ) {
+        writePhaseReport(w_GLOBAL_CLOCK.read());
+    }
+
+    char strSummary[256];
+    sprintf(strSummary,"%s/%s",WORK_DIR,SUMMARY_FILENAME);
+    if( !summary.write(strSummary,w_GLOBAL_CLOCK.read(),u_STOP->stopMethod,u_TIs,u_TMs) ) {
+        printf("\n\tCannot open the file \"%s\" to write the run summary.\n",strSummary);
+    }
+
     // Deallocating simulator units and auxiliar data
     for( unsigned short i = 0; i < numElements; i++ ) {
         delete u_TMs[i];
         delete u_TIs[i];
     }
+    delete u_TELEMETRY;
+    delete u_TIME_SERIES;
     delete[] formattedTime;
+    delete[] REPLAY_FILE;
+    delete[] TASK_GRAPH_FILE;
+    delete[] PHASE_FILE;
+    delete[] TRACER_FLOWS;
+    delete[] TRACE_ROUTERS;
+    delete[] ENERGY_FILE;
     delete PLUGIN_MANAGER;
 
     return 0;
@@ -457,15 +704,120 @@ void printConfiguration(InputParser &opt) {
     }
 
     if( TRACE ) {
-        std::cout << prefix << "Generate Waveforms (.vcd)!" << std::endl;
+        std::cout << prefix << "Generate Waveforms: " << WAVEFORM_FILENAME;
+        if( TRACE_START > 0 || TRACE_STOP > 0 ) {
+            std::cout << " - cycles " << TRACE_START << " to ";
+            if( TRACE_STOP > 0 ) {
+                std::cout << TRACE_STOP;
+            } else {
+                std::cout << "the end";
+            }
+        }
+        if( TRACE_ROUTERS != NULL ) {
+            std::cout << " - routers " << TRACE_ROUTERS;
+        }
+        if( TRACE_INTERNAL ) {
+            std::cout << " - internal signals";
+        }
+        std::cout << std::endl;
     } else {
-        std::cout << prefix << "Don't generate Waveforms (.vcd)!" << std::endl;
+        std::cout << prefix << "Don't generate Waveforms!" << std::endl;
     }
 
     if( opt.cmdOptionExists("-seed") ) {
         std::cout << prefix << "Simulation seed: " << SEED << std::endl;
     }
 
+    if( FLOW_WEIGHTING == 1 ) {
+        std::cout << prefix << "Flows selected proportionally to the required bandwidth" << std::endl;
+    }
+
+    if( CLOSED_LOOP ) {
+        std::cout << prefix << "Closed-loop traffic - Reply length: " << REPLY_LENGTH
+                  << ", Service delay: " << SERVICE_DELAY
+                  << ", Outstanding requests per flow: " << MAX_OUTSTANDING << std::endl;
+    }
+
+    if( REPLAY_FILE != NULL ) {
+        std::cout << prefix << "Replaying packet trace: " << REPLAY_FILE
+                  << " (time scale: " << REPLAY_TIME_SCALE << ")" << std::endl;
+    }
+
+    if( TASK_GRAPH_FILE != NULL ) {
+        std::cout << prefix << "Application task graph: " << TASK_GRAPH_FILE << std::endl;
+    }
+
+    if( PHASE_FILE != NULL ) {
+        std::cout << prefix << "Phase schedule: " << PHASE_FILE << std::endl;
+    }
+
+    if( CALENDAR_INJECTION ) {
+        std::cout << prefix << "Injection driven by the calendar queue scheduler" << std::endl;
+    }
+
+    if( !PACKET_LOGGING ) {
+        std::cout << prefix << "Packets delivered not logged" << std::endl;
+    } else if( BINARY_PACKET_LOG ) {
+        std::cout << prefix << "Binary packet log: " << PACKET_LOG_FILENAME << std::endl;
+    }
+
+    if( LATENCY_STATISTICS ) {
+        std::cout << prefix << "Latency histograms: " << LATENCY_FILENAME << std::endl;
+    }
+
+    if( LINK_COUNTERS ) {
+        std::cout << prefix << "Link counters: links.out" << std::endl;
+    }
+
+    if( BUFFER_OCCUPANCY ) {
+        std::cout << prefix << "Buffer occupancy: buffers.out" << std::endl;
+    }
+
+    if( LATENCY_STAGES ) {
+        std::cout << prefix << "Latency breakdown: " << LATENCY_BREAKDOWN_FILENAME << std::endl;
+    }
+
+    if( STALL_COUNTERS ) {
+        std::cout << prefix << "Stall counters: stalls.out";
+        if( STALL_INTERVAL > 0 ) {
+            std::cout << " - time series: stalls_series.out every " << STALL_INTERVAL << " cycles";
+        }
+        std::cout << std::endl;
+    }
+
+    if( ACTIVITY_COUNTERS ) {
+        std::cout << prefix << "Activity counters: energy.out";
+        if( ENERGY_FILE != NULL ) {
+            std::cout << " - energy table " << ENERGY_FILE;
+        }
+        std::cout << std::endl;
+    }
+
+    if( !ASYNC_LOG ) {
+        std::cout << prefix << "Logs written in the simulation thread" << std::endl;
+    }
+
+    if( TRACER_SAMPLING > 0 || TRACER_FLOWS != NULL ) {
+        std::cout << prefix << "Packet tracing: " << PACKET_TRACER_FILENAME;
+        if( TRACER_SAMPLING > 0 ) {
+            std::cout << " - one of each " << TRACER_SAMPLING << " packets";
+        }
+        if( TRACER_FLOWS != NULL ) {
+            std::cout << " - flows " << TRACER_FLOWS;
+        }
+        std::cout << std::endl;
+    }
+
+    if( TELEMETRY_INTERVAL > 0 ) {
+        std::cout << prefix << "Telemetry: " << TELEMETRY_FILENAME << " every " << TELEMETRY_INTERVAL << " cycles" << std::endl;
+    }
+
+    if( TIME_SERIES_INTERVAL > 0 ) {
+        std::cout << prefix << "Time series: " << TIME_SERIES_FILENAME << " every " << TIME_SERIES_INTERVAL << " cycles" << std::endl;
+    }
+
+    std::cout << prefix << "Run summary: " << SUMMARY_FILENAME << std::endl;
+
 }
 
 int getIntArg(InputParser& opt,std::string arg, int defaultValue, int min, int max = 0) {
@@ -493,6 +845,20 @@ int getIntArg(InputParser& opt,std::string arg, int defaultValue, int min, int m
     }
 }
 
+float getFloatArg(InputParser& opt,std::string arg, float defaultValue) {
+    if( opt.cmdOptionExists(arg) ) {
+        std::string var = opt.getCmdOption(arg);
+        float varValue = (float) atof(var.c_str());
+        if( var.empty() || varValue <= 0 ) {
+            std::cout << arg << ": Argument missing or wrong... using default = "<< defaultValue << std::endl;
+            return defaultValue;
+        }
+        return varValue;
+    } else {
+        return defaultValue;
+    }
+}
+
 /*!
  * \brief setupSimulator Setup all global definitions for the
  * simulator.
@@ -560,11 +926,128 @@ unsigned int setupSimulator(int argc, char* argv[], InputParser &opt) {
     FIFO_OUT_DEPTH = getIntArg(opt,"-fifoout",0,0,1024);
     SEED = getIntArg(opt,"-seed",0,0);
 
+    if( opt.cmdOptionExists("-replay") ) {
+        std::string replay = opt.getCmdOption("-replay");
+        if( replay.empty() ) {
+            std::cout << "-replay: Argument missing... using the traffic file" << std::endl;
+        } else {
+            REPLAY_FILE = new char[replay.size()+1];
+            strcpy(REPLAY_FILE,replay.c_str());
+        }
+    }
+    REPLAY_TIME_SCALE = getFloatArg(opt,"-replayscale",1);
+    FLOW_WEIGHTING = getIntArg(opt,"-flowweight",0,0,1);
+
+    CLOSED_LOOP = opt.cmdOptionExists("-closedloop");
+    REPLY_LENGTH = getIntArg(opt,"-replylength",4,1,1024);
+    SERVICE_DELAY = getIntArg(opt,"-servicedelay",0,0);
+    MAX_OUTSTANDING = getIntArg(opt,"-outstanding",4,1);
+
+    if( opt.cmdOptionExists("-taskgraph") ) {
+        std::string taskGraph = opt.getCmdOption("-taskgraph");
+        if( taskGraph.empty() ) {
+            std::cout << "-taskgraph: Argument missing... using the traffic file" << std::endl;
+        } else {
+            TASK_GRAPH_FILE = new char[taskGraph.size()+1];
+            strcpy(TASK_GRAPH_FILE,taskGraph.c_str());
+        }
+    }
+
+    if( opt.cmdOptionExists("-phases") ) {
+        std::string phases = opt.getCmdOption("-phases");
+        if( phases.empty() ) {
+            std::cout << "-phases: Argument missing... using the traffic file" << std::endl;
+        } else {
+            PHASE_FILE = new char[phases.size()+1];
+            strcpy(PHASE_FILE,phases.c_str());
+            if( CLOSED_LOOP ) {
+                std::cout << "-phases: The phase schedule is only for open-loop traffic... ignoring -closedloop" << std::endl;
+                CLOSED_LOOP = false;
+            }
+        }
+    }
+
+    CALENDAR_INJECTION = opt.cmdOptionExists("-calendar");
+    if( CALENDAR_INJECTION && (CLOSED_LOOP || REPLAY_FILE != NULL || TASK_GRAPH_FILE != NULL || PHASE_FILE != NULL) ) {
+        std::cout << "-calendar: The injection scheduler is only for the open-loop traffic file... ignoring it" << std::endl;
+        CALENDAR_INJECTION = false;
+    }
+
+    PACKET_LOGGING = !opt.cmdOptionExists("-nopacketlog");
+    BINARY_PACKET_LOG = PACKET_LOGGING && opt.cmdOptionExists("-packetlog");
+    LATENCY_STATISTICS = opt.cmdOptionExists("-latency");
+    LINK_COUNTERS = opt.cmdOptionExists("-linkstats");
+    BUFFER_OCCUPANCY = opt.cmdOptionExists("-fifostats");
+    LATENCY_STAGES = opt.cmdOptionExists("-breakdown");
+    STALL_INTERVAL = opt.cmdOptionExists("-stallseries") ? getIntArg(opt,"-stallseries",1000,1) : 0;
+    STALL_COUNTERS = opt.cmdOptionExists("-stallstats") || STALL_INTERVAL > 0;
+    ACTIVITY_COUNTERS = opt.cmdOptionExists("-activity");
+    if( opt.cmdOptionExists("-energy") ) {
+        std::string energyFile = opt.getCmdOption("-energy");
+        if( energyFile.empty() ) {
+            std::cout << "-energy: Argument missing... no energy estimation" << std::endl;
+        } else {
+            ENERGY_FILE = new char[energyFile.size()+1];
+            strcpy(ENERGY_FILE,energyFile.c_str());
+        }
+        ACTIVITY_COUNTERS = true;
+    }
+    ASYNC_LOG = !opt.cmdOptionExists("-synclog");
+    TELEMETRY_INTERVAL = opt.cmdOptionExists("-telemetry") ? getIntArg(opt,"-telemetry",1000,1) : 0;
+    TIME_SERIES_INTERVAL = opt.cmdOptionExists("-timeseries") ? getIntArg(opt,"-timeseries",1000,1) : 0;
+    TRACER_SAMPLING = opt.cmdOptionExists("-tracepackets") ? getIntArg(opt,"-tracepackets",1000,1) : 0;
+    if( opt.cmdOptionExists("-traceflows") ) {
+        std::string flows = opt.getCmdOption("-traceflows");
+        if( flows.empty() ) {
+            std::cout << "-traceflows: Argument missing... no flow traced" << std::endl;
+        } else {
+            TRACER_FLOWS = new char[flows.size()+1];
+            strcpy(TRACER_FLOWS,flows.c_str());
+        }
+    }
+    if( TELEMETRY_INTERVAL > 0 && !LINK_COUNTERS ) {
+        std::cout << "-telemetry: Enabling the link counters to publish the most congested links" << std::endl;
+        LINK_COUNTERS = true;
+    }
+    if( ACTIVITY_COUNTERS && !LINK_COUNTERS ) {
+        std::cout << "-activity: Enabling the link counters to count the link traversals" << std::endl;
+        LINK_COUNTERS = true;
+    }
+
     if( opt.cmdOptionExists("-trace") ) {
         TRACE = true;
     } else {
         TRACE = false;
     }
+    if( opt.cmdOptionExists("-tracewindow") ) {
+        std::string window = opt.getCmdOption("-tracewindow");
+        size_t colon = window.find(':');
+        if( window.empty() || colon == std::string::npos ) {
+            std::cout << "-tracewindow: Expected <start>:<stop>... writing all cycles" << std::endl;
+        } else {
+            TRACE_START = strtoull(window.substr(0,colon).c_str(),NULL,10);
+            TRACE_STOP = strtoull(window.substr(colon+1).c_str(),NULL,10);
+            if( TRACE_STOP > 0 && TRACE_STOP < TRACE_START ) {
+                std::cout << "-tracewindow: <stop> before <start>... writing until the end of simulation" << std::endl;
+                TRACE_STOP = 0;
+            }
+        }
+        TRACE = true;
+    }
+    if( opt.cmdOptionExists("-tracerouters") ) {
+        std::string routers = opt.getCmdOption("-tracerouters");
+        if( routers.empty() ) {
+            std::cout << "-tracerouters: Argument missing... writing all routers" << std::endl;
+        } else {
+            TRACE_ROUTERS = new char[routers.size()+1];
+            strcpy(TRACE_ROUTERS,routers.c_str());
+        }
+        TRACE = true;
+    }
+    if( opt.cmdOptionExists("-traceinternal") ) {
+        TRACE_INTERNAL = true;
+        TRACE = true;
+    }
 
     if( NUM_VC == 1 ) {
         std::cout << "Changing the number of virtual channels to 2,\n"
@@ -585,6 +1068,203 @@ unsigned int setupSimulator(int argc, char* argv[], InputParser &opt) {
     return 0;
 }
 
+/*!
+ * \brief openReport Open a report file in the work folder
+ * \param fileName Buffer (512 characters) that receives the path of the file
+ * \param name Name of the file
+ * \param content Description of the report for the error message
+ * \return The file opened or NULL on error
+ */
+static FILE* openReport(char* fileName, const char* name, const char* content) {
+    FILE* out;
+    sprintf(fileName,"%s/%s",WORK_DIR,name);
+    if ((out=fopen(fileName,"wt")) == NULL){
+        printf("\n\tCannot open the file \"%s\" to write the %s.\n",fileName,content);
+    }
+    return out;
+}
+
+/*!
+ * \brief topologyDimensions Number of dimensions of the heatmaps of the
+ * router counters (1: a line of routers)
+ */
+static unsigned short topologyDimensions(INoC::TopologyType topologyType) {
+    switch( topologyType ) {
+        case INoC::TT_Orthogonal2D: return 2;
+        case INoC::TT_Orthogonal3D: return 3;
+        default: return 1;
+    }
+}
+
+/*!
+ * \brief writeClosedLoopReport Write the round-trip latency of the
+ * requests of each flow in the closedloop.out file.
+ */
+void writeClosedLoopReport(std::vector<TerminalInstrumentation *>& terminals) {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,"closedloop.out","closed-loop report");
+    if( out == NULL ) {
+        return;
+    }
+
+    fprintf(out,"# Reply length: %u, Service delay: %u, Outstanding requests per flow: %u\n",
+            REPLY_LENGTH,SERVICE_DELAY,MAX_OUTSTANDING);
+    fprintf(out,"# Src\tFlow\t Dst\t  Requests\t   Replies\tOutstd\t   Avg RTT\t   Min RTT\t   Max RTT\n");
+    for( unsigned short i = 0; i < terminals.size(); i++ ) {
+        terminals[i]->u_FG->writeClosedLoopReport(out);
+    }
+    fclose(out);
+}
+
+/*!
+ * \brief writeTaskGraphReport Write the makespan and the critical path of
+ * the application task graph in the taskgraph.out file.
+ */
+void writeTaskGraphReport() {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,"taskgraph.out","task graph report");
+    if( out == NULL ) {
+        return;
+    }
+
+    fprintf(out,"# Task graph: %s\n",TASK_GRAPH_FILE);
+    TASK_GRAPH->writeReport(out);
+    fclose(out);
+
+    if( TASK_GRAPH->completed() ) {
+        printf("\nApplication makespan: %llu cycles\n",TASK_GRAPH->makespan());
+    } else {
+        printf("\nApplication not completed - see \"%s\"\n",fileName);
+    }
+}
+
+/*!
+ * \brief writePhaseReport Write the statistics of each phase of the
+ * schedule in the phases.out file.
+ */
+void writePhaseReport(unsigned long long endCycle) {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,"phases.out","phase report");
+    if( out == NULL ) {
+        return;
+    }
+
+    fprintf(out,"# Phase schedule: %s\n",PHASE_FILE);
+    PHASE_SCHEDULE->writeReport(out,endCycle);
+    fclose(out);
+}
+
+/*!
+ * \brief writeLatencyReport Merge the latency histograms of all the
+ * traffic meters and write them in the latency.out file.
+ */
+void writeLatencyReport(std::vector<TrafficMeter *>& meters) {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,LATENCY_FILENAME,"latency report");
+    if( out == NULL ) {
+        return;
+    }
+
+    LatencyStatistics statistics;
+    for( unsigned short i = 0; i < meters.size(); i++ ) {
+        if( meters[i]->latencyStatistics != NULL ) {
+            statistics.merge(*meters[i]->latencyStatistics);
+        }
+    }
+    statistics.writeReport(out);
+    fclose(out);
+}
+
+/*!
+ * \brief writeLinkReport Write the counters of the router output ports
+ * and their utilization heatmaps in the links.out file.
+ */
+void writeLinkReport(unsigned long long cycles, unsigned short dimensions) {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,"links.out","link counters");
+    if( out == NULL ) {
+        return;
+    }
+    INSTRUMENTATION->writeLinkReport(out,cycles,dimensions);
+    fclose(out);
+}
+
+/*!
+ * \brief writeBufferReport Write the occupancy of the router buffers
+ * in the buffers.out file.
+ */
+void writeBufferReport(unsigned short dimensions) {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,"buffers.out","buffer occupancy");
+    if( out == NULL ) {
+        return;
+    }
+    INSTRUMENTATION->writeBufferReport(out,dimensions);
+    fclose(out);
+}
+
+/*!
+ * \brief writeBreakdownReport Write the latency by stage of each
+ * flow and router
+ */
+void writeBreakdownReport() {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,LATENCY_BREAKDOWN_FILENAME,"latency breakdown");
+    if( out == NULL ) {
+        return;
+    }
+    LATENCY_BREAKDOWN->writeReport(out);
+    fclose(out);
+}
+
+/*!
+ * \brief writeStallReport Write the stall cycles by cause of the router
+ * inputs in the stalls.out file and, if enabled, their time series in the
+ * stalls_series.out file.
+ */
+void writeStallReport(unsigned short dimensions) {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,"stalls.out","stall counters");
+    if( out == NULL ) {
+        return;
+    }
+    INSTRUMENTATION->writeStallReport(out,dimensions);
+    fclose(out);
+
+    if( STALL_INTERVAL > 0 && (out = openReport(fileName,"stalls_series.out","stall time series")) != NULL ) {
+        INSTRUMENTATION->writeStallSeries(out);
+        fclose(out);
+    }
+}
+
+/*!
+ * \brief writeActivityReport Write the events and the energy of the
+ * routers in the energy.out file.
+ */
+void writeActivityReport(unsigned long long cycles, unsigned short dimensions, const std::vector<TrafficMeter*>& meters) {
+
+    char fileName[512];
+    FILE* out = openReport(fileName,"energy.out","router activity");
+    if( out == NULL ) {
+        return;
+    }
+
+    unsigned long long flitsDelivered = 0;
+    for( unsigned int i = 0; i < meters.size(); i++ ) {
+        flitsDelivered += meters[i]->flitsReceived;
+    }
+    INSTRUMENTATION->writeActivityReport(out,cycles,flitsDelivered,dimensions);
+    fclose(out);
+}
+
 /*!
  * \brief generateListNodesGtkwave Generate the list_nodes.sav file
  * to be read by Gtkwave tool and load signals in pre-defined layout.
@@ -614,6 +1294,9 @@ void generateListNodesGtkwave(unsigned short numElements) {
     fprintf(out,"\n-Core-Connections");
 
     for( elementId = 0; elementId < numElements; elementId++) {
+        if( !WAVEFORM->routerSelected(elementId) ) {
+            continue;
+        }
         fprintf(out,"\n-Core_%u",elementId);
         // For virtual channel in selector
         if(NUM_VC > 1) {
@@ -670,7 +1353,8 @@ void generateListNodesGtkwave(unsigned short numElements) {
     fprintf(out,"\n-Status");
     fprintf(out,"\n@28");
     for( elementId = 0; elementId < numElements; elementId++)
-        fprintf(out,"\nSystemC.TG_%u_EOT",elementId);
+        if( WAVEFORM->routerSelected(elementId) )
+            fprintf(out,"\nSystemC.TG_%u_EOT",elementId);
 
     fprintf(out,"\nSystemC.EOS");
     fprintf(out,"\n[pattern_trace] 1");
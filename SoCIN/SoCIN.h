@@ -34,8 +34,6 @@ public:
 
     void p_DEBUG();
 
-    sc_trace_file* tf;
-
     SC_HAS_PROCESS(SoCINfp_VC);
     SoCINfp_VC(sc_module_name mn);
 
@@ -71,8 +69,6 @@ public:
 
     void p_DEBUG();
 
-    sc_trace_file* tf;
-
     SC_HAS_PROCESS(SoCINfp);
     SoCINfp(sc_module_name mn);
 
@@ -265,7 +265,9 @@ struct Packet {
     float requiredBW;                      // Required bandwidth for the packet
     unsigned long int deadline;            // Defined deadline for the packet
     unsigned long int packetCreationCycle; // Packet cycle generation
+    unsigned long int injectionCycle;      // Cycle on which the header left the source queue (entered the network)
     unsigned short hops;                   // Number of hops of this packet in the network
+    bool traced;                           // Lifecycle recorded by the packet tracer (sampled)
 };
 /////////////////////////////////////////////////////////////////////////
 /// END of Packet structure
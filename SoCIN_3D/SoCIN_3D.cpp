@@ -4,8 +4,6 @@
 
 #include <stdexcept>
 
-//#define WAVEFORM_SOCIN
-
 //////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////// SoCINfp with virtual channels /////////////////////////////
@@ -284,208 +282,9 @@ SoCIN_3D::SoCIN_3D(sc_module_name mn)
         }
     }
 
-#ifdef WAVEFORM_SOCIN
-    tf = sc_create_vcd_trace_file("socin_3d");
-    sc_trace(tf,i_CLK,"CLK");
-    sc_trace(tf,i_RST,"RST");
-    unsigned short vcBit;
-    // Interfaces - routers
-    for( i = 0; i < numInterfaces; i++ ) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-        char strDataIn[15];
-        sprintf(strDataIn,"DATA_IN%s",strI);
-        sc_trace(tf, i_DATA_IN[i],strDataIn);
-        char strValidIn[15];
-        sprintf(strValidIn,"VALID_IN%s",strI);
-        sc_trace(tf, i_VALID_IN[i],strValidIn);
-        char strRetIn[15];
-        sprintf(strRetIn,"RET_IN%s",strI);
-        sc_trace(tf, o_RETURN_IN[i],strRetIn);
-        if( NUM_VC > 1 ) {
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char strVcIn[18];
-                sprintf(strVcIn,"VC_IN%s(%u)",strI,vcBit);
-                sc_trace(tf,i_VC_SELECTOR[i][vcBit],strVcIn);
-            }
-        }
-
-        char strDataOut[15];
-        sprintf(strDataOut,"DATA_OUT%s",strI);
-        sc_trace(tf, o_DATA_OUT[i],strDataOut);
-        char strValidOut[15];
-        sprintf(strValidOut,"VALID_OUT%s",strI);
-        sc_trace(tf, o_VALID_OUT[i],strValidOut);
-        char strRetOut[15];
-        sprintf(strRetOut,"RET_OUT%s",strI);
-        sc_trace(tf, i_RETURN_OUT[i],strRetOut);
-        if( NUM_VC > 1 ) {
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char strVcOut[19];
-                sprintf(strVcOut,"VC_OUT%s(%u)",strI,vcBit);
-                sc_trace(tf,o_VC_SELECTOR[i][vcBit],strVcOut);
-            }
-        }
-    }
-
-    // X wires
-    for( i = 0; i < numberOfXWires; i++) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-
-        char wXDataLeft[20];
-        sprintf(wXDataLeft,"X-Data-to-Left%s",strI);
-        sc_trace(tf,w_X_DATA_TO_LEFT[i],wXDataLeft);
-
-        char wXValidLeft[21];
-        sprintf(wXValidLeft,"X-Valid-to-Left%s",strI);
-        sc_trace(tf,w_X_VALID_TO_LEFT[i],wXValidLeft);
-
-        char wXRetLeft[21];
-        sprintf(wXRetLeft,"X-Ret-to-Left%s",strI);
-        sc_trace(tf,w_X_RETURN_TO_LEFT[i],wXRetLeft);
-
-        if( NUM_VC > 1 ) {
-            char wXVCLeft[30];
-            sprintf(wXVCLeft,"X-VC_Sel-to-Left%s",strI);
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char wXVCLeftBit[35];
-                sprintf(wXVCLeftBit,"%s(%u)",wXVCLeft,vcBit);
-                sc_trace(tf,w_X_VC_SELECTOR_TO_LEFT[i][vcBit],wXVCLeftBit);
-            }
-        }
-
-
-        char wXDataRight[21];
-        sprintf(wXDataRight,"X-Data-to-Right%s",strI);
-        sc_trace(tf,w_X_DATA_TO_RIGHT[i],wXDataRight);
-
-        char wXValidRight[22];
-        sprintf(wXValidRight,"X-Valid-to-Right%s",strI);
-        sc_trace(tf,w_X_VALID_TO_RIGHT[i],wXValidRight);
-
-        char wXRetRight[22];
-        sprintf(wXRetRight,"X-Ret-to-Right%s",strI);
-        sc_trace(tf,w_X_RETURN_TO_RIGHT[i],wXRetRight);
-
-        if( NUM_VC > 1 ) {
-            char wXVCRight[31];
-            sprintf(wXVCRight,"X-VC_Sel-to-Right%s",strI);
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char wXVCRightBit[36];
-                sprintf(wXVCRightBit,"%s(%u)",wXVCRight,vcBit);
-                sc_trace(tf,w_X_VC_SELECTOR_TO_RIGHT[i][vcBit],wXVCRightBit);
-            }
-        }
-    }
-    // Y wires
-    for( i = 0; i < numberOfYWires; i++) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-
-        char wYDataSouth[21];
-        sprintf(wYDataSouth,"Y-Data-to-South%s",strI);
-        sc_trace(tf,w_Y_DATA_TO_SOUTH[i],wYDataSouth);
-
-        char wYValidSouth[22];
-        sprintf(wYValidSouth,"Y-Valid-to-South%s",strI);
-        sc_trace(tf,w_Y_VALID_TO_SOUTH[i],wYValidSouth);
-
-        char wYRetSouth[22];
-        sprintf(wYRetSouth,"Y-Ret-to-South%s",strI);
-        sc_trace(tf,w_Y_RETURN_TO_SOUTH[i],wYRetSouth);
-
-        if( NUM_VC > 1 ) {
-            char wYVCSouth[31];
-            sprintf(wYVCSouth,"Y-VC_Sel-to-South%s",strI);
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char wYVCSouthBit[36];
-                sprintf(wYVCSouthBit,"%s(%u)",wYVCSouth,vcBit);
-                sc_trace(tf,w_Y_VC_SELECTOR_TO_SOUTH[i][vcBit],wYVCSouthBit);
-            }
-        }
-
-
-        char wYDataNorth[21];
-        sprintf(wYDataNorth,"Y-Data-to-North%s",strI);
-        sc_trace(tf,w_Y_DATA_TO_NORTH[i],wYDataNorth);
-
-        char wYValidNorth[22];
-        sprintf(wYValidNorth,"Y-Valid-to-North%s",strI);
-        sc_trace(tf,w_Y_VALID_TO_NORTH[i],wYValidNorth);
-
-        char wYRetNorth[22];
-        sprintf(wYRetNorth,"Y-Ret-to-North%s",strI);
-        sc_trace(tf,w_Y_RETURN_TO_NORTH[i],wYRetNorth);
-
-        if( NUM_VC > 1 ) {
-            char wYVCNorth[31];
-            sprintf(wYVCNorth,"Y-VC_Sel-to-North%s",strI);
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char wYVCNorthBit[36];
-                sprintf(wYVCNorthBit,"%s(%u)",wYVCNorth,vcBit);
-                sc_trace(tf,w_Y_VC_SELECTOR_TO_NORTH[i][vcBit],wYVCNorthBit);
-            }
-        }
-    }
-    // Z wires
-    for( i = 0; i < numberOfZWires; i++) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-
-        char wZDataUp[21];
-        sprintf(wZDataUp,"Z-Data-to-Up%s",strI);
-        sc_trace(tf,w_Z_DATA_TO_UP[i],wZDataUp);
-
-        char wZValidUp[22];
-        sprintf(wZValidUp,"Z-Valid-to-Up%s",strI);
-        sc_trace(tf,w_Z_VALID_TO_UP[i],wZValidUp);
-
-        char wZRetUp[22];
-        sprintf(wZRetUp,"Z-Ret-to-Up%s",strI);
-        sc_trace(tf,w_Z_RETURN_TO_UP[i],wZRetUp);
-
-        if( NUM_VC > 1 ) {
-            char wZVCUp[31];
-            sprintf(wZVCUp,"Z-VC_Sel-to-Up%s",strI);
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char wZVCUpBit[36];
-                sprintf(wZVCUpBit,"%s(%u)",wZVCUp,vcBit);
-                sc_trace(tf,w_Z_VC_SELECTOR_TO_UP[i][vcBit],wZVCUpBit);
-            }
-        }
-
-
-        char wZDataDown[21];
-        sprintf(wZDataDown,"Z-Data-to-Down%s",strI);
-        sc_trace(tf,w_Z_DATA_TO_DOWN[i],wZDataDown);
-
-        char wZValidDown[22];
-        sprintf(wZValidDown,"Z-Valid-to-Down%s",strI);
-        sc_trace(tf,w_Z_VALID_TO_DOWN[i],wZValidDown);
-
-        char wZRetDown[22];
-        sprintf(wZRetDown,"Z-Ret-to-Down%s",strI);
-        sc_trace(tf,w_Z_RETURN_TO_DOWN[i],wZRetDown);
-
-        if( NUM_VC > 1 ) {
-            char wZVCDown[31];
-            sprintf(wZVCDown,"Z-VC_Sel-to-Down%s",strI);
-            for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-                char wZVCDownBit[36];
-                sprintf(wZVCDownBit,"%s(%u)",wZVCDown,vcBit);
-                sc_trace(tf,w_Z_VC_SELECTOR_TO_DOWN[i][vcBit],wZVCDownBit);
-            }
-        }
-    }
-
-#endif
 }
 
 SoCIN_3D::~SoCIN_3D() {
-#ifdef WAVEFORM_SOCIN
-    sc_close_vcd_trace_file(tf);
-#endif
     u_ROUTER.clear();
 }
 
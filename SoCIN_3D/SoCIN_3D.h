@@ -36,8 +36,6 @@ public:
     sc_vector<sc_signal<bool> > w_Z_RETURN_TO_DOWN;
     sc_vector<sc_vector<sc_signal<bool> > > w_Z_VC_SELECTOR_TO_DOWN;// VC link
 
-    sc_trace_file* tf;
-
     SC_HAS_PROCESS(SoCIN_3D);
     SoCIN_3D(sc_module_name mn);
 
@@ -2,8 +2,6 @@
 #include "../Router/Router.h"
 #include "../PluginManager/PluginManager.h"
 
-//#define WAVEFORM_SOCIN
-
 SoCIN_Ring::SoCIN_Ring(sc_module_name mn)
     : INoC_VC(mn,NUM_ELEMENTS,NUM_VC),
     w_DATA_TO_LEFT("w_X_DATA_TO_LEFT"),
@@ -122,99 +120,9 @@ SoCIN_Ring::SoCIN_Ring(sc_module_name mn)
 
         u_ROUTER[routerId] = router;
     }
-#ifdef WAVEFORM_SOCIN
-    tf = sc_create_vcd_trace_file("socin_ring");
-    sc_trace(tf,i_CLK,"CLK");
-    sc_trace(tf,i_RST,"RST");
-    unsigned short i,vcBit;
-    // Interfaces - routers
-    for( i = 0; i < numInterfaces; i++ ) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-        char strDataIn[15];
-        sprintf(strDataIn,"DATA_IN%s",strI);
-        sc_trace(tf, i_DATA_IN[i],strDataIn);
-        char strValidIn[15];
-        sprintf(strValidIn,"VALID_IN%s",strI);
-        sc_trace(tf, i_VALID_IN[i],strValidIn);
-        char strRetIn[15];
-        sprintf(strRetIn,"RET_IN%s",strI);
-        sc_trace(tf, o_RETURN_IN[i],strRetIn);
-        for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-            char strVcIn[18];
-            sprintf(strVcIn,"VC_IN%s(%u)",strI,vcBit);
-            sc_trace(tf,i_VC_SELECTOR[i][vcBit],strVcIn);
-        }
-
-        char strDataOut[15];
-        sprintf(strDataOut,"DATA_OUT%s",strI);
-        sc_trace(tf, o_DATA_OUT[i],strDataOut);
-        char strValidOut[15];
-        sprintf(strValidOut,"VALID_OUT%s",strI);
-        sc_trace(tf, o_VALID_OUT[i],strValidOut);
-        char strRetOut[15];
-        sprintf(strRetOut,"RET_OUT%s",strI);
-        sc_trace(tf, i_RETURN_OUT[i],strRetOut);
-        for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-            char strVcOut[19];
-            sprintf(strVcOut,"VC_OUT%s(%u)",strI,vcBit);
-            sc_trace(tf,o_VC_SELECTOR[i][vcBit],strVcOut);
-        }
-    }
-
-    // Internal wires
-    for( i = 0; i < numberOfElements; i++) {
-        char strI[5];
-        sprintf(strI,"(%u)",i);
-
-        char wDataLeft[20];
-        sprintf(wDataLeft,"Data-to-Left%s",strI);
-        sc_trace(tf,w_DATA_TO_LEFT[i],wDataLeft);
-
-        char wValidLeft[21];
-        sprintf(wValidLeft,"Valid-to-Left%s",strI);
-        sc_trace(tf,w_VALID_TO_LEFT[i],wValidLeft);
-
-        char wRetLeft[21];
-        sprintf(wRetLeft,"Ret-to-Left%s",strI);
-        sc_trace(tf,w_RETURN_TO_LEFT[i],wRetLeft);
-
-        char wVCLeft[30];
-        sprintf(wVCLeft,"VC_Sel-to-Left%s",strI);
-        for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-            char wVCLeftBit[35];
-            sprintf(wVCLeftBit,"%s(%u)",wVCLeft,vcBit);
-            sc_trace(tf,w_VC_SELECTOR_TO_LEFT[i][vcBit],wVCLeftBit);
-        }
-
-
-        char wDataRight[21];
-        sprintf(wDataRight,"Data-to-Right%s",strI);
-        sc_trace(tf,w_DATA_TO_RIGHT[i],wDataRight);
-
-        char wValidRight[22];
-        sprintf(wValidRight,"Valid-to-Right%s",strI);
-        sc_trace(tf,w_VALID_TO_RIGHT[i],wValidRight);
-
-        char wRetRight[22];
-        sprintf(wRetRight,"Ret-to-Right%s",strI);
-        sc_trace(tf,w_RETURN_TO_RIGHT[i],wRetRight);
-
-        char wVCRight[31];
-        sprintf(wVCRight,"VC_Sel-to-Right%s",strI);
-        for(vcBit = 0; vcBit < widthVcSelector; vcBit++) {
-            char wVCRightBit[36];
-            sprintf(wVCRightBit,"%s(%u)",wVCRight,vcBit);
-            sc_trace(tf,w_VC_SELECTOR_TO_RIGHT[i][vcBit],wVCRightBit);
-        }
-    }
-#endif
 }
 
 SoCIN_Ring::~SoCIN_Ring() {
-#ifdef WAVEFORM_SOCIN
-    sc_close_vcd_trace_file(tf);
-#endif
     u_ROUTER.clear();
 }
 
@@ -17,9 +17,6 @@ public:
     sc_vector<sc_signal<bool> > w_RETURN_TO_RIGHT;
     sc_vector<sc_vector<sc_signal<bool> > > w_VC_SELECTOR_TO_RIGHT;// VC link
 
-    // Trace file for debug proposal (waveform)
-    sc_trace_file* tf;
-
     SC_HAS_PROCESS(SoCIN_Ring);
     SoCIN_Ring(sc_module_name mn);
 
@@ -14,6 +14,7 @@ SUBDIRS += \
     FlowControl \
     FC_Handshake \
     FC_CreditBased \
+    tst_FlowControl \
     Memory \
     FIFO \
     Multiplexers \
@@ -41,6 +42,8 @@ SUBDIRS += \
     SystemSignals \
     VcPriorityEncoder \
     TrafficMeter \
+    PacketLogConverter \
+    TelemetryViewer \
     SoCIN_single_unit \
     Routing_Crossbar \
     ParIS_Bus \
@@ -23,9 +23,6 @@ public:
     sc_vector<sc_signal<bool> > w_RETURN_ACROSS;
     sc_vector<sc_vector<sc_signal<bool> > > w_VC_SELECTOR_ACROSS;// VC link
 
-    // Trace file for debug proposal (waveform)
-    sc_trace_file* tf;
-
     SC_HAS_PROCESS(SoCIN_Spider);
     SoCIN_Spider(sc_module_name mn);
 
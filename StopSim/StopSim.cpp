@@ -1,5 +1,6 @@
 #include "StopSim.h"
 #include "../Parameters/Parameters.h"
+#include "../TrafficMeter/LogWriter.h"
 
 //#define DEBUG_STOPSIM
 
@@ -117,6 +118,13 @@ void StopSim::p_STOP() {
 
         switch( stopMethod ) {
             case AllPacketsDelivered:
+                // All the generators finished and nothing in flight (e.g. phases ended by cycles send less than the quota).
+                // A task graph run only ends by the EOT: the last message delivered does not finish the sink tasks
+                if( (v_EOT && v_NUM_PACKET_RECEIVED >= v_NUM_PACKET_SENT)
+                        || (TASK_GRAPH_FILE == NULL && v_NUM_PACKET_RECEIVED >= totalPacketsToReceive) ) {
+                    this->endSimulation(fp_out);
+                }
+                break;
             case ByPacketsDelivered:
                 if( v_NUM_PACKET_RECEIVED >= totalPacketsToReceive ) { // Stop by the number of packets delivered
                     this->endSimulation(fp_out);
@@ -135,8 +143,9 @@ void StopSim::p_STOP() {
 }
 
 void StopSim::endSimulation(FILE* fp_out) {
-    fprintf(fp_out,"%llu", i_CLK_CYCLES.read());
-    fclose(fp_out);
+    LOG_WRITER->print(fp_out,"%llu", i_CLK_CYCLES.read());
+    LOG_WRITER->close(fp_out);
+    LOG_WRITER->flush();
     o_EOS.write(1);
     wait();
     sc_stop();
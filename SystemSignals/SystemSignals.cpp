@@ -1,4 +1,6 @@
 #include "SystemSignals.h"
+#include "../Parameters/Parameters.h"
+#include "../Parameters/Waveform.h"
 
 using namespace sc_core;
 using namespace sc_dt;
@@ -18,6 +20,12 @@ SystemSignals::SystemSignals(sc_module_name mn)
     SC_CTHREAD(p_RESET,i_CLK.pos());
     sensitive << i_CLK.pos();
 
+    if( WAVEFORM->isOpen() ) {
+        SC_METHOD(p_WAVEFORM);
+        sensitive << i_CLK.neg();
+        dont_initialize();
+    }
+
 }
 
 void SystemSignals::p_CLOCK() {
@@ -43,3 +51,24 @@ void SystemSignals::p_RESET() {
     wait();
     while(1) wait();
 }
+
+/*!
+ * \brief SystemSignals::p_WAVEFORM It samples the waveform on the falling
+ * edge, when the signals written on the rising edge of the cycle are stable.
+ * Outside the window of cycles the process is not triggered on each edge.
+ */
+void SystemSignals::p_WAVEFORM() {
+    unsigned long long cycle = r_COUNTER;
+    unsigned long long startCycle = WAVEFORM->startCycle();
+    unsigned long long stopCycle = WAVEFORM->stopCycle();
+
+    if( cycle + 1 < startCycle ) {
+        // Wake up on the falling edge of the cycle before the window
+        next_trigger( sc_time( (double) (startCycle - 1 - cycle) * CLK_PERIOD, SC_NS ) );
+        return;
+    }
+    WAVEFORM->sample(cycle);
+    if( stopCycle > 0 && cycle >= stopCycle ) {
+        next_trigger(e_WAVEFORM_END);
+    }
+}
@@ -30,10 +30,12 @@ public:
 
     // Internal Signals
     unsigned long long r_COUNTER; // Global clock counter register
+    ::sc_core::sc_event   e_WAVEFORM_END; // Never notified - waveform window finished
 
     // Module's processes
     void p_CLOCK();
     void p_RESET();
+    void p_WAVEFORM();
 
     SC_HAS_PROCESS(SystemSignals);
     SystemSignals(::sc_core::sc_module_name);
@@ -0,0 +1,21 @@
+#-------------------------------------------------
+#
+# Viewer of the live telemetry (telemetry.bin)
+# published by the simulator (option -telemetry)
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+CONFIG -= qt
+CONFIG -= app_bundle
+CONFIG += console
+CONFIG += c++11
+CONFIG += thread
+
+TARGET = snocs_telemetry
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../Simulator/TelemetrySegment.h
@@ -0,0 +1,169 @@
+#include "../Simulator/TelemetrySegment.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__WIN32__) || defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <cerrno>
+#endif
+
+#define SNAPSHOT_RETRIES 1000 // Copies tried while the simulator is updating
+
+/*!
+ * \brief mapTelemetry It maps the telemetry file read-only
+ * \return The segment or NULL if the file does not exist or is too small
+ */
+static const TelemetrySegment* mapTelemetry(const char* fileName) {
+    void* memory = NULL;
+#if defined(__WIN32__) || defined(_WIN32)
+    HANDLE file = CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ | FILE_SHARE_WRITE,
+                              NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+    if( file != INVALID_HANDLE_VALUE ) {
+        if( GetFileSize(file,NULL) >= sizeof(TelemetrySegment) ) {
+            HANDLE mapping = CreateFileMappingA(file,NULL,PAGE_READONLY,0,sizeof(TelemetrySegment),NULL);
+            if( mapping != NULL ) {
+                memory = MapViewOfFile(mapping,FILE_MAP_READ,0,0,sizeof(TelemetrySegment));
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int file = open(fileName,O_RDONLY);
+    if( file >= 0 ) {
+        struct stat info;
+        if( fstat(file,&info) == 0 && (size_t) info.st_size >= sizeof(TelemetrySegment) ) {
+            memory = mmap(NULL,sizeof(TelemetrySegment),PROT_READ,MAP_SHARED,file,0);
+            if( memory == MAP_FAILED ) {
+                memory = NULL;
+            }
+        }
+        close(file);
+    }
+#endif
+    return (const TelemetrySegment*) memory;
+}
+
+/*!
+ * \brief snapshot It copies a consistent segment: the copy is retried
+ * while the simulator is updating it (odd or changed sequence)
+ */
+static bool snapshot(const TelemetrySegment* segment, TelemetrySegment& copy) {
+    for( unsigned int i = 0; i < SNAPSHOT_RETRIES; i++ ) {
+        uint32_t before = segment->sequence;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        memcpy(&copy,(const void*) segment,sizeof(TelemetrySegment));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if( (before & 1) == 0 && before == segment->sequence ) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+/*!
+ * \brief processAlive It checks if the simulator that publishes the telemetry
+ * is still running (a killed simulation never publishes the end)
+ */
+static bool processAlive(uint32_t processId) {
+#if defined(__WIN32__) || defined(_WIN32)
+    HANDLE process = OpenProcess(SYNCHRONIZE,FALSE,processId);
+    if( process == NULL ) {
+        return false;
+    }
+    bool alive = WaitForSingleObject(process,0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill((pid_t) processId,0) == 0 || errno == EPERM;
+#endif
+}
+
+static void printTelemetry(const TelemetrySegment& t) {
+    printf("\n--- SNoCS telemetry (pid %u) - %s ---\n",t.processId,
+           t.state == TelemetrySegment::Finished ? "finished" : "running");
+    printf("Cycle: %llu (update %llu, every %u cycles)  Wall time: %.1f s  Speed: %.0f cycles/s\n",
+           (unsigned long long) t.cycle,(unsigned long long) t.updates,t.interval,t.wallTime,t.cyclesPerSecond);
+    printf("Packets sent: %llu  received: %llu  delivered to meters: %llu (%llu flits)\n",
+           (unsigned long long) t.packetsSent,(unsigned long long) t.packetsReceived,
+           (unsigned long long) t.packetsDelivered,(unsigned long long) t.flitsDelivered);
+    printf("Latency (cycles) - mean: %.2f  max: %llu  last window mean: %.2f\n",
+           t.latencyMean,(unsigned long long) t.latencyMax,t.windowLatencyMean);
+    printf("Last window - accepted traffic: %.4f flits/cycle/node (%u nodes)  %.4f packets/cycle\n",
+           t.throughput,t.numElements,t.packetsPerCycle);
+    if( t.numberOfLinks > 0 ) {
+        printf("Most congested links (last window):\n");
+        printf("  Router  Port  Stall%%   Util%%\n");
+        for( unsigned int i = 0; i < t.numberOfLinks && i < TELEMETRY_TOP_LINKS; i++ ) {
+            printf("  %6u  %4u  %6.2f  %6.2f\n",t.topLinks[i].routerId,t.topLinks[i].portId,
+                   t.topLinks[i].stallRatio * 100.0,t.topLinks[i].utilization * 100.0);
+        }
+    }
+    fflush(stdout);
+}
+
+/*!
+ * \brief main It shows the telemetry published by a running simulation
+ * (option -telemetry of the simulator) until the simulation finishes.
+ * \param argv [1] Telemetry file; [2] Refresh period in seconds (default: 1)
+ * or -once to show it only once
+ */
+int main(int argc, char* argv[]) {
+
+    if( argc < 2 ) {
+        printf("Usage: %s " TELEMETRY_FILENAME " [refresh_seconds | -once]\n",argv[0]);
+        return -1;
+    }
+
+    const char* fileName = argv[1];
+    bool once = argc > 2 && strcmp(argv[2],"-once") == 0;
+    double refresh = argc > 2 && !once ? atof(argv[2]) : 1.0;
+    if( refresh <= 0.0 ) {
+        refresh = 1.0;
+    }
+
+    const TelemetrySegment* segment = mapTelemetry(fileName);
+    if( segment == NULL ) {
+        printf("[TelemetryViewer] ERROR: Impossible to map the telemetry file \"%s\".\n",fileName);
+        return -1;
+    }
+    if( strncmp(segment->magic,TELEMETRY_MAGIC,4) != 0 || segment->version != TELEMETRY_VERSION ) {
+        printf("[TelemetryViewer] ERROR: \"%s\" is not a telemetry file (version %u).\n",fileName,TELEMETRY_VERSION);
+        return -1;
+    }
+
+    TelemetrySegment copy;
+    uint64_t lastUpdate = (uint64_t) -1;
+    while( true ) {
+        if( !snapshot(segment,copy) ) {
+            printf("[TelemetryViewer] ERROR: The telemetry is being updated - try again.\n");
+            return -1;
+        }
+        if( copy.updates != lastUpdate || once ) {
+            printTelemetry(copy);
+            lastUpdate = copy.updates;
+        }
+        if( once || copy.state == TelemetrySegment::Finished ) {
+            break;
+        }
+        if( !processAlive(copy.processId) ) {
+            printf("\n[TelemetryViewer] The simulation (pid %u) stopped without finishing.\n",copy.processId);
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(refresh));
+    }
+
+    return 0;
+}
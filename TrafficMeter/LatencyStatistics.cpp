@@ -0,0 +1,162 @@
+#include "LatencyStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////
+/// LatencyHistogram
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned long long LatencyHistogram::highestEquivalentValue(unsigned int index) {
+    if( index < (1 << SUB_BUCKET_BITS) ) {
+        return index;
+    }
+    unsigned int linear = index - (1 << SUB_BUCKET_BITS);
+    unsigned int shift = linear / (1 << (SUB_BUCKET_BITS-1)) + 1;
+    unsigned long long subBucket = linear % (1 << (SUB_BUCKET_BITS-1)) + (1 << (SUB_BUCKET_BITS-1));
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &h) {
+    if( h.total == 0 ) {
+        return;
+    }
+    if( h.counts.size() > counts.size() ) {
+        counts.resize(h.counts.size(),0);
+    }
+    for( unsigned int i = 0; i < h.counts.size(); i++ ) {
+        counts[i] += h.counts[i];
+    }
+    if( total == 0 || h.minimum < minimum ) {
+        minimum = h.minimum;
+    }
+    if( h.maximum > maximum ) {
+        maximum = h.maximum;
+    }
+    sum += h.sum;
+    total += h.total;
+}
+
+unsigned long long LatencyHistogram::percentile(double p) const {
+    if( total == 0 ) {
+        return 0;
+    }
+    unsigned long long target = (unsigned long long) ceil(p / 100.0 * total);
+    if( target == 0 ) {
+        target = 1;
+    }
+    unsigned long long accumulated = 0;
+    for( unsigned int i = 0; i < counts.size(); i++ ) {
+        accumulated += counts[i];
+        if( accumulated >= target ) {
+            return std::min(highestEquivalentValue(i),maximum);
+        }
+    }
+    return maximum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// LatencyStatistics
+////////////////////////////////////////////////////////////////////////////////
+
+void LatencyStatistics::record(unsigned short source, unsigned short destination,
+                               unsigned short flowId, unsigned short trafficClass,
+                               unsigned long long networkLatency, unsigned long long totalLatency) {
+
+    all.network.record(networkLatency);
+    all.total.record(totalLatency);
+
+    if( trafficClass >= classes.size() ) {
+        classes.resize(trafficClass+1);
+    }
+    classes[trafficClass].network.record(networkLatency);
+    classes[trafficClass].total.record(totalLatency);
+
+    Latency& flow = flows[((uint32_t) source << 16) | flowId];
+    flow.network.record(networkLatency);
+    flow.total.record(totalLatency);
+    flow.destination = destination;
+
+    Latency& pair = pairs[((uint32_t) source << 16) | destination];
+    pair.network.record(networkLatency);
+    pair.total.record(totalLatency);
+}
+
+void LatencyStatistics::merge(const LatencyStatistics &s) {
+
+    all.network.merge(s.all.network);
+    all.total.merge(s.all.total);
+
+    if( s.classes.size() > classes.size() ) {
+        classes.resize(s.classes.size());
+    }
+    for( unsigned int i = 0; i < s.classes.size(); i++ ) {
+        classes[i].network.merge(s.classes[i].network);
+        classes[i].total.merge(s.classes[i].total);
+    }
+
+    std::unordered_map<uint32_t,Latency>::const_iterator it;
+    for( it = s.flows.begin(); it != s.flows.end(); it++ ) {
+        Latency& flow = flows[it->first];
+        flow.network.merge(it->second.network);
+        flow.total.merge(it->second.total);
+        flow.destination = it->second.destination;
+    }
+    for( it = s.pairs.begin(); it != s.pairs.end(); it++ ) {
+        Latency& pair = pairs[it->first];
+        pair.network.merge(it->second.network);
+        pair.total.merge(it->second.total);
+    }
+}
+
+void LatencyStatistics::writeLine(FILE *out, const char *scope, const char *key, const Latency &l) {
+    const LatencyHistogram& n = l.network;
+    const LatencyHistogram& t = l.total;
+    fprintf(out,"%s\t%11s\t%10llu\t%9.2f\t%7llu\t%7llu\t%7llu\t%7llu\t%7llu\t%9.2f\t%7llu\t%7llu\t%7llu\t%7llu\t%7llu\n",
+            scope,key,n.count(),
+            n.mean(),n.min(),n.percentile(50),n.percentile(99),n.percentile(99.9),n.max(),
+            t.mean(),t.min(),t.percentile(50),t.percentile(99),t.percentile(99.9),t.max());
+}
+
+void LatencyStatistics::writeSection(FILE *out, const char *scope,
+                                     const std::unordered_map<uint32_t,Latency> &section) {
+    std::vector<uint32_t> keys;
+    keys.reserve(section.size());
+    std::unordered_map<uint32_t,Latency>::const_iterator it;
+    for( it = section.begin(); it != section.end(); it++ ) {
+        keys.push_back(it->first);
+    }
+    std::sort(keys.begin(),keys.end());
+
+    char key[32];
+    bool isFlow = scope[0] == 'f';
+    for( unsigned int i = 0; i < keys.size(); i++ ) {
+        const Latency& l = section.find(keys[i])->second;
+        if( isFlow ) { // Source.flow->destination
+            sprintf(key,"%u.%u->%u",keys[i] >> 16,keys[i] & 0xFFFF,l.destination);
+        } else {       // Source->destination
+            sprintf(key,"%u->%u",keys[i] >> 16,keys[i] & 0xFFFF);
+        }
+        writeLine(out,scope,key,l);
+    }
+}
+
+void LatencyStatistics::writeReport(FILE *out) const {
+
+    fprintf(out,"# Network latency: header injected to trailer delivered; Total latency: packet creation to trailer delivered (cycles)\n");
+    fprintf(out,"# Scope\t        Key\t   Packets\t  Net avg\tNet min\tNet p50\tNet p99\tNet p99.9\tNet max"
+                "\tTotal avg\tTot min\tTot p50\tTot p99\tTot p99.9\tTot max\n");
+
+    writeLine(out,"all","-",all);
+
+    char key[16];
+    for( unsigned int i = 0; i < classes.size(); i++ ) {
+        if( classes[i].network.count() > 0 ) {
+            sprintf(key,"%u",i);
+            writeLine(out,"class",key,classes[i]);
+        }
+    }
+
+    writeSection(out,"flow",flows);
+    writeSection(out,"pair",pairs);
+}
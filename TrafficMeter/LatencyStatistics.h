@@ -0,0 +1,108 @@
+#ifndef __LATENCYSTATISTICS_H__
+#define __LATENCYSTATISTICS_H__
+
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+#include <cstdio>
+
+#define LATENCY_FILENAME "latency.out"
+
+/*!
+ * \brief The LatencyHistogram class is a log-linear (HDR-style) histogram
+ * of latencies. The values below 2^SUB_BUCKET_BITS are counted exactly and
+ * each power of two above is split in 2^(SUB_BUCKET_BITS-1) linear
+ * sub-buckets, so the error of the percentiles is below 1/32 of the value
+ * whatever the range. The buckets are allocated as larger values appear.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() : total(0), sum(0), minimum(0), maximum(0) {}
+
+    inline void record(unsigned long long value) {
+        unsigned int index = bucketIndex(value);
+        if( index >= counts.size() ) {
+            counts.resize(index+1,0);
+        }
+        counts[index]++;
+        if( total == 0 || value < minimum ) {
+            minimum = value;
+        }
+        if( value > maximum ) {
+            maximum = value;
+        }
+        sum += value;
+        total++;
+    }
+
+    void merge(const LatencyHistogram& h);
+
+    unsigned long long count() const { return total; }
+    unsigned long long sumOfValues() const { return sum; }
+    double mean() const { return total > 0 ? (double) sum / total : 0.0; }
+    unsigned long long min() const { return minimum; }
+    unsigned long long max() const { return maximum; }
+
+    /*!
+     * \brief percentile Highest value equivalent (same bucket) to the
+     * value at the percentile
+     * \param p Percentile (0 < p <= 100)
+     */
+    unsigned long long percentile(double p) const;
+
+private:
+    enum { SUB_BUCKET_BITS = 6 };
+
+    std::vector<uint32_t> counts;
+    unsigned long long total;
+    unsigned long long sum;
+    unsigned long long minimum;
+    unsigned long long maximum;
+
+    static inline unsigned int bucketIndex(unsigned long long value) {
+        if( value < (1ULL << SUB_BUCKET_BITS) ) {
+            return (unsigned int) value;
+        }
+        unsigned int msb = 63 - __builtin_clzll(value);
+        unsigned int shift = msb - (SUB_BUCKET_BITS-1);  // Keeps the SUB_BUCKET_BITS most significant bits
+        return (1 << SUB_BUCKET_BITS) + (shift-1) * (1 << (SUB_BUCKET_BITS-1))
+                + (unsigned int) ((value >> shift) - (1ULL << (SUB_BUCKET_BITS-1)));
+    }
+    static unsigned long long highestEquivalentValue(unsigned int index);
+};
+
+/*!
+ * \brief The LatencyStatistics class collects the latency of the packets
+ * delivered to a traffic meter: network latency (header injected to
+ * trailer delivered) and total latency (packet creation to trailer
+ * delivered), by traffic class, flow and source-destination pair.
+ * Each meter has its own statistics, merged at the end of simulation.
+ */
+class LatencyStatistics {
+public:
+    void record(unsigned short source, unsigned short destination,
+                unsigned short flowId, unsigned short trafficClass,
+                unsigned long long networkLatency, unsigned long long totalLatency);
+
+    void merge(const LatencyStatistics& s);
+
+    void writeReport(FILE* out) const;
+
+private:
+    struct Latency {
+        LatencyHistogram network;
+        LatencyHistogram total;
+        unsigned short destination; // Flows: destination of the flow
+    };
+
+    Latency all;
+    std::vector<Latency> classes;
+    std::unordered_map<uint32_t,Latency> flows; // Key: source and flow id
+    std::unordered_map<uint32_t,Latency> pairs; // Key: source and destination
+
+    static void writeLine(FILE* out, const char* scope, const char* key, const Latency& l);
+    static void writeSection(FILE* out, const char* scope,
+                             const std::unordered_map<uint32_t,Latency>& section);
+};
+
+#endif // __LATENCYSTATISTICS_H__
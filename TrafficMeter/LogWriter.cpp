@@ -0,0 +1,194 @@
+#include "LogWriter.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstring>
+
+LogWriter* LogWriter::writer = 0;
+
+LogWriter* LogWriter::instance() {
+    if( !writer ) {
+        writer = new LogWriter();
+    }
+    return writer;
+}
+
+LogWriter::LogWriter()
+    : ring(NULL),
+      head(0),
+      tail(0),
+      reserved(0),
+      running(false),
+      waits(0)
+{}
+
+LogWriter::~LogWriter() {
+    this->stop();
+    delete[] ring;
+}
+
+void LogWriter::start() {
+    if( running.load() ) {
+        return;
+    }
+    if( ring == NULL ) {
+        ring = new char[LOG_RING_SIZE];
+    }
+    head.store(0);
+    tail.store(0);
+    reserved = 0;
+    running.store(true);
+    consumer = std::thread(&LogWriter::drain,this);
+}
+
+void LogWriter::stop() {
+    if( !running.load() ) {
+        return;
+    }
+    running.store(false,std::memory_order_release);
+    consumer.join();
+    fflush(NULL);
+}
+
+void LogWriter::waitRoom(size_t bytes) {
+    if( LOG_RING_SIZE - (reserved - tail.load(std::memory_order_acquire)) >= bytes ) {
+        return;
+    }
+    waits++;
+    while( LOG_RING_SIZE - (reserved - tail.load(std::memory_order_acquire)) < bytes ) {
+        std::this_thread::yield();
+    }
+}
+
+char* LogWriter::reserve(size_t length) {
+
+    if( !running.load(std::memory_order_relaxed) ) {
+        if( scratch.size() < length ) {
+            scratch.resize(length);
+        }
+        return &scratch[0];
+    }
+
+    size_t bytes = align(sizeof(MessageHeader) + length);
+    size_t offset = reserved & (LOG_RING_SIZE - 1);
+    size_t contiguous = LOG_RING_SIZE - offset;
+    if( bytes > contiguous ) { // The message does not fit at the end: it goes to the beginning
+        waitRoom(contiguous);
+        MessageHeader* wrap = (MessageHeader*) (ring + offset);
+        wrap->file = NULL;
+        wrap->length = (uint32_t) (contiguous - sizeof(MessageHeader));
+        wrap->operation = OpWrap;
+        reserved += contiguous;
+        offset = 0;
+    }
+    waitRoom(bytes);
+    return ring + offset + sizeof(MessageHeader);
+}
+
+void LogWriter::publish(FILE *file, size_t length, Operation operation) {
+    MessageHeader* header = (MessageHeader*) (ring + (reserved & (LOG_RING_SIZE - 1)));
+    header->file = file;
+    header->length = (uint32_t) length;
+    header->operation = operation;
+    reserved += align(sizeof(MessageHeader) + length);
+    head.store(reserved,std::memory_order_release);
+}
+
+void LogWriter::commit(FILE *file, size_t length) {
+    if( !running.load(std::memory_order_relaxed) ) {
+        fwrite(&scratch[0],1,length,file);
+        return;
+    }
+    publish(file,length,OpWrite);
+}
+
+void LogWriter::write(FILE *file, const void *data, size_t length) {
+    const size_t chunk = LOG_RING_SIZE / 4;
+    const char* bytes = (const char*) data;
+    while( length > 0 ) {
+        size_t size = length < chunk ? length : chunk;
+        memcpy(this->reserve(size),bytes,size);
+        this->commit(file,size);
+        bytes += size;
+        length -= size;
+    }
+}
+
+void LogWriter::print(FILE *file, const char *format, ...) {
+    va_list args;
+    va_start(args,format);
+    char* message = this->reserve(LOG_MAX_MESSAGE);
+    int length = vsnprintf(message,LOG_MAX_MESSAGE,format,args);
+    va_end(args);
+    if( length < 0 ) {
+        return;
+    }
+    if( length >= LOG_MAX_MESSAGE ) { // Truncated - it is formatted again in a buffer big enough
+        std::vector<char> buffer(length+1);
+        va_start(args,format);
+        vsnprintf(&buffer[0],buffer.size(),format,args);
+        va_end(args);
+        this->write(file,&buffer[0],length);
+        return;
+    }
+    this->commit(file,length);
+}
+
+void LogWriter::close(FILE *file) {
+    if( !running.load(std::memory_order_relaxed) ) {
+        fclose(file);
+        return;
+    }
+    this->reserve(0);
+    publish(file,0,OpClose);
+}
+
+void LogWriter::flush() {
+    if( !running.load(std::memory_order_relaxed) ) {
+        fflush(NULL);
+        return;
+    }
+    this->reserve(0);
+    publish(NULL,0,OpFlush);
+    while( tail.load(std::memory_order_acquire) != reserved ) {
+        std::this_thread::yield();
+    }
+}
+
+/*!
+ * \brief LogWriter::drain Writer thread: it writes the messages published
+ * until the writer is stopped and the ring is empty
+ */
+void LogWriter::drain() {
+
+    size_t position = tail.load(std::memory_order_relaxed);
+    while( true ) {
+        size_t published = head.load(std::memory_order_acquire);
+        if( position == published ) {
+            if( !running.load(std::memory_order_acquire) && position == head.load(std::memory_order_acquire) ) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+
+        while( position != published ) {
+            const MessageHeader* header = (const MessageHeader*) (ring + (position & (LOG_RING_SIZE - 1)));
+            switch( header->operation ) {
+                case OpWrite:
+                    fwrite((const char*) header + sizeof(MessageHeader),1,header->length,header->file);
+                    break;
+                case OpClose:
+                    fclose(header->file);
+                    break;
+                case OpFlush:
+                    fflush(NULL);
+                    break;
+                default: // OpWrap - rest of the ring unused
+                    break;
+            }
+            position += align(sizeof(MessageHeader) + header->length);
+            tail.store(position,std::memory_order_release);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef __LOGWRITER_H__
+#define __LOGWRITER_H__
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdio>
+#include <cstddef>
+#include <stdint.h>
+
+#define LOG_WRITER LogWriter::instance() // Get the writer of the simulation logs
+
+#define LOG_RING_SIZE    (1 << 22) // Bytes of the ring (power of two)
+#define LOG_MAX_MESSAGE  1024      // Largest message formatted by print()
+
+/*!
+ * \brief The LogWriter class moves the file writes of the simulation
+ * processes (traffic meters, packet log, stop simulation) to a writer
+ * thread, so the simulation kernel does not wait for the disk.
+ *
+ * The messages are written in a single-producer/single-consumer
+ * lock-free ring: the producer is the simulation thread (all the
+ * SystemC processes) and the consumer is the writer thread. When the
+ * ring is full the producer waits for room (back-pressure) instead of
+ * dropping messages. A message is written in the ring in place: the
+ * producer reserves room, formats the content and commits it.
+ *
+ * Before start() and after stop() the writes are synchronous.
+ */
+class LogWriter {
+public:
+    static LogWriter* instance();
+
+    /*!
+     * \brief start It starts the writer thread
+     */
+    void start();
+
+    /*!
+     * \brief stop It writes all the messages in the ring and stops the
+     * writer thread
+     */
+    void stop();
+
+    /*!
+     * \brief reserve It reserves room for a message, waiting while the
+     * ring is full
+     * \return Where the content of the message is written, up to length bytes
+     */
+    char* reserve(size_t length);
+
+    /*!
+     * \brief commit It publishes the message reserved to be written in a file
+     * \param length Bytes written in the room reserved
+     */
+    void commit(FILE* file, size_t length);
+
+    void write(FILE* file, const void* data, size_t length);
+    void print(FILE* file, const char* format, ...);
+
+    /*!
+     * \brief close It closes the file after its pending messages
+     */
+    void close(FILE* file);
+
+    /*!
+     * \brief flush It waits until all the messages are written and the
+     * files flushed
+     */
+    void flush();
+
+    bool isRunning() const { return running.load(); }
+    unsigned long long backPressureWaits() const { return waits; }
+
+private:
+    enum Operation { OpWrite = 0, OpClose, OpFlush, OpWrap };
+
+    struct MessageHeader {
+        FILE*    file;
+        uint32_t length;      // Bytes of content after the header
+        uint32_t operation;
+    };
+
+    enum { ALIGNMENT = 16 };  // Messages begin aligned (room for a header at the end of the ring)
+
+    static LogWriter* writer;
+
+    char* ring;
+    std::atomic<size_t> head;       // Bytes published by the producer (free running)
+    std::atomic<size_t> tail;       // Bytes consumed by the writer thread (free running)
+    size_t reserved;                // Position of the message reserved
+    std::vector<char> scratch;      // Message reserved in synchronous mode
+    std::atomic<bool> running;
+    std::thread consumer;
+    unsigned long long waits;       // Times the producer waited for room
+
+    LogWriter();
+    LogWriter(const LogWriter&);
+    LogWriter& operator= (const LogWriter&);
+    ~LogWriter();
+
+    static inline size_t align(size_t bytes) { return (bytes + ALIGNMENT - 1) & ~((size_t) ALIGNMENT - 1); }
+
+    void waitRoom(size_t bytes);
+    void publish(FILE* file, size_t length, Operation operation);
+    void drain();
+};
+
+#endif // __LOGWRITER_H__
@@ -0,0 +1,149 @@
+#include "PacketLog.h"
+#include "LogWriter.h"
+
+#include <cstring>
+#include <cmath>
+
+#define LOG_MAGIC "SNPL"
+#define LOG_VERSION 1
+#define LOG_NAME_LENGTH 32
+#define LOG_BUFFER_RECORDS (1 << 12) // 224 KB passed to the log writer at once
+
+PacketLog* PacketLog::log = 0;
+
+PacketLog* PacketLog::instance() {
+    if( !log ) {
+        log = new PacketLog();
+    }
+    return log;
+}
+
+PacketLog::PacketLog()
+    : file(NULL),
+      numberOfRecords(0),
+      endCycle(0)
+{}
+
+PacketLog::~PacketLog() {
+    this->close();
+}
+
+bool PacketLog::open(const char *fileName) {
+
+    if( (file = fopen(fileName,"wb")) == NULL ) {
+        printf("\n[PacketLog] ERROR: It is not possible to open file \"%s\" to write log.",fileName);
+        return false;
+    }
+    setvbuf(file,NULL,_IONBF,0); // The records are already buffered in blocks
+
+    // Placeholder - the header is rewritten on closing
+    LogHeader header;
+    memset(&header,0,sizeof(header));
+    LOG_WRITER->write(file,&header,sizeof(header));
+
+    buffer.reserve(LOG_BUFFER_RECORDS);
+    return true;
+}
+
+unsigned short PacketLog::addMeter(const char *name) {
+    meters.push_back(name);
+    return (unsigned short) (meters.size() - 1);
+}
+
+void PacketLog::flush() {
+    if( !buffer.empty() ) {
+        if( file != NULL ) {
+            LOG_WRITER->write(file,&buffer[0],sizeof(LogRecord) * buffer.size());
+            numberOfRecords += buffer.size();
+        }
+        buffer.clear();
+    }
+}
+
+void PacketLog::close() {
+
+    if( file == NULL ) {
+        return;
+    }
+    this->flush();
+
+    char name[LOG_NAME_LENGTH];
+    for( unsigned int i = 0; i < meters.size(); i++ ) {
+        memset(name,0,LOG_NAME_LENGTH);
+        strncpy(name,meters[i].c_str(),LOG_NAME_LENGTH-1);
+        LOG_WRITER->write(file,name,LOG_NAME_LENGTH);
+    }
+    LOG_WRITER->flush(); // The header is rewritten after all the blocks
+
+    LogHeader header;
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,LOG_MAGIC,4);
+    header.version = LOG_VERSION;
+    header.numberOfRecords = numberOfRecords;
+    header.endCycle = endCycle;
+    header.numberOfMeters = (uint32_t) meters.size();
+    header.nameLength = LOG_NAME_LENGTH;
+    fseek(file,0,SEEK_SET);
+    fwrite(&header,sizeof(header),1,file);
+
+    fclose(file);
+    file = NULL;
+}
+
+// Characters written by snprintf (the text is truncated to fit the size)
+static inline int written(size_t size, int length) {
+    return length < (int) size ? length : (int) size - 1;
+}
+
+int PacketLog::formatTextHeader(char *text, size_t size, const char *fileName) {
+    // It prints the header of the table
+#if defined(__WIN32__) || defined(_WIN32)
+    return written(size,snprintf(text,size,"FILE: %s\n"
+                    "\n    Packet\t SRC\tDEST\tHops\t Flow \tTraffic    Deadline\t    Packet\t    Header\t   Trailer\t Packet\t    Req"
+                    "\n        ID\t    \t    \t    \t   ID \t  Class            \t  Creation\t  at cycle\t  at cycle\t Length\t     BW"
+                    "\n#\n",fileName));
+#else
+    return written(size,snprintf(text,size,"FILE: %s\n"
+                    "\n    Packet\t SRC\tDEST\tHops\t Flow \tTraffic\t    Deadline    Packet\t    Header\t   Trailer\t Packet\t    Req"
+                    "\n        ID\t    \t    \t    \t   ID \t  Class\t              Creation\t  at cycle\t  at cycle\t Length\t     BW"
+                    "\n#\n",fileName));
+#endif
+}
+
+int PacketLog::formatTextRecord(char *text, size_t size, const LogRecord &record) {
+    return written(size,snprintf(text,size,"%10llu\t%4u\t%4u\t%4u\t  %2u\t  %2u\t%10llu\t%10llu\t%10llu\t%10llu\t%5u\t  %.2f\t\n",
+                    (unsigned long long) record.packetId,
+                    record.source,
+                    record.destination,
+                    record.hops,
+                    record.flowId,
+                    record.trafficClass,
+                    (unsigned long long) record.deadline,
+                    (unsigned long long) record.creationCycle,
+                    (unsigned long long) record.headerCycle,
+                    (unsigned long long) record.trailerCycle,
+                    record.payloadLength,
+                    round(record.requiredBW) ));
+}
+
+int PacketLog::formatTextFooter(char *text, size_t size, unsigned long long endCycle) {
+    return written(size,snprintf(text,size,"\n# %llu", endCycle));
+}
+
+void PacketLog::writeTextHeader(FILE *out, const char *fileName) {
+    char text[PACKET_LOG_TEXT_LENGTH];
+    formatTextHeader(text,PACKET_LOG_TEXT_LENGTH,fileName);
+    fputs(text,out);
+}
+
+void PacketLog::writeTextRecord(FILE *out, const LogRecord &record) {
+    char text[PACKET_LOG_TEXT_LENGTH];
+    formatTextRecord(text,PACKET_LOG_TEXT_LENGTH,record);
+    fputs(text,out);
+}
+
+void PacketLog::writeTextFooter(FILE *out, unsigned long long endCycle) {
+    char text[PACKET_LOG_TEXT_LENGTH];
+    formatTextFooter(text,PACKET_LOG_TEXT_LENGTH,endCycle);
+    fputs(text,out);
+}
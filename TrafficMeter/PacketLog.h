@@ -0,0 +1,115 @@
+#ifndef __PACKETLOG_H__
+#define __PACKETLOG_H__
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include <cstdio>
+
+#define PACKET_LOG PacketLog::instance() // Get the binary packet log shared by all the traffic meters
+
+#define PACKET_LOG_FILENAME "packetlog.bin"
+#define PACKET_LOG_TEXT_LENGTH 512 // Room for a line of the text format
+
+/*!
+ * \brief The PacketLog class writes the packets delivered to all the
+ * traffic meters in a single binary file, instead of one text file per
+ * meter. The records have a fixed width and are written in blocks,
+ * so a long run costs a few big writes.
+ *
+ * The text format of the traffic meters (e.g. ext_0_out) is produced on
+ * demand by the packet log converter (PacketLogConverter).
+ *
+ * The blocks are written by the log writer thread (LogWriter).
+ *
+ * File format (native byte order - little-endian in x86 hosts):
+ *  - Header: 4-byte magic "SNPL", uint32 version (1), uint64 number of
+ *    records, uint64 end cycle, uint32 number of meters, uint32 name length
+ *  - Records in the order of delivery (LogRecord - 56 bytes each)
+ *  - Meter table: a name (log file of the meter) of fixed length per meter
+ */
+class PacketLog {
+public:
+    struct LogHeader {
+        char     magic[4];          // "SNPL"
+        uint32_t version;           // Format version
+        uint64_t numberOfRecords;   // Number of packets in the log
+        uint64_t endCycle;          // Cycle of the end of simulation
+        uint32_t numberOfMeters;    // Number of entries in the meter table
+        uint32_t nameLength;        // Length of each entry in the meter table
+    };
+
+    struct LogRecord {
+        uint64_t packetId;
+        uint64_t deadline;
+        uint64_t creationCycle;     // Packet creation
+        uint64_t headerCycle;       // Header arrived at the meter
+        uint64_t trailerCycle;      // Trailer arrived at the meter
+        float    requiredBW;
+        uint16_t meter;             // Meter that logged the packet (entry in the meter table)
+        uint16_t source;
+        uint16_t destination;
+        uint16_t hops;
+        uint16_t payloadLength;
+        uint8_t  flowId;
+        uint8_t  trafficClass;
+    };
+
+    static PacketLog* instance();
+
+    bool open(const char* fileName);
+    bool isOpen() const { return file != NULL; }
+
+    /*!
+     * \brief addMeter It registers a meter in the log
+     * \param name Name of the text log of the meter (e.g. ext_0_out)
+     * \return Meter identifier to be used in the records
+     */
+    unsigned short addMeter(const char* name);
+
+    inline void write(const LogRecord& record) {
+        buffer.push_back(record);
+        if( buffer.size() == buffer.capacity() ) {
+            this->flush();
+        }
+    }
+
+    /*!
+     * \brief finish It registers the end of simulation seen by a meter
+     */
+    void finish(unsigned long long cycle) { if( cycle > endCycle ) endCycle = cycle; }
+
+    /*!
+     * \brief close It writes the buffered records, the meter table and
+     * the final header
+     */
+    void close();
+
+    // Text format of the traffic meters - also used by the converter
+    // The format functions return the number of characters written in the text
+    static int formatTextHeader(char* text, size_t size, const char* fileName);
+    static int formatTextRecord(char* text, size_t size, const LogRecord& record);
+    static int formatTextFooter(char* text, size_t size, unsigned long long endCycle);
+    static void writeTextHeader(FILE* out, const char* fileName);
+    static void writeTextRecord(FILE* out, const LogRecord& record);
+    static void writeTextFooter(FILE* out, unsigned long long endCycle);
+
+    ~PacketLog();
+
+private:
+    static PacketLog* log;
+
+    FILE* file;
+    std::vector<LogRecord> buffer;
+    std::vector<std::string> meters;
+    uint64_t numberOfRecords;
+    unsigned long long endCycle;
+
+    PacketLog();
+    PacketLog(const PacketLog&);
+    PacketLog& operator= (const PacketLog&);
+
+    void flush();
+};
+
+#endif // __PACKETLOG_H__
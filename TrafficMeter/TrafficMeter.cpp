@@ -1,5 +1,8 @@
 #include "TrafficMeter.h"
+#include "LogWriter.h"
 #include "../PluginManager/PluginManager.h"
+#include "../Parameters/PacketTracer.h"
+#include "../Parameters/LatencyBreakdown.h"
 
 TrafficMeter::TrafficMeter(sc_module_name mn,
                            char *workDir,
@@ -7,9 +10,13 @@ TrafficMeter::TrafficMeter(sc_module_name mn,
                            INoC::TopologyType topologyType,
                            bool isExternal)
     : SoCINModule(mn),
-      workDir(workDir),outFileName(fileName), outFile(NULL),
+      workDir(workDir),outFileName(fileName), outFile(NULL), logMeter(0),
       topologyType(topologyType),
       isExternal(isExternal),
+      latencyStatistics(NULL),
+      packetsReceived(0),
+      flitsReceived(0),
+      windowLatencyMax(0),
       i_CLK("TrafficMeter_iCLK"),
       i_RST("TrafficMeter_iRST"),
       i_EOS("TrafficMeter_iEOS"),
@@ -40,6 +47,8 @@ TrafficMeter::TrafficMeter(sc_module_name mn,
         i_VC_SEL.init(widthVcSelector);
     }
 
+    // Only the IFC of the meter monitors the received flits
+    u_IFC->enablePacketMonitoring();
     SC_METHOD(p_PROBE);
     sensitive << u_IFC->e_PACKET_RECEIVED;
 
@@ -47,10 +56,26 @@ TrafficMeter::TrafficMeter(sc_module_name mn,
     sensitive << i_EOS;
 }
 
-TrafficMeter::~TrafficMeter() {}
+TrafficMeter::~TrafficMeter() {
+    delete latencyStatistics;
+}
 
 void TrafficMeter::initialize() {
 
+    if( LATENCY_STATISTICS ) {
+        this->latencyStatistics = new LatencyStatistics();
+    }
+
+    if( !PACKET_LOGGING ) {
+        return;
+    }
+
+    // Binary log shared by all the meters - converted to text on demand
+    if( BINARY_PACKET_LOG && PACKET_LOG->isOpen() ) {
+        this->logMeter = PACKET_LOG->addMeter(outFileName);
+        return;
+    }
+
     char pathFilename[256];
     sprintf(pathFilename,"%s/%s",workDir,outFileName);
 
@@ -63,17 +88,8 @@ void TrafficMeter::initialize() {
     }
 
     // It prints the header of the table
-    fprintf(outFile,"FILE: %s",pathFilename);
-    fprintf(outFile,"\n");
-#if defined(__WIN32__) || defined(_WIN32)
-    fprintf(outFile,"\n    Packet\t SRC\tDEST\tHops\t Flow \tTraffic    Deadline\t    Packet\t    Header\t   Trailer\t Packet\t    Req");
-    fprintf(outFile,"\n        ID\t    \t    \t    \t   ID \t  Class            \t  Creation\t  at cycle\t  at cycle\t Length\t     BW");
-#else
-    fprintf(outFile,"\n    Packet\t SRC\tDEST\tHops\t Flow \tTraffic\t    Deadline    Packet\t    Header\t   Trailer\t Packet\t    Req");
-    fprintf(outFile,"\n        ID\t    \t    \t    \t   ID \t  Class\t              Creation\t  at cycle\t  at cycle\t Length\t     BW");
-#endif
-
-    fprintf(outFile,"\n#\n");
+    char* text = LOG_WRITER->reserve(PACKET_LOG_TEXT_LENGTH);
+    LOG_WRITER->commit(outFile,PacketLog::formatTextHeader(text,PACKET_LOG_TEXT_LENGTH,pathFilename));
 }
 
 void TrafficMeter::p_PROBE() {
@@ -84,8 +100,14 @@ void TrafficMeter::p_PROBE() {
 void TrafficMeter::p_FINISH() {
 
     if( i_EOS.read() == 1 ) {
-        fprintf(this->outFile,"\n# %llu", i_CLK_CYCLES.read());
-        fclose(outFile);
+        if( outFile != NULL ) {
+            char* text = LOG_WRITER->reserve(PACKET_LOG_TEXT_LENGTH);
+            LOG_WRITER->commit(outFile,PacketLog::formatTextFooter(text,PACKET_LOG_TEXT_LENGTH,i_CLK_CYCLES.read()));
+            LOG_WRITER->close(outFile);
+            outFile = NULL;
+        } else if( PACKET_LOG->isOpen() ) {
+            PACKET_LOG->finish(i_CLK_CYCLES.read());
+        }
     }
 }
 
@@ -101,6 +123,8 @@ void TrafficMeter::writeInfo() {
     v_BOP = v_DATA[FLIT_WIDTH-2];
     v_EOP = v_DATA[FLIT_WIDTH-1];
 
+    flitsReceived++;
+
     // Copy the header content and register the cycle of arriving of the header
     if( v_BOP ) {
         this->packetHeader = v_DATA;
@@ -115,20 +139,43 @@ void TrafficMeter::writeInfo() {
             unsigned short dest = this->getPacketDestination();
             unsigned short trafficClass = (unsigned short) packetHeader(CLS_POS,CLS_POS-2).to_uint();
             unsigned short flowId = (unsigned short) packetHeader(25,24).to_uint();
-            fprintf(outFile,"%10lu\t"  , packet->packetId); // TEMP
-            fprintf(outFile,"%4u\t"    , src);
-            fprintf(outFile,"%4u\t"    , dest);
-            fprintf(outFile,"%4u\t"    , packet->hops);
-            fprintf(outFile,"  %2u\t"  , flowId);
-            fprintf(outFile,"  %2u\t"  , trafficClass);
-            fprintf(outFile,"%10lu\t"  , packet->deadline);
-            fprintf(outFile,"%10lu\t"  , packet->packetCreationCycle);
-            fprintf(outFile,"%10llu\t"  , this->cycleOfArriving);
-            fprintf(outFile,"%10llu\t"  , i_CLK_CYCLES.read());
-            fprintf(outFile,"%5u\t"    , packet->payloadLength);
-            fprintf(outFile,"  %.2f\t" , round(packet->requiredBW) );
-            fprintf(outFile,"\n");
+            PacketLog::LogRecord record;
+            record.packetId = packet->packetId;
+            record.deadline = packet->deadline;
+            record.creationCycle = packet->packetCreationCycle;
+            record.headerCycle = this->cycleOfArriving;
+            record.trailerCycle = i_CLK_CYCLES.read();
+            record.requiredBW = packet->requiredBW;
+            record.meter = this->logMeter;
+            record.source = src;
+            record.destination = dest;
+            record.hops = packet->hops;
+            record.payloadLength = packet->payloadLength;
+            record.flowId = (uint8_t) flowId;
+            record.trafficClass = (uint8_t) trafficClass;
+            if( outFile != NULL ) { // Formatted in place in the ring of the log writer
+                char* text = LOG_WRITER->reserve(PACKET_LOG_TEXT_LENGTH);
+                LOG_WRITER->commit(outFile,PacketLog::formatTextRecord(text,PACKET_LOG_TEXT_LENGTH,record));
+            } else if( PACKET_LOG->isOpen() ) {
+                PACKET_LOG->write(record);
+            }
+            unsigned long long injection = packet->injectionCycle > 0 ? packet->injectionCycle : cycleOfArriving;
+            unsigned long long netLatency = record.trailerCycle > injection ? record.trailerCycle - injection : 0;
+            unsigned long long totLatency = record.trailerCycle > record.creationCycle ? record.trailerCycle - record.creationCycle : 0;
+            packetsReceived++;
+            networkLatency.record(netLatency);
+            totalLatency.record(totLatency);
+            if( netLatency > windowLatencyMax ) {
+                windowLatencyMax = netLatency;
+            }
+            if( latencyStatistics != NULL ) {
+                latencyStatistics->record(src,dest,flowId,trafficClass,netLatency,totLatency);
+            }
             if(isExternal) {
+                if( packet->traced ) {
+                    PACKET_TRACER->delivered(packet->packetId,record.trailerCycle);
+                }
+                LATENCY_BREAKDOWN->delivered(packet->packetId,src,dest,record.creationCycle,injection,record.trailerCycle);
                 delete packet;
                 packet = NULL;
             }
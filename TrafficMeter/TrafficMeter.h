@@ -21,6 +21,8 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 #include "../SoCINDefines.h"
 #include "../FlowControl/FlowControl.h"
 #include "../NoC/NoC.h"
+#include "PacketLog.h"
+#include "LatencyStatistics.h"
 
 /*!
  * \brief The TrafficMeter class implements a link traffic meter
@@ -34,6 +36,7 @@ protected:
     char* outFileName;      // Filename of the log
 
     FILE* outFile;          // File of the log
+    unsigned short logMeter;// Meter identifier in the binary packet log
 
     unsigned short trafficClassWidth;    // Width of the field traffic class in the header flit
 
@@ -43,6 +46,15 @@ protected:
     INoC::TopologyType topologyType;
     bool isExternal;                    // Flag to indicates if the traffic meter is external of the network.
 public:
+    LatencyStatistics* latencyStatistics; // Latency histograms of the packets received (NULL: disabled)
+
+    // Totals of the traffic received (run summary)
+    unsigned long long packetsReceived;
+    unsigned long long flitsReceived;
+    LatencyHistogram   networkLatency;      // Header injected to trailer delivered
+    LatencyHistogram   totalLatency;        // Packet creation to trailer delivered
+    unsigned long long windowLatencyMax;    // Maximum network latency since the last window of the time series (reset by it)
+
     // Interface
     // System signals
     sc_in<bool>          i_CLK;        // Clock
@@ -11,8 +11,14 @@ TEMPLATE = aux
 
 HEADERS += \
     TrafficMeter.h \
+    PacketLog.h \
+    LogWriter.h \
+    LatencyStatistics.h \
     ../PluginManager/PluginManager.h
 
 SOURCES += \
     TrafficMeter.cpp \
+    PacketLog.cpp \
+    LogWriter.cpp \
+    LatencyStatistics.cpp \
     ../PluginManager/PluginManager.cpp
@@ -19,6 +19,8 @@ CONTACT: Prof. Cesar Zeferino (zeferino@univali.br)
 --------------------------------------------------------------------------------
 | 03/10/2016 - 1.1     - Eduardo Alves da Silva      | Dynamic virtual channel
 --------------------------------------------------------------------------------
+| 19/10/2026 - 1.2     - SoCIN Simulator team        | Stall and activity counters
+--------------------------------------------------------------------------------
 */
 #ifndef __XIN_H__
 #define __XIN_H__
@@ -78,6 +80,14 @@ public:
     OneHotMux<bool>* u_IRS;
     And*             u_AND_READ;
 
+    // Stall counters (NULL: not counted) - set by the XIN_N_VC
+    StallCounters*    stallCounters;
+    // Flits and headers read: crossbar traversals and route computations (NULL: not counted)
+    ActivityCounters* activityCounters;
+
+    // Module's process
+    void p_COUNTERS();
+
     SC_HAS_PROCESS(XIN_Virtual);
     XIN_Virtual(sc_module_name mn,
                 unsigned short nPorts,
@@ -116,6 +126,8 @@ inline XIN_Virtual::XIN_Virtual(sc_module_name mn,
      w_READ_OK("XIN_Virtual_wREAD_OK"),
      w_X_READ("XIN_Virtual_wX_READ"),
      w_REQUESTING("XIN_Virtual_wREQUESTING"),
+     stallCounters(NULL),
+     activityCounters(NULL),
      ROUTER_ID(ROUTER_ID), PORT_ID(PORT_ID)
 {
     // Instantiating sub-modules
@@ -126,6 +138,10 @@ inline XIN_Virtual::XIN_Virtual(sc_module_name mn,
     u_AND_READ    = new And("XIN_Virtual_AND_READ",2);
     u_AND_READ_OK = new And("XIN_Virtual_AND_READ_OK",2);
     u_IRS         = new OneHotMux<bool>("XIN_Virtual_IRS",nPorts);
+    if( ACTIVITY_COUNTERS ) {
+        activityCounters = INSTRUMENTATION->activityCounters(ROUTER_ID);
+        u_MEMORY->activityCounters = activityCounters;
+    }
 
     // Port binding
     ////////////////////// Memory //////////////////////
@@ -137,6 +153,7 @@ inline XIN_Virtual::XIN_Virtual(sc_module_name mn,
     u_MEMORY->i_WRITE(i_WRITE);
     u_MEMORY->i_DATA(i_DATA);
     u_MEMORY->o_DATA(o_X_DATA);
+    u_MEMORY->packetTracing = PACKET_TRACER->isOpen() || LATENCY_BREAKDOWN->isEnabled();
 
     ////////////////////// IC //////////////////////
     u_IC->i_CLK(i_CLK);
@@ -162,6 +179,37 @@ inline XIN_Virtual::XIN_Virtual(sc_module_name mn,
     u_AND_READ->i_DATA[0](w_X_READ);
     u_AND_READ->i_DATA[1](w_REQUESTING);
     u_AND_READ->o_DATA(o_READ);
+
+    if( STALL_COUNTERS || ACTIVITY_COUNTERS ) {
+        SC_METHOD(p_COUNTERS);
+        sensitive << i_CLK.pos();
+        dont_initialize();
+    }
+}
+
+/*!
+ * \brief XIN_Virtual::p_COUNTERS It classifies the cycle that ends on the clock
+ * edge (flit at the head of the buffer not read and why) and counts the flit
+ * read, that crosses the crossbar, and the header read, that was routed
+ */
+inline void XIN_Virtual::p_COUNTERS() {
+    if( stallCounters != NULL ) {
+        bool granted = false, idle = false;
+        for( unsigned short p = 0; p < numPorts; p++ ) {
+            if( o_X_REQUEST[p].read() ) {
+                granted = i_X_GRANT[p].read();
+                idle = i_X_IDLE[p].read();
+                break;
+            }
+        }
+        stallCounters->sample(w_READ_OK.read(),o_READ.read(),w_REQUESTING.read(),granted,idle);
+    }
+    if( activityCounters != NULL && o_READ.read() && w_READ_OK.read() ) {
+        activityCounters->crossbarTraversals++;
+        if( o_X_DATA.read().data[FLIT_WIDTH-2] == 1 ) {
+            activityCounters->routeComputations++;
+        }
+    }
 }
 
 /*!
@@ -315,6 +363,12 @@ inline XIN_N_VC::XIN_N_VC(sc_module_name mn,
         char strXinVC[17];
         sprintf(strXinVC,"XIN_u_VC(%u)",i);
         u_XIN_VC[i] = new XIN_Virtual(strXinVC,nPorts,ROUTER_ID,PORT_ID);
+        if( BUFFER_OCCUPANCY && FIFO_IN_DEPTH > 0 ) {
+            u_XIN_VC[i]->u_MEMORY->bufferCounters = INSTRUMENTATION->bufferCounters(ROUTER_ID,PORT_ID,i,true,FIFO_IN_DEPTH);
+        }
+        if( STALL_COUNTERS ) {
+            u_XIN_VC[i]->stallCounters = INSTRUMENTATION->stallCounters(ROUTER_ID,PORT_ID,i,nVirtualChannels > 1,STALL_INTERVAL);
+        }
     }
 
     //=============== Binding ports ===============//
@@ -439,6 +493,14 @@ public:
     OneHotMux<bool>*    u_IRS;
     And*                u_AND_READ;
 
+    // Stall counters (NULL: not counted)
+    StallCounters*      stallCounters;
+    // Flits and headers read: crossbar traversals and route computations (NULL: not counted)
+    ActivityCounters*   activityCounters;
+
+    // Module's process
+    void p_COUNTERS();
+
     SC_HAS_PROCESS(XIN_none_VC);
     // Constructor
     /*!
@@ -493,7 +555,9 @@ inline XIN_none_VC::XIN_none_VC(sc_module_name mn,
       w_READ("XIN_wREAD"),
       w_WRITE("XIN_wWRITE"),
       w_REQUESTING("XIN_wREQUESTING"),
-      ROUTER_ID(ROUTER_ID), PORT_ID(PORT_ID)
+      ROUTER_ID(ROUTER_ID), PORT_ID(PORT_ID),
+      stallCounters(NULL),
+      activityCounters(NULL)
 {
     // Assign or instantiate sub-modules
     // Assumption: None NULL module is received here
@@ -514,6 +578,14 @@ inline XIN_none_VC::XIN_none_VC(sc_module_name mn,
     u_MEMORY->i_WRITE(w_WRITE);
     u_MEMORY->i_DATA(i_DATA);
     u_MEMORY->o_DATA(o_X_DATA);
+    if( BUFFER_OCCUPANCY && FIFO_IN_DEPTH > 0 ) {
+        u_MEMORY->bufferCounters = INSTRUMENTATION->bufferCounters(ROUTER_ID,PORT_ID,0,true,FIFO_IN_DEPTH);
+    }
+    u_MEMORY->packetTracing = PACKET_TRACER->isOpen() || LATENCY_BREAKDOWN->isEnabled();
+    if( ACTIVITY_COUNTERS ) {
+        activityCounters = INSTRUMENTATION->activityCounters(ROUTER_ID);
+        u_MEMORY->activityCounters = activityCounters;
+    }
 
     ////////////////////// IC //////////////////////
     u_IC->i_CLK(i_CLK);
@@ -550,6 +622,40 @@ inline XIN_none_VC::XIN_none_VC(sc_module_name mn,
     u_AND_READ->i_DATA[0](w_X_READ);
     u_AND_READ->i_DATA[1](w_REQUESTING);
     u_AND_READ->o_DATA(w_READ);
+
+    if( STALL_COUNTERS ) {
+        stallCounters = INSTRUMENTATION->stallCounters(ROUTER_ID,PORT_ID,0,false,STALL_INTERVAL);
+    }
+    if( STALL_COUNTERS || ACTIVITY_COUNTERS ) {
+        SC_METHOD(p_COUNTERS);
+        sensitive << i_CLK.pos();
+        dont_initialize();
+    }
+}
+
+/*!
+ * \brief XIN_none_VC::p_COUNTERS It classifies the cycle that ends on the clock
+ * edge (flit at the head of the buffer not read and why) and counts the flit
+ * read, that crosses the crossbar, and the header read, that was routed
+ */
+inline void XIN_none_VC::p_COUNTERS() {
+    if( stallCounters != NULL ) {
+        bool granted = false, idle = false;
+        for( unsigned short p = 0; p < numPorts; p++ ) {
+            if( o_X_REQUEST[p].read() ) {
+                granted = i_X_GRANT[p].read();
+                idle = i_X_IDLE[p].read();
+                break;
+            }
+        }
+        stallCounters->sample(w_READ_OK.read(),w_READ.read(),w_REQUESTING.read(),granted,idle);
+    }
+    if( activityCounters != NULL && w_READ.read() && w_READ_OK.read() ) {
+        activityCounters->crossbarTraversals++;
+        if( o_X_DATA.read().data[FLIT_WIDTH-2] == 1 ) {
+            activityCounters->routeComputations++;
+        }
+    }
 }
 
 /*!
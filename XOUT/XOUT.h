@@ -130,8 +130,13 @@ inline XOUT_Virtual::XOUT_Virtual(sc_module_name mn,
     // Assign or instantiate sub-modules
     // Assumption: None NULL module is generated here - from plugin manager
     IPriorityGenerator* pg = PLUGIN_MANAGER->priorityGeneratorInstance("PG",ROUTER_ID,PORT_ID,nPorts);
-    IArbiter* arb = new DistributedArbiter("Arbiter",nPorts,pg,ROUTER_ID,PORT_ID);
+    DistributedArbiter* arb = new DistributedArbiter("Arbiter",nPorts,pg,ROUTER_ID,PORT_ID);
     u_MEMORY = PLUGIN_MANAGER->memoryInstance("XOUT_Virtual_Memory",ROUTER_ID,PORT_ID,FIFO_OUT_DEPTH);
+    if( ACTIVITY_COUNTERS ) {
+        ActivityCounters* activity = INSTRUMENTATION->activityCounters(ROUTER_ID);
+        u_MEMORY->activityCounters = activity;
+        arb->u_PPE->activityCounters = activity;
+    }
     u_OC     = new OutputController("OC",nPorts,arb,ROUTER_ID,PORT_ID);
     u_OWS    = new OneHotMux<bool>("OWS",nPorts);
     u_ODS    = new OneHotMux<Flit>("ODS",nPorts);
@@ -239,8 +244,13 @@ public:
     // Module's process
     void p_WRITE_VC() {
         if( o_VALID.read() ) {
+            unsigned short vc = 0;
             for( unsigned int i = 0; i < widthVcSel; i++ ) {
                 o_VC_SELECTOR[i].write( w_PRIORITY[i].read() );
+                vc |= w_PRIORITY[i].read() << i;
+            }
+            if( u_OFC->linkCounters != NULL ) {
+                u_OFC->linkCounters->currentVc = vc;
             }
         }
     }
@@ -321,6 +331,9 @@ inline XOUT_N_VC::XOUT_N_VC(sc_module_name mn,
         char strXoutVc[18];
         sprintf(strXoutVc,"XOUT_u_VC(%u)",i);
         u_XOUT_VC[i] = new XOUT_Virtual(strXoutVc,nPorts,ROUTER_ID,PORT_ID);
+        if( BUFFER_OCCUPANCY && FIFO_OUT_DEPTH > 0 ) {
+            u_XOUT_VC[i]->u_MEMORY->bufferCounters = INSTRUMENTATION->bufferCounters(ROUTER_ID,PORT_ID,i,false,FIFO_OUT_DEPTH);
+        }
     }
 
 
@@ -332,6 +345,9 @@ inline XOUT_N_VC::XOUT_N_VC(sc_module_name mn,
     u_OFC->i_RETURN(i_RETURN);
     u_OFC->i_READ_OK(w_READ_OK);
     u_OFC->o_READ(w_READ);
+    if( LINK_COUNTERS ) {
+        u_OFC->linkCounters = INSTRUMENTATION->linkCounters(ROUTER_ID,PORT_ID,nVirtualChannels);
+    }
 
     // Mux read ok
     u_MUX_READ_OK->i_SEL(w_PRIORITY);
@@ -522,6 +538,12 @@ inline XOUT_none_VC::XOUT_none_VC(sc_module_name mn,
     u_MEMORY->i_WRITE(w_WRITE);
     u_MEMORY->i_DATA(w_DATA_IN);
     u_MEMORY->o_DATA(o_DATA);
+    if( BUFFER_OCCUPANCY && FIFO_OUT_DEPTH > 0 ) {
+        u_MEMORY->bufferCounters = INSTRUMENTATION->bufferCounters(ROUTER_ID,PORT_ID,0,false,FIFO_OUT_DEPTH);
+    }
+    if( ACTIVITY_COUNTERS ) {
+        u_MEMORY->activityCounters = INSTRUMENTATION->activityCounters(ROUTER_ID);
+    }
 
     /////////////////// OC ///////////////////
     u_OC->i_CLK(i_CLK);
@@ -537,6 +559,9 @@ inline XOUT_none_VC::XOUT_none_VC(sc_module_name mn,
     u_OFC->i_RETURN(i_RETURN);
     u_OFC->i_READ_OK(w_READ_OK2);
     u_OFC->o_READ(w_READ);
+    if( LINK_COUNTERS ) {
+        u_OFC->linkCounters = INSTRUMENTATION->linkCounters(ROUTER_ID,PORT_ID,1);
+    }
 
     /////////////////// OWS ///////////////////
     u_OWS->i_SEL(o_X_GRANT);
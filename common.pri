@@ -34,3 +34,9 @@ OBJECTS_DIR = ../objs
 CONFIG -= debug_and_release
 
 DEFINES -= QT_QML_DEBUG
+
+# Waveform compressed with zlib (snocs_wave.vcd.gz) where zlib is available, plain VCD
+# (snocs_wave.vcd) otherwise - used by Parameters.pro and socindefines.pri
+# (qmake CONFIG+=waveform_zlib forces it, CONFIG+=no_waveform_zlib disables it)
+unix|packagesExist(zlib): CONFIG += waveform_zlib
+no_waveform_zlib: CONFIG -= waveform_zlib
@@ -2,6 +2,10 @@
 LIBS += -L$$PWD/plugins/ -lparameters
 INCLUDEPATH += $$PWD/Parameters
 DEPENDPATH += $$PWD/Parameters
+# Waveform compressed (the same switch of Parameters.pro - set in common.pri)
+waveform_zlib {
+    DEFINES += WAVEFORM_ZLIB
+}
 
 greaterThan(QT_VERSION, 5.7) {
     unix {
@@ -0,0 +1,7 @@
+TARGET = tst_flowcontrol
+
+include(../app.pri)
+include(../socindefines.pri)
+
+SOURCES += \
+    tst_flowcontrol.cpp
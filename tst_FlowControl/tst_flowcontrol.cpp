@@ -0,0 +1,83 @@
+#include "../FlowControl/FlowControl.h"
+
+#include <dlfcn.h>
+#include <ctime>
+
+/*!
+ * \brief sc_main
+ * \param argc
+ * \param argv [0] Executable folder; [1] Plug-in file; [2] Number of cycles (optional); [3] Buffers depth (optional)
+ * \return 0 if the link reports no stall; -1 otherwise
+ */
+int sc_main(int argc, char *argv[]) {
+
+    for(int i = 0; i < argc; i++) {
+        std::cout << "Argv[" << i << "]: " << argv[i] << std::endl;
+    }
+    if( argc < 2 ) {
+        std::cerr << "Please specific the FC plugin filename"
+                     "\nFormat: ./tst_flowcontrol </dir/of/fc_plugin> [CYCLES] [DEPTH]" << std::endl;
+        return -1;
+    }
+
+    // Get plugin filename
+    char* pluginFilename = argv[1];
+    std::cout << "Plugin Filename: " << pluginFilename << std::endl;
+    ///// Loading library of FC plugin
+    void* lib_handle;
+    lib_handle = dlopen(pluginFilename,RTLD_NOW);
+    if( !lib_handle ) {
+        std::cerr << "Error to open plugin " << pluginFilename <<": " << dlerror() << std::endl;
+        return -1;
+    }
+
+    create_OutputFlowControl* new_OFC_t = (create_OutputFlowControl*) dlsym(lib_handle,"new_OFC");
+    const char* dlsym_error = dlerror();
+    if( dlsym_error ) {
+        std::cerr << "Error on load symbol of factory creator function - OFC: " << pluginFilename << std::endl;
+        return -1;
+    }
+
+    destroy_OutputFlowControl* delete_OFC_t = (destroy_OutputFlowControl*) dlsym(lib_handle,"delete_OFC");
+    dlsym_error = dlerror();
+    if( dlsym_error ) {
+        std::cerr << "Error on load symbol of factory destroy function - OFC: " << pluginFilename << std::endl;
+        return -1;
+    }
+
+    create_InputFlowControl* new_IFC_t = (create_InputFlowControl*) dlsym(lib_handle,"new_IFC");
+    dlsym_error = dlerror();
+    if( dlsym_error ) {
+        std::cerr << "Error on load symbol of factory creator function - IFC: " << pluginFilename << std::endl;
+        return -1;
+    }
+
+    destroy_InputFlowControl* delete_IFC_t = (destroy_InputFlowControl*) dlsym(lib_handle,"delete_IFC");
+    dlsym_error = dlerror();
+    if( dlsym_error ) {
+        std::cerr << "Error on load symbol of factory destroy function - IFC: " << pluginFilename << std::endl;
+        return -1;
+    }
+
+    unsigned int nCycles = argc > 2 ? atoi(argv[2]) : 100;
+    unsigned short bufferDepth = argc > 3 ? atoi(argv[3]) : 4;
+
+    // System Clock - 10ns
+    sc_clock w_CLK("CLK",10,SC_NS);
+
+    tst_FlowControl* tst = new tst_FlowControl("FC_Testbench",nCycles,bufferDepth,
+                                               new_OFC_t,delete_OFC_t,new_IFC_t,delete_IFC_t);
+    tst->i_CLK(w_CLK);
+
+    clock_t t = clock();
+    // Start simulation
+    sc_start();
+    t = clock() - t;
+    printf("\n\nSimulated in %ld ms(%f secs)\n",t,((float)t)/CLOCKS_PER_SEC);
+
+    bool passed = tst->passed;
+    delete tst;
+    dlclose(lib_handle);
+
+    return passed ? 0 : -1;
+}